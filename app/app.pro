@@ -11,22 +11,30 @@ INCLUDEPATH += \
     src/youtube
 
 HEADERS += \
+    src/base/accountstore.h \
     src/base/categorymodel.h \
     src/base/categorynamemodel.h \
     src/base/clipboard.h \
     src/base/comment.h \
     src/base/concurrenttransfersmodel.h \
     src/base/json.h \
+    src/base/library.h \
+    src/base/librarymodel.h \
     src/base/localemodel.h \
     src/base/logger.h \
     src/base/loggerverbositymodel.h \
     src/base/networkproxytypemodel.h \
+    src/base/objectregistry.h \
+    src/base/pageprefetcher.h \
     src/base/playlist.h \
     src/base/resources.h \
+    src/base/responsecache.h \
     src/base/searchhistorymodel.h \
     src/base/selectionmodel.h \
     src/base/servicemodel.h \
+    src/base/subscriptionindex.h \
     src/base/transfers.h \
+    src/base/urlrouter.h \
     src/base/user.h \
     src/base/utils.h \
     src/base/video.h \
@@ -41,14 +49,18 @@ HEADERS += \
     src/dailymotion/dailymotionplaylistmodel.h \
     src/dailymotion/dailymotionsearchtypemodel.h \
     src/dailymotion/dailymotionstreammodel.h \
+    src/dailymotion/dailymotionsubscriptionindex.h \
     src/dailymotion/dailymotionsubtitlemodel.h \
     src/dailymotion/dailymotiontransfer.h \
     src/dailymotion/dailymotionuser.h \
     src/dailymotion/dailymotionusermodel.h \
     src/dailymotion/dailymotionvideo.h \
     src/dailymotion/dailymotionvideomodel.h \
+    src/plugins/externalpluginworker.h \
     src/plugins/externalresourcesrequest.h \
     src/plugins/externalserviceplugin.h \
+    src/plugins/htmlextractor.h \
+    src/plugins/javascriptenginepool.h \
     src/plugins/javascriptresourcesrequest.h \
     src/plugins/javascriptresourcesrequestglobalobject.h \
     src/plugins/javascriptserviceplugin.h \
@@ -57,7 +69,10 @@ HEADERS += \
     src/plugins/plugincommentmodel.h \
     src/plugins/pluginconfigmodel.h \
     src/plugins/pluginmanager.h \
+    src/plugins/pluginmanifestindex.h \
     src/plugins/pluginnavmodel.h \
+    src/plugins/pluginnetworkaccessmanager.h \
+    src/plugins/pluginnetworkcache.h \
     src/plugins/pluginplaylist.h \
     src/plugins/pluginplaylistmodel.h \
     src/plugins/pluginsearchtypemodel.h \
@@ -69,7 +84,11 @@ HEADERS += \
     src/plugins/pluginusermodel.h \
     src/plugins/pluginvideo.h \
     src/plugins/pluginvideomodel.h \
+    src/plugins/resourcesreply.h \
     src/plugins/resourcesrequest.h \
+    src/plugins/scraperplan.h \
+    src/plugins/scraperresourcesrequest.h \
+    src/plugins/scraperserviceplugin.h \
     src/plugins/serviceplugin.h \
     src/plugins/servicepluginconfig.h \
     src/plugins/xmlhttprequest.h \
@@ -83,6 +102,7 @@ HEADERS += \
     src/vimeo/vimeoplaylistmodel.h \
     src/vimeo/vimeosearchtypemodel.h \
     src/vimeo/vimeostreammodel.h \
+    src/vimeo/vimeosubscriptionindex.h \
     src/vimeo/vimeosubtitlemodel.h \
     src/vimeo/vimeotransfer.h \
     src/vimeo/vimeouser.h \
@@ -94,11 +114,16 @@ HEADERS += \
     src/youtube/youtubecategorymodel.h \
     src/youtube/youtubecomment.h \
     src/youtube/youtubecommentmodel.h \
+    src/youtube/youtubeenrichment.h \
+    src/youtube/youtubefeedmodel.h \
     src/youtube/youtubenavmodel.h \
     src/youtube/youtubeplaylist.h \
     src/youtube/youtubeplaylistmodel.h \
+    src/youtube/youtuberequestbroker.h \
     src/youtube/youtubesearchtypemodel.h \
     src/youtube/youtubestreammodel.h \
+    src/youtube/youtubesubscriptionfeed.h \
+    src/youtube/youtubesubscriptionindex.h \
     src/youtube/youtubesubtitlemodel.h \
     src/youtube/youtubetransfer.h \
     src/youtube/youtubeuser.h \
@@ -107,16 +132,23 @@ HEADERS += \
     src/youtube/youtubevideomodel.h
     
 SOURCES += \
+    src/base/accountstore.cpp \
     src/base/categorymodel.cpp \
     src/base/clipboard.cpp \
     src/base/comment.cpp \
     src/base/json.cpp \
+    src/base/library.cpp \
+    src/base/librarymodel.cpp \
     src/base/logger.cpp \
+    src/base/pageprefetcher.cpp \
     src/base/playlist.cpp \
     src/base/resources.cpp \
+    src/base/responsecache.cpp \
     src/base/searchhistorymodel.cpp \
     src/base/selectionmodel.cpp \
+    src/base/subscriptionindex.cpp \
     src/base/transfers.cpp \
+    src/base/urlrouter.cpp \
     src/base/user.cpp \
     src/base/utils.cpp \
     src/base/video.cpp \
@@ -130,14 +162,17 @@ SOURCES += \
     src/dailymotion/dailymotionplaylist.cpp \
     src/dailymotion/dailymotionplaylistmodel.cpp \
     src/dailymotion/dailymotionstreammodel.cpp \
+    src/dailymotion/dailymotionsubscriptionindex.cpp \
     src/dailymotion/dailymotionsubtitlemodel.cpp \
     src/dailymotion/dailymotionuser.cpp \
     src/dailymotion/dailymotionusermodel.cpp \
     src/dailymotion/dailymotiontransfer.cpp \
     src/dailymotion/dailymotionvideo.cpp \
     src/dailymotion/dailymotionvideomodel.cpp \
+    src/plugins/externalpluginworker.cpp \
     src/plugins/externalresourcesrequest.cpp \
     src/plugins/externalserviceplugin.cpp \
+    src/plugins/javascriptenginepool.cpp \
     src/plugins/javascriptresourcesrequest.cpp \
     src/plugins/javascriptresourcesrequestglobalobject.cpp \
     src/plugins/javascriptserviceplugin.cpp \
@@ -146,6 +181,9 @@ SOURCES += \
     src/plugins/plugincommentmodel.cpp \
     src/plugins/pluginconfigmodel.cpp \
     src/plugins/pluginmanager.cpp \
+    src/plugins/pluginmanifestindex.cpp \
+    src/plugins/pluginnetworkaccessmanager.cpp \
+    src/plugins/pluginnetworkcache.cpp \
     src/plugins/pluginplaylist.cpp \
     src/plugins/pluginplaylistmodel.cpp \
     src/plugins/pluginsettings.cpp \
@@ -156,6 +194,10 @@ SOURCES += \
     src/plugins/pluginuser.cpp \
     src/plugins/pluginvideomodel.cpp \
     src/plugins/pluginvideo.cpp \
+    src/plugins/resourcesreply.cpp \
+    src/plugins/scraperplan.cpp \
+    src/plugins/scraperresourcesrequest.cpp \
+    src/plugins/scraperserviceplugin.cpp \
     src/plugins/servicepluginconfig.cpp \
     src/plugins/xmlhttprequest.cpp \
     src/vimeo/vimeo.cpp \
@@ -167,6 +209,7 @@ SOURCES += \
     src/vimeo/vimeoplaylist.cpp \
     src/vimeo/vimeoplaylistmodel.cpp \
     src/vimeo/vimeostreammodel.cpp \
+    src/vimeo/vimeosubscriptionindex.cpp \
     src/vimeo/vimeosubtitlemodel.cpp \
     src/vimeo/vimeotransfer.cpp \
     src/vimeo/vimeouser.cpp \
@@ -178,10 +221,15 @@ SOURCES += \
     src/youtube/youtubecategorymodel.cpp \
     src/youtube/youtubecomment.cpp \
     src/youtube/youtubecommentmodel.cpp \
+    src/youtube/youtubeenrichment.cpp \
+    src/youtube/youtubefeedmodel.cpp \
     src/youtube/youtubenavmodel.cpp \
     src/youtube/youtubeplaylist.cpp \
     src/youtube/youtubeplaylistmodel.cpp \
+    src/youtube/youtuberequestbroker.cpp \
     src/youtube/youtubestreammodel.cpp \
+    src/youtube/youtubesubscriptionfeed.cpp \
+    src/youtube/youtubesubscriptionindex.cpp \
     src/youtube/youtubesubtitlemodel.cpp \
     src/youtube/youtubetransfer.cpp \
     src/youtube/youtubeuser.cpp \
@@ -222,6 +270,7 @@ maemo5 {
         src/maemo5/image.h \
         src/maemo5/imagecache.h \
         src/maemo5/listview.h \
+        src/maemo5/librarywindow.h \
         src/maemo5/mainwindow.h \
         src/maemo5/navdelegate.h \
         src/maemo5/networkproxydialog.h \
@@ -321,6 +370,7 @@ maemo5 {
         src/maemo5/image.cpp \
         src/maemo5/imagecache.cpp \
         src/maemo5/listview.cpp \
+        src/maemo5/librarywindow.cpp \
         src/maemo5/main.cpp \
         src/maemo5/mainwindow.cpp \
         src/maemo5/navdelegate.cpp \
@@ -601,7 +651,7 @@ maemo5 {
         splash
 
 } else:unix {
-    QT += widgets
+    QT += concurrent widgets
     
     LIBS += -L/usr/lib -lqdailymotion -lqvimeo -lqyoutube
     CONFIG += link_prl
@@ -627,6 +677,7 @@ maemo5 {
         src/desktop/generalsettingstab.h \
         src/desktop/image.h \
         src/desktop/imagecache.h \
+        src/desktop/librarywindow.h \
         src/desktop/mainwindow.h \
         src/desktop/networksettingstab.h \
         src/desktop/page.h \
@@ -689,6 +740,7 @@ maemo5 {
         src/desktop/generalsettingstab.cpp \
         src/desktop/image.cpp \
         src/desktop/imagecache.cpp \
+        src/desktop/librarywindow.cpp \
         src/desktop/main.cpp \
         src/desktop/mainwindow.cpp \
         src/desktop/networksettingstab.cpp \
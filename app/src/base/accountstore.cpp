@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "accountstore.h"
+#include "database.h"
+#include "json.h"
+#include "logger.h"
+#include <QSqlRecord>
+
+QHash<QString, AccountStore::Table> AccountStore::tables;
+QHash<QString, QVariant> AccountStore::json;
+QHash<QString, QSqlQuery> AccountStore::statements;
+
+QVariant AccountStore::value(const QString &table, const QString &userId, const QString &column) {
+    if (userId.isEmpty()) {
+        return QVariant();
+    }
+    
+    return load(table).value(userId).value(column);
+}
+
+QVariant AccountStore::jsonValue(const QString &table, const QString &userId, const QString &column) {
+    if (userId.isEmpty()) {
+        return QVariant();
+    }
+    
+    // Stored JSON is parsed once, and again only when the value is changed
+    const QString key = QString("%1 %2 %3").arg(table).arg(userId).arg(column);
+    QHash<QString, QVariant>::const_iterator iterator = json.constFind(key);
+    
+    if (iterator == json.constEnd()) {
+        iterator = json.insert(key, QtJson::Json::parse(value(table, userId, column).toString()));
+    }
+    
+    return iterator.value();
+}
+
+bool AccountStore::setValue(const QString &table, const QString &userId, const QString &column,
+                            const QVariant &value) {
+    QSqlQuery &query = statement(QString("UPDATE %1 SET %2 = ? WHERE userId = ?").arg(table).arg(column));
+    query.addBindValue(value);
+    query.addBindValue(userId);
+    
+    if (!query.exec()) {
+        Logger::log("AccountStore::setValue(): database error: " + query.lastError().text());
+        return false;
+    }
+    
+    // Only rows that exist in the database are cached, as the update does not insert new rows
+    if (tables.contains(table)) {
+        Table::iterator iterator = tables[table].find(userId);
+        
+        if (iterator != tables[table].end()) {
+            iterator.value()[column] = value;
+        }
+    }
+    
+    json.remove(QString("%1 %2 %3").arg(table).arg(userId).arg(column));
+    return true;
+}
+
+void AccountStore::invalidate(const QString &table) {
+    Logger::log("AccountStore::invalidate(). Table: " + table, Logger::HighVerbosity);
+    tables.remove(table);
+    
+    QMutableHashIterator<QString, QVariant> iterator(json);
+    
+    while (iterator.hasNext()) {
+        if (iterator.next().key().section(' ', 0, 0) == table) {
+            iterator.remove();
+        }
+    }
+}
+
+void AccountStore::clear() {
+    tables.clear();
+    json.clear();
+}
+
+const AccountStore::Table& AccountStore::load(const QString &table) {
+    QHash<QString, Table>::const_iterator iterator = tables.constFind(table);
+    
+    if (iterator != tables.constEnd()) {
+        return iterator.value();
+    }
+    
+    Logger::log("AccountStore::load(). Table: " + table, Logger::HighVerbosity);
+    Table rows;
+    QSqlQuery &query = statement(QString("SELECT * FROM %1").arg(table));
+    
+    if (query.exec()) {
+        const QSqlRecord record = query.record();
+        
+        while (query.next()) {
+            QVariantMap row;
+            
+            for (int i = 0; i < record.count(); i++) {
+                row[record.fieldName(i)] = query.value(i);
+            }
+            
+            rows.insert(row.value("userId").toString(), row);
+        }
+        
+        query.finish();
+    }
+    else {
+        // The table is not cached, so that the read is retried next time
+        Logger::log("AccountStore::load(): database error: " + query.lastError().text());
+        static const Table empty;
+        return empty;
+    }
+    
+    return *tables.insert(table, rows);
+}
+
+QSqlQuery& AccountStore::statement(const QString &sql) {
+    QHash<QString, QSqlQuery>::iterator iterator = statements.find(sql);
+    
+    if (iterator == statements.end()) {
+        iterator = statements.insert(sql, QSqlQuery(getDatabase()));
+        
+        if (!iterator.value().prepare(sql)) {
+            Logger::log("AccountStore::statement(): database error: " + iterator.value().lastError().text());
+        }
+    }
+    
+    return iterator.value();
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ACCOUNTSTORE_H
+#define ACCOUNTSTORE_H
+
+#include <QHash>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariantMap>
+
+/*
+ * Serves reads of the account tables (e.g. youtubeAccounts) from memory.
+ *
+ * Each table is read once, on first use. Writes go through to the database using prepared statements.
+ * Code that modifies a table by other means (e.g. the account models) must call invalidate() afterwards.
+ */
+class AccountStore
+{
+
+public:
+    static QVariant value(const QString &table, const QString &userId, const QString &column);
+    static QVariant jsonValue(const QString &table, const QString &userId, const QString &column);
+    static bool setValue(const QString &table, const QString &userId, const QString &column, const QVariant &value);
+    
+    static void invalidate(const QString &table);
+    static void clear();
+
+private:
+    typedef QHash<QString, QVariantMap> Table;
+    
+    static const Table& load(const QString &table);
+    static QSqlQuery& statement(const QString &sql);
+    
+    static QHash<QString, Table> tables;
+    static QHash<QString, QVariant> json;
+    static QHash<QString, QSqlQuery> statements;
+};
+
+#endif // ACCOUNTSTORE_H
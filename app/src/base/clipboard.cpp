@@ -17,6 +17,7 @@
 
 #include "clipboard.h"
 #include "logger.h"
+#include "utils.h"
 #include <QApplication>
 #include <QClipboard>
 
@@ -74,7 +75,17 @@ void Clipboard::onTextChanged() {
     const QString text = QApplication::clipboard()->text();
     Logger::log("Clipboard::onTextChanged(). Text: " + text, Logger::HighVerbosity);
 
-    if (!text.isEmpty()) {
+    if (text.isEmpty()) {
+        return;
+    }
+    
+    // Text containing several URLs is handled as one batch
+    const QStringList urls = Utils::extractUrls(text);
+    
+    if (urls.size() > 1) {
+        emit urlsChanged(urls);
+    }
+    else {
         emit textChanged(text);
     }
 }
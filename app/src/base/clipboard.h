@@ -19,6 +19,7 @@
 #define CLIPBOARD_H
 
 #include <QObject>
+#include <QStringList>
 
 class Clipboard : public QObject
 {
@@ -47,6 +48,7 @@ private Q_SLOTS:
 Q_SIGNALS:
     void enabledChanged(bool enabled);
     void textChanged(const QString &text);
+    void urlsChanged(const QStringList &urls);
 
 private:
     Clipboard();
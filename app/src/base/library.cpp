@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "library.h"
+#include "database.h"
+#include "logger.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QSqlRecord>
+#include <QStringList>
+#include <QUrl>
+
+Library* Library::self = 0;
+
+Library::Library() :
+    QObject(),
+    m_fullText(-1)
+{
+}
+
+Library::~Library() {
+    self = 0;
+}
+
+Library* Library::instance() {
+    return self ? self : self = new Library;
+}
+
+bool Library::add(const QString &service, const QString &videoId, const QString &title, const QString &category,
+                  const QString &filePath, qint64 size) {
+    Logger::log("Library::add(). File path: " + filePath, Logger::MediumVerbosity);
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+    QSqlQuery query(db);
+    // A file that replaces an existing item (e.g. the item was deleted and downloaded again) is re-indexed
+    query.prepare("SELECT id FROM library WHERE filePath = ?");
+    query.addBindValue(filePath);
+    query.exec();
+    
+    if (query.next()) {
+        const int id = query.value(0).toInt();
+        query.prepare("DELETE FROM libraryText WHERE docid = ?");
+        query.addBindValue(id);
+        query.exec();
+        query.prepare("DELETE FROM library WHERE id = ?");
+        query.addBindValue(id);
+        query.exec();
+    }
+    
+    query.prepare("INSERT INTO library (service, videoId, title, category, filePath, size, date) \
+    VALUES (?, ?, ?, ?, ?, ?, ?)");
+    query.addBindValue(service);
+    query.addBindValue(videoId);
+    query.addBindValue(title);
+    query.addBindValue(category);
+    query.addBindValue(filePath);
+    query.addBindValue(size);
+    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    
+    if (!query.exec()) {
+        Logger::log("Library::add(): database error: " + query.lastError().text());
+        db.rollback();
+        return false;
+    }
+    
+    if (isFullTextEnabled()) {
+        const QVariant id = query.lastInsertId();
+        query.prepare("INSERT INTO libraryText (docid, title, fileName, category) VALUES (?, ?, ?, ?)");
+        query.addBindValue(id);
+        query.addBindValue(title);
+        query.addBindValue(QFileInfo(filePath).fileName());
+        query.addBindValue(category);
+        
+        if (!query.exec()) {
+            Logger::log("Library::add(): database error: " + query.lastError().text());
+            db.rollback();
+            return false;
+        }
+    }
+    
+    db.commit();
+    emit changed();
+    return true;
+}
+
+bool Library::remove(int id) {
+    Logger::log("Library::remove(). ID: " + QString::number(id), Logger::MediumVerbosity);
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+    QSqlQuery query(db);
+    
+    if (isFullTextEnabled()) {
+        query.prepare("DELETE FROM libraryText WHERE docid = ?");
+        query.addBindValue(id);
+        query.exec();
+    }
+    
+    query.prepare("DELETE FROM library WHERE id = ?");
+    query.addBindValue(id);
+    
+    if (!query.exec()) {
+        Logger::log("Library::remove(): database error: " + query.lastError().text());
+        db.rollback();
+        return false;
+    }
+    
+    db.commit();
+    emit changed();
+    return true;
+}
+
+int Library::count(const QString &query) const {
+    QSqlQuery q(getDatabase());
+    const QString match = matchExpression(query);
+    
+    if (match.isEmpty()) {
+        q.exec("SELECT COUNT(*) FROM library");
+    }
+    else if (isFullTextEnabled()) {
+        q.prepare("SELECT COUNT(*) FROM libraryText WHERE libraryText MATCH ?");
+        q.addBindValue(match);
+        q.exec();
+    }
+    else {
+        q.prepare("SELECT COUNT(*) FROM library WHERE title LIKE ?");
+        q.addBindValue("%" + query.trimmed() + "%");
+        q.exec();
+    }
+    
+    if (q.lastError().isValid()) {
+        Logger::log("Library::count(): database error: " + q.lastError().text());
+        return 0;
+    }
+    
+    return q.next() ? q.value(0).toInt() : 0;
+}
+
+QList<QVariantMap> Library::search(const QString &query, int limit, int offset) const {
+    QList<QVariantMap> items;
+    QSqlQuery q(getDatabase());
+    const QString match = matchExpression(query);
+    
+    if (match.isEmpty()) {
+        q.prepare("SELECT * FROM library ORDER BY date DESC LIMIT ? OFFSET ?");
+    }
+    else if (isFullTextEnabled()) {
+        q.prepare("SELECT library.* FROM library JOIN libraryText ON libraryText.docid = library.id \
+        WHERE libraryText MATCH ? ORDER BY library.date DESC LIMIT ? OFFSET ?");
+        q.addBindValue(match);
+    }
+    else {
+        // Without the full-text index, only the title is searched
+        q.prepare("SELECT * FROM library WHERE title LIKE ? ORDER BY date DESC LIMIT ? OFFSET ?");
+        q.addBindValue("%" + query.trimmed() + "%");
+    }
+    
+    q.addBindValue(limit);
+    q.addBindValue(offset);
+    
+    if (!q.exec()) {
+        Logger::log("Library::search(): database error: " + q.lastError().text());
+        return items;
+    }
+    
+    const QSqlRecord record = q.record();
+    
+    while (q.next()) {
+        QVariantMap item;
+        
+        for (int i = 0; i < record.count(); i++) {
+            item[record.fieldName(i)] = q.value(i);
+        }
+        
+        item["fileName"] = QFileInfo(item.value("filePath").toString()).fileName();
+        item["url"] = QUrl::fromLocalFile(item.value("filePath").toString());
+        items << item;
+    }
+    
+    return items;
+}
+
+QString Library::matchExpression(const QString &query) {
+    // Each word is matched as a prefix, e.g. "cat vid" matches "Cats and videos"
+    QStringList terms = query.split(QRegExp("\\W+"), QString::SkipEmptyParts);
+    
+    for (int i = 0; i < terms.size(); i++) {
+        terms[i].append("*");
+    }
+    
+    return terms.join(" ");
+}
+
+void Library::prune() {
+    Logger::log("Library::prune()", Logger::MediumVerbosity);
+    QSqlQuery query(getDatabase());
+    
+    if (!query.exec("SELECT id, filePath FROM library")) {
+        Logger::log("Library::prune(): database error: " + query.lastError().text());
+        return;
+    }
+    
+    QList<int> ids;
+    
+    while (query.next()) {
+        if (!QFileInfo(query.value(1).toString()).exists()) {
+            ids << query.value(0).toInt();
+        }
+    }
+    
+    query.finish();
+    
+    if (ids.isEmpty()) {
+        return;
+    }
+    
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+    
+    foreach (int id, ids) {
+        if (isFullTextEnabled()) {
+            query.prepare("DELETE FROM libraryText WHERE docid = ?");
+            query.addBindValue(id);
+            query.exec();
+        }
+        
+        query.prepare("DELETE FROM library WHERE id = ?");
+        query.addBindValue(id);
+        query.exec();
+    }
+    
+    db.commit();
+    emit changed();
+}
+
+bool Library::isFullTextEnabled() const {
+    // The libraryText table is not created if SQLite is built without FTS3
+    if (m_fullText == -1) {
+        m_fullText = getDatabase().tables().contains("libraryText") ? 1 : 0;
+        
+        if (!m_fullText) {
+            Logger::log("Library::isFullTextEnabled(). Full-text search is not available", Logger::LowVerbosity);
+        }
+    }
+    
+    return m_fullText == 1;
+}
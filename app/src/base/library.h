@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <QObject>
+#include <QVariantMap>
+
+/*
+ * Indexes completed downloads, so that they can be listed and searched without network access.
+ *
+ * Items are stored in the library table, with their title, file name and category also indexed in the
+ * libraryText full-text table. Searches match each word of the query as a prefix.
+ */
+class Library : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~Library();
+    
+    static Library* instance();
+    
+    bool add(const QString &service, const QString &videoId, const QString &title, const QString &category,
+             const QString &filePath, qint64 size);
+    bool remove(int id);
+    
+    int count(const QString &query = QString()) const;
+    QList<QVariantMap> search(const QString &query = QString(), int limit = -1, int offset = 0) const;
+    
+    static QString matchExpression(const QString &query);
+
+public Q_SLOTS:
+    void prune();
+
+Q_SIGNALS:
+    void changed();
+
+private:
+    Library();
+    
+    bool isFullTextEnabled() const;
+    
+    static Library *self;
+    
+    mutable int m_fullText;
+};
+
+#endif // LIBRARY_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "librarymodel.h"
+#include "library.h"
+#include "logger.h"
+
+static const int PAGE_SIZE = 50;
+
+LibraryModel::LibraryModel(QObject *parent) :
+    QAbstractListModel(parent),
+    m_total(0)
+{
+    m_roles[CategoryRole] = "category";
+    m_roles[DateRole] = "date";
+    m_roles[FileNameRole] = "fileName";
+    m_roles[FilePathRole] = "filePath";
+    m_roles[IdRole] = "id";
+    m_roles[ServiceRole] = "service";
+    m_roles[SizeRole] = "size";
+    m_roles[TitleRole] = "title";
+    m_roles[UrlRole] = "url";
+    m_roles[VideoIdRole] = "videoId";
+#if QT_VERSION < 0x050000
+    setRoleNames(m_roles);
+#endif
+    connect(Library::instance(), SIGNAL(changed()), this, SLOT(reload()));
+    reload();
+}
+
+QString LibraryModel::query() const {
+    return m_query;
+}
+
+int LibraryModel::total() const {
+    return m_total;
+}
+
+#if QT_VERSION >= 0x050000
+QHash<int, QByteArray> LibraryModel::roleNames() const {
+    return m_roles;
+}
+#endif
+
+int LibraryModel::rowCount(const QModelIndex &) const {
+    return m_items.size();
+}
+
+bool LibraryModel::canFetchMore(const QModelIndex &) const {
+    return m_items.size() < m_total;
+}
+
+void LibraryModel::fetchMore(const QModelIndex &) {
+    if (!canFetchMore()) {
+        return;
+    }
+    
+    const QList<QVariantMap> items = Library::instance()->search(m_query, PAGE_SIZE, m_items.size());
+    
+    if (items.isEmpty()) {
+        m_total = m_items.size();
+        emit countChanged(rowCount());
+        return;
+    }
+    
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + items.size() - 1);
+    m_items << items;
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
+QVariant LibraryModel::data(const QModelIndex &index, int role) const {
+    if ((index.row() < 0) || (index.row() >= m_items.size())) {
+        return QVariant();
+    }
+    
+    // The widget views show the title and the file path
+    switch (role) {
+    case Qt::DisplayRole:
+        return m_items.at(index.row()).value("title");
+    case Qt::ToolTipRole:
+        return m_items.at(index.row()).value("filePath");
+    default:
+        return m_items.at(index.row()).value(m_roles.value(role));
+    }
+}
+
+QMap<int, QVariant> LibraryModel::itemData(const QModelIndex &index) const {
+    QMap<int, QVariant> map;
+    
+    if ((index.row() >= 0) && (index.row() < m_items.size())) {
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.key()] = m_items.at(index.row()).value(iterator.value());
+        }
+    }
+    
+    return map;
+}
+
+QVariant LibraryModel::data(int row, const QByteArray &role) const {
+    return data(index(row), m_roles.key(role));
+}
+
+QVariantMap LibraryModel::itemData(int row) const {
+    if ((row < 0) || (row >= m_items.size())) {
+        return QVariantMap();
+    }
+    
+    return m_items.at(row);
+}
+
+void LibraryModel::remove(int row) {
+    // The library emits changed(), which reloads the model
+    if ((row >= 0) && (row < m_items.size())) {
+        Library::instance()->remove(m_items.at(row).value("id").toInt());
+    }
+}
+
+void LibraryModel::search(const QString &query) {
+    if (query != m_query) {
+        m_query = query;
+        emit queryChanged();
+        reload();
+    }
+}
+
+void LibraryModel::clear() {
+    if (!m_items.isEmpty()) {
+        beginResetModel();
+        m_items.clear();
+        m_total = 0;
+        endResetModel();
+        emit countChanged(0);
+    }
+}
+
+void LibraryModel::reload() {
+    Logger::log("LibraryModel::reload(). Query: " + m_query, Logger::MediumVerbosity);
+    // Rows that were already fetched are kept in view
+    const int limit = qMax(PAGE_SIZE, m_items.size());
+    beginResetModel();
+    m_total = Library::instance()->count(m_query);
+    m_items = Library::instance()->search(m_query, limit);
+    endResetModel();
+    emit countChanged(rowCount());
+}
+
+void LibraryModel::prune() {
+    Library::instance()->prune();
+}
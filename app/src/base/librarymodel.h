@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBRARYMODEL_H
+#define LIBRARYMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+/*
+ * Lists the items of the Library, optionally filtered by a search query.
+ *
+ * Items are read from the database a page at a time, using canFetchMore()/fetchMore().
+ */
+class LibraryModel : public QAbstractListModel
+{
+    Q_OBJECT
+    
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(int total READ total NOTIFY countChanged)
+    Q_PROPERTY(QString query READ query WRITE search NOTIFY queryChanged)
+    
+public:
+    enum Roles {
+        CategoryRole = Qt::UserRole + 1,
+        DateRole,
+        FileNameRole,
+        FilePathRole,
+        IdRole,
+        ServiceRole,
+        SizeRole,
+        TitleRole,
+        UrlRole,
+        VideoIdRole
+    };
+    
+    explicit LibraryModel(QObject *parent = 0);
+    
+    QString query() const;
+    
+    int total() const;
+    
+#if QT_VERSION >= 0x050000
+    QHash<int, QByteArray> roleNames() const;
+#endif
+    
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    
+    bool canFetchMore(const QModelIndex &parent = QModelIndex()) const;
+    Q_INVOKABLE void fetchMore(const QModelIndex &parent = QModelIndex());
+    
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    QMap<int, QVariant> itemData(const QModelIndex &index) const;
+    
+    Q_INVOKABLE QVariant data(int row, const QByteArray &role) const;
+    Q_INVOKABLE QVariantMap itemData(int row) const;
+    
+    Q_INVOKABLE void remove(int row);
+
+public Q_SLOTS:
+    void search(const QString &query);
+    void clear();
+    void reload();
+    void prune();
+
+Q_SIGNALS:
+    void countChanged(int count);
+    void queryChanged();
+
+private:
+    QList<QVariantMap> m_items;
+    
+    QHash<int, QByteArray> m_roles;
+    
+    QString m_query;
+    
+    int m_total;
+};
+
+#endif // LIBRARYMODEL_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OBJECTREGISTRY_H
+#define OBJECTREGISTRY_H
+
+#include <QMultiHash>
+#include <QStringList>
+
+/*
+ * Indexes live objects by service and id, so that a change to a resource can be delivered
+ * to only the objects that represent it.
+ */
+template <class T>
+class ObjectRegistry
+{
+public:
+    void insert(const QString &service, const QString &id, T *object) {
+        if (!id.isEmpty()) {
+            m_objects.insert(key(service, id), object);
+        }
+    }
+    
+    void remove(const QString &service, const QString &id, T *object) {
+        if (!id.isEmpty()) {
+            m_objects.remove(key(service, id), object);
+        }
+    }
+    
+    QList<T*> objects(const QString &service, const QString &id) const {
+        return m_objects.values(key(service, id));
+    }
+
+private:
+    static QString key(const QString &service, const QString &id) {
+        return service + "/" + id;
+    }
+    
+    QMultiHash<QString, T*> m_objects;
+};
+
+#endif // OBJECTREGISTRY_H
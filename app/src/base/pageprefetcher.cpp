@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pageprefetcher.h"
+
+PagePrefetcher::PagePrefetcher() :
+    m_threshold(10),
+    m_wanted(false)
+{
+}
+
+int PagePrefetcher::threshold() const {
+    return m_threshold;
+}
+
+bool PagePrefetcher::setThreshold(int threshold) {
+    if (threshold != m_threshold) {
+        m_threshold = threshold;
+        return true;
+    }
+    
+    return false;
+}
+
+QVariant PagePrefetcher::page() const {
+    return m_page;
+}
+
+bool PagePrefetcher::isWanted() const {
+    return m_wanted;
+}
+
+void PagePrefetcher::setWanted(bool wanted) {
+    m_wanted = wanted;
+}
+
+bool PagePrefetcher::hasResult() const {
+    return !m_result.isEmpty();
+}
+
+bool PagePrefetcher::start(int lastVisibleRow, int rowCount, const QVariant &page) {
+    // A threshold of zero or less disables prefetching
+    if ((m_threshold <= 0) || (lastVisibleRow < rowCount - m_threshold) || (page == m_page)) {
+        return false;
+    }
+    
+    m_page = page;
+    m_result.clear();
+    return true;
+}
+
+bool PagePrefetcher::setResult(const QVariantMap &result) {
+    m_result = result;
+    return m_wanted;
+}
+
+QVariantMap PagePrefetcher::takeResult() {
+    const QVariantMap result = m_result;
+    m_result.clear();
+    m_wanted = false;
+    return result;
+}
+
+void PagePrefetcher::clear() {
+    m_page = QVariant();
+    m_result.clear();
+    m_wanted = false;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAGEPREFETCHER_H
+#define PAGEPREFETCHER_H
+
+#include <QVariantMap>
+
+/*
+ * Holds the state of a background request for the next page of an infinite-scroll model.
+ *
+ * The model calls start() when the view reports rows near the end, keeps the response with setResult(), and adds it
+ * with takeResult() when fetchMore() is called. If fetchMore() is called while the page is still loading, the model
+ * calls setWanted(), and adds the page as soon as setResult() reports that it is wanted.
+ */
+class PagePrefetcher
+{
+
+public:
+    PagePrefetcher();
+    
+    int threshold() const;
+    bool setThreshold(int threshold);
+    
+    QVariant page() const;
+    
+    bool isWanted() const;
+    void setWanted(bool wanted);
+    
+    bool hasResult() const;
+    
+    bool start(int lastVisibleRow, int rowCount, const QVariant &page);
+    
+    bool setResult(const QVariantMap &result);
+    QVariantMap takeResult();
+    
+    void clear();
+
+private:
+    int m_threshold;
+    
+    QVariant m_page;
+    QVariantMap m_result;
+    
+    bool m_wanted;
+};
+
+#endif // PAGEPREFETCHER_H
@@ -15,10 +15,14 @@
  */
 
 #include "playlist.h"
+#include "objectregistry.h"
+
+static ObjectRegistry<CTPlaylist> registry;
 
 CTPlaylist::CTPlaylist(QObject *parent) :
     QObject(parent)
 {
+    registry.insert(m_service, m_id, this);
 }
 
 CTPlaylist::CTPlaylist(const CTPlaylist *playlist, QObject *parent) :
@@ -34,6 +38,15 @@ CTPlaylist::CTPlaylist(const CTPlaylist *playlist, QObject *parent) :
     m_username(playlist->username()),
     m_videoCount(playlist->videoCount())
 {
+    registry.insert(m_service, m_id, this);
+}
+
+CTPlaylist::~CTPlaylist() {
+    registry.remove(m_service, m_id, this);
+}
+
+QList<CTPlaylist*> CTPlaylist::instances(const QString &service, const QString &id) {
+    return registry.objects(service, id);
 }
 
 QString CTPlaylist::date() const {
@@ -64,7 +77,9 @@ QString CTPlaylist::id() const {
 
 void CTPlaylist::setId(const QString &i) {
     if (i != id()) {
+        registry.remove(m_service, m_id, this);
         m_id = i;
+        registry.insert(m_service, m_id, this);
         emit idChanged();
     }
 }
@@ -86,7 +101,9 @@ QString CTPlaylist::service() const {
 
 void CTPlaylist::setService(const QString &s) {
     if (s != service()) {
+        registry.remove(m_service, m_id, this);
         m_service = s;
+        registry.insert(m_service, m_id, this);
         emit serviceChanged();
     }
 }
@@ -38,6 +38,9 @@ class CTPlaylist : public QObject
 public:
     explicit CTPlaylist(QObject *parent = 0);
     explicit CTPlaylist(const CTPlaylist *playlist, QObject *parent = 0);
+    ~CTPlaylist();
+    
+    static QList<CTPlaylist*> instances(const QString &service, const QString &id);
         
     QString date() const;
     
@@ -15,12 +15,8 @@
  */
 
 #include "resources.h"
-#include "dailymotion.h"
 #include "logger.h"
-#include "pluginmanager.h"
-#include "utils.h"
-#include "vimeo.h"
-#include "youtube.h"
+#include "urlrouter.h"
 
 const QString Resources::YOUTUBE("youtube");
 const QString Resources::DAILYMOTION("dailymotion");
@@ -196,70 +192,16 @@ QString Resources::subtitleConstant() {
 
 QVariantMap Resources::getResourceFromUrl(QString url) {
     Logger::log("Resources::getResourceFromUrl. URL: " + url, Logger::MediumVerbosity);
-    url = Utils::unescape(url);
-    QVariantMap result;
-
-    if (YouTube::URL_REGEXP.indexIn(url) == 0) {
-        result.insert("service", YOUTUBE);
-        result.insert("id", url.section(QRegExp("v=|list=|/"), -1).section(QRegExp("&|\\?"), 0, 0));
-
-        if ((url.contains("youtu.be")) || (url.contains("v=") || (url.contains("/v/")))) {
-            result.insert("type", VIDEO);
-        }
-        else if (url.contains("list=")) {
-            result.insert("type", PLAYLIST);
-        }
-        else {
-            result.insert("type", USER);
-        }
-    }
-    else if (Dailymotion::URL_REGEXP.indexIn(url) == 0) {
-        result.insert("service", DAILYMOTION);
-        result.insert("id", url.section('/', -1).section('_', 0, 0));
-
-        if ((url.contains("dai.ly") || (url.contains("/video/")))) {
-            result.insert("type", VIDEO);
-        }
-        else if (url.contains("/playlist/")) {
-            result.insert("type", PLAYLIST);
-        }
-        else {
-            result.insert("type", USER);
-        }
-    }
-    else if (Vimeo::URL_REGEXP.indexIn(url) == 0) {
-        const QString id = url.section('/', -1);
-
-        result.insert("service", VIMEO);
-        result.insert("id", id);
-
-        if (url.contains("/album/")) {
-            result.insert("type", PLAYLIST);
-        }
-        else if (id.contains(QRegExp("\\D+"))) {
-            result.insert("type", USER);
-        }
-        else {
-            result.insert("type", VIDEO);
-        }
-    }
-    else {
-        const QList<ServicePluginPair> plugins = PluginManager::instance()->plugins();
-
-        foreach (const ServicePluginPair &pair, plugins) {
-            if (const ServicePluginConfig *config = pair.config) {
-                
-                foreach (const GetResource &resource, config->getResources()) {                    
-                    if (resource.regExp().indexIn(url) == 0) {
-                        result.insert("service", config->id());
-                        result.insert("type", resource.type());
-                        result.insert("id", url);
-                        return result;
-                    }
-                }
-            }
-        }
+    return UrlRouter::instance()->route(url);
+}
+
+QVariantList Resources::getResourcesFromUrls(const QStringList &urls) {
+    Logger::log(QString("Resources::getResourcesFromUrls. %1 URLs").arg(urls.size()), Logger::MediumVerbosity);
+    QVariantList resources;
+    
+    foreach (const QVariantMap &resource, UrlRouter::instance()->route(urls)) {
+        resources << resource;
     }
     
-    return result;
+    return resources;
 }
@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QRegExp>
+#include <QStringList>
 #include <QVariantMap>
 
 class GetResource : public QVariantMap
@@ -116,6 +117,7 @@ public:
     static QString subtitleConstant();
     
     Q_INVOKABLE static QVariantMap getResourceFromUrl(QString url);
+    Q_INVOKABLE static QVariantList getResourcesFromUrls(const QStringList &urls);
 };
 
 #endif // RESOURCES_H
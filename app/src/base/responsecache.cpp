@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "responsecache.h"
+#include "json.h"
+#include "logger.h"
+
+QCache<QString, ResponseCache::Entry> ResponseCache::cache(50);
+QHash<QString, int> ResponseCache::ttls;
+
+int ResponseCache::stale = 3600;
+
+const int ResponseCache::DEFAULT_TTL = 900;
+
+static QHash<QString, int> defaultTtls() {
+    // Resources that change quickly or that the user can edit expire sooner
+    QHash<QString, int> hash;
+    hash["activities"] = 300;
+    hash["favorites"] = 300;
+    hash["likes"] = 300;
+    hash["playlistItems"] = 300;
+    hash["search"] = 300;
+    hash["subscriptions"] = 300;
+    hash["watchlater"] = 300;
+    return hash;
+}
+
+QString ResponseCache::key(const QString &service, const QString &resourcePath, const QVariant &args) {
+    // QVariantMap is sorted by key, so identical arguments always serialize identically
+    return QString("%1 %2 %3").arg(service).arg(resourcePath).arg(QString(QtJson::Json::serialize(args)));
+}
+
+QString ResponseCache::resourceType(const QString &resourcePath) {
+    return resourcePath.section('/', -1, -1, QString::SectionSkipEmpty);
+}
+
+QVariant ResponseCache::result(const QString &key, bool *isStale) {
+    if (const Entry *entry = cache.object(key)) {
+        const QDateTime now = QDateTime::currentDateTime();
+        
+        if (entry->expires > now) {
+            Logger::log("ResponseCache::result(). Fresh: " + key, Logger::HighestVerbosity);
+            
+            if (isStale) {
+                *isStale = false;
+            }
+            
+            return entry->result;
+        }
+        
+        if ((isStale) && (entry->expires.addSecs(stale) > now)) {
+            Logger::log("ResponseCache::result(). Stale: " + key, Logger::HighestVerbosity);
+            *isStale = true;
+            return entry->result;
+        }
+    }
+    
+    return QVariant();
+}
+
+void ResponseCache::insert(const QString &key, const QString &service, const QString &resourceType,
+                           const QVariant &result) {
+    const int ttl = timeToLive(service, resourceType);
+    
+    if (ttl <= 0) {
+        cache.remove(key);
+        return;
+    }
+    
+    Entry *entry = new Entry;
+    entry->service = service;
+    entry->resourceType = resourceType;
+    entry->result = result;
+    entry->expires = QDateTime::currentDateTime().addSecs(ttl);
+    cache.insert(key, entry);
+}
+
+int ResponseCache::timeToLive(const QString &service, const QString &resourceType) {
+    static const QHash<QString, int> defaults = defaultTtls();
+    const QString serviceKey = service + "/" + resourceType;
+    
+    if (ttls.contains(serviceKey)) {
+        return ttls.value(serviceKey);
+    }
+    
+    return ttls.value(resourceType, defaults.value(resourceType, DEFAULT_TTL));
+}
+
+void ResponseCache::setTimeToLive(const QString &service, const QString &resourceType, int seconds) {
+    ttls[service.isEmpty() ? resourceType : service + "/" + resourceType] = seconds;
+}
+
+int ResponseCache::staleTime() {
+    return stale;
+}
+
+void ResponseCache::setStaleTime(int seconds) {
+    stale = qMax(0, seconds);
+}
+
+int ResponseCache::maximumCount() {
+    return cache.maxCost();
+}
+
+void ResponseCache::setMaximumCount(int count) {
+    cache.setMaxCost(qMax(0, count));
+}
+
+void ResponseCache::invalidate(const QString &service, const QString &resourceType) {
+    Logger::log(QString("ResponseCache::invalidate(). Service: %1, Resource type: %2").arg(service).arg(resourceType),
+                Logger::HighVerbosity);
+    
+    foreach (const QString &key, cache.keys()) {
+        if (const Entry *entry = cache.object(key)) {
+            if ((entry->service == service) && ((resourceType.isEmpty()) || (entry->resourceType == resourceType))) {
+                cache.remove(key);
+            }
+        }
+    }
+}
+
+void ResponseCache::clear() {
+    cache.clear();
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+#include <QVariant>
+
+class ResponseCache
+{
+
+public:
+    static QString key(const QString &service, const QString &resourcePath, const QVariant &args = QVariant());
+    static QString resourceType(const QString &resourcePath);
+    
+    static QVariant result(const QString &key, bool *stale = 0);
+    static void insert(const QString &key, const QString &service, const QString &resourceType,
+                       const QVariant &result);
+    
+    static int timeToLive(const QString &service, const QString &resourceType);
+    static void setTimeToLive(const QString &service, const QString &resourceType, int seconds);
+    
+    static int staleTime();
+    static void setStaleTime(int seconds);
+    
+    static int maximumCount();
+    static void setMaximumCount(int count);
+    
+    static void invalidate(const QString &service, const QString &resourceType = QString());
+    static void clear();
+
+private:
+    struct Entry {
+        QString service;
+        QString resourceType;
+        QVariant result;
+        QDateTime expires;
+    };
+    
+    static QCache<QString, Entry> cache;
+    static QHash<QString, int> ttls;
+    
+    static int stale;
+    
+    static const int DEFAULT_TTL;
+};
+
+#endif // RESPONSECACHE_H
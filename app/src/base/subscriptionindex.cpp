@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "subscriptionindex.h"
+#include "database.h"
+#include "logger.h"
+#include <QTimer>
+
+int SubscriptionIndex::interval = 3600;
+
+SubscriptionIndex::SubscriptionIndex(const QString &service, QObject *parent) :
+    QObject(parent),
+    m_service(service),
+    m_syncing(false)
+{
+}
+
+SubscriptionIndex::~SubscriptionIndex() {}
+
+QString SubscriptionIndex::service() const {
+    return m_service;
+}
+
+QString SubscriptionIndex::userId() const {
+    return m_userId;
+}
+
+void SubscriptionIndex::setUserId(const QString &userId) {
+    if (userId == m_userId) {
+        return;
+    }
+    
+    Logger::log(QString("SubscriptionIndex::setUserId(). Service: %1, User ID: %2").arg(service()).arg(userId),
+                Logger::MediumVerbosity);
+    cancel();
+    m_userId = userId;
+    m_ids.clear();
+    m_lastSync = QDateTime();
+    
+    if (userId.isEmpty()) {
+        return;
+    }
+    
+    load();
+    
+    // The stored index can be used straight away, so an out of date one is refreshed in the background
+    if ((!isLoaded()) || (lastSync().secsTo(QDateTime::currentDateTime()) >= syncInterval())) {
+        QTimer::singleShot(0, this, SLOT(sync()));
+    }
+}
+
+bool SubscriptionIndex::isLoaded() const {
+    return m_lastSync.isValid();
+}
+
+bool SubscriptionIndex::isSyncing() const {
+    return m_syncing;
+}
+
+QDateTime SubscriptionIndex::lastSync() const {
+    return m_lastSync;
+}
+
+QStringList SubscriptionIndex::ids() const {
+    return m_ids.keys();
+}
+
+bool SubscriptionIndex::contains(const QString &id) const {
+    return m_ids.contains(id);
+}
+
+QString SubscriptionIndex::subscriptionId(const QString &id) const {
+    return m_ids.value(id);
+}
+
+void SubscriptionIndex::insert(const QString &id, const QString &subscriptionId) {
+    m_ids.insert(id, subscriptionId);
+    
+    if (m_syncing) {
+        m_pending.insert(id, subscriptionId);
+    }
+    
+    QSqlQuery query(getDatabase());
+    query.prepare("INSERT OR REPLACE INTO subscriptions VALUES (?, ?, ?, ?)");
+    query.addBindValue(service());
+    query.addBindValue(userId());
+    query.addBindValue(id);
+    query.addBindValue(subscriptionId);
+    
+    if (!query.exec()) {
+        Logger::log("SubscriptionIndex::insert(): database error: " + query.lastError().text());
+    }
+}
+
+void SubscriptionIndex::remove(const QString &id) {
+    m_ids.remove(id);
+    m_pending.remove(id);
+    
+    QSqlQuery query(getDatabase());
+    query.prepare("DELETE FROM subscriptions WHERE service = ? AND userId = ? AND id = ?");
+    query.addBindValue(service());
+    query.addBindValue(userId());
+    query.addBindValue(id);
+    
+    if (!query.exec()) {
+        Logger::log("SubscriptionIndex::remove(): database error: " + query.lastError().text());
+    }
+}
+
+int SubscriptionIndex::syncInterval() {
+    return interval;
+}
+
+void SubscriptionIndex::setSyncInterval(int seconds) {
+    interval = qMax(0, seconds);
+}
+
+void SubscriptionIndex::sync() {
+    if ((m_syncing) || (userId().isEmpty())) {
+        return;
+    }
+    
+    Logger::log(QString("SubscriptionIndex::sync(). Service: %1, User ID: %2").arg(service()).arg(userId()),
+                Logger::MediumVerbosity);
+    m_syncing = true;
+    m_pending.clear();
+    fetchPage(QVariant());
+}
+
+void SubscriptionIndex::cancel() {
+    if (m_syncing) {
+        m_syncing = false;
+        m_pending.clear();
+        cancelPage();
+    }
+}
+
+void SubscriptionIndex::addPage(const QHash<QString, QString> &ids, const QVariant &next, int total) {
+    if (!m_syncing) {
+        return;
+    }
+    
+    QHash<QString, QString>::const_iterator iterator = ids.constBegin();
+    bool reachedIndex = false;
+    
+    while (iterator != ids.constEnd()) {
+        const QHash<QString, QString>::const_iterator existing = m_ids.constFind(iterator.key());
+        
+        if ((existing != m_ids.constEnd()) && (existing.value() == iterator.value())) {
+            reachedIndex = true;
+        }
+        
+        m_pending.insert(iterator.key(), iterator.value());
+        ++iterator;
+    }
+    
+    if (!next.isNull()) {
+        // The remaining pages are older than a stored subscription, so they are already in the stored index
+        // unless some subscriptions were removed, in which case the stored index is larger than the total
+        if ((reachedIndex) && (total >= 0) && (isLoaded()) && (mergedCount() == total)) {
+            Logger::log(QString("SubscriptionIndex::addPage(). Reached the stored index. Service: %1, User ID: %2")
+                               .arg(service()).arg(userId()), Logger::MediumVerbosity);
+            
+            foreach (const QString &id, m_ids.keys()) {
+                if (!m_pending.contains(id)) {
+                    m_pending.insert(id, m_ids.value(id));
+                }
+            }
+        }
+        else {
+            fetchPage(next);
+            return;
+        }
+    }
+    
+    commit();
+    m_syncing = false;
+    m_pending.clear();
+    emit synced();
+}
+
+void SubscriptionIndex::pageFailed(const QString &errorString) {
+    if (!m_syncing) {
+        return;
+    }
+    
+    // The stored index is kept as it is until a later sync succeeds
+    Logger::log("SubscriptionIndex::pageFailed(). Error: " + errorString);
+    m_syncing = false;
+    m_pending.clear();
+    emit synced();
+}
+
+int SubscriptionIndex::mergedCount() const {
+    int count = m_ids.size();
+    
+    foreach (const QString &id, m_pending.keys()) {
+        if (!m_ids.contains(id)) {
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+void SubscriptionIndex::load() {
+    QSqlQuery query(getDatabase());
+    query.prepare("SELECT id, subscriptionId FROM subscriptions WHERE service = ? AND userId = ?");
+    query.addBindValue(service());
+    query.addBindValue(userId());
+    
+    if (!query.exec()) {
+        Logger::log("SubscriptionIndex::load(): database error: " + query.lastError().text());
+        return;
+    }
+    
+    while (query.next()) {
+        m_ids.insert(query.value(0).toString(), query.value(1).toString());
+    }
+    
+    query.prepare("SELECT synced FROM subscriptionSyncs WHERE service = ? AND userId = ?");
+    query.addBindValue(service());
+    query.addBindValue(userId());
+    
+    if (!query.exec()) {
+        Logger::log("SubscriptionIndex::load(): database error: " + query.lastError().text());
+        return;
+    }
+    
+    if (query.next()) {
+        m_lastSync = QDateTime::fromString(query.value(0).toString(), Qt::ISODate);
+    }
+    
+    Logger::log(QString("SubscriptionIndex::load(). Service: %1, User ID: %2, Subscriptions: %3")
+                       .arg(service()).arg(userId()).arg(m_ids.size()), Logger::MediumVerbosity);
+}
+
+void SubscriptionIndex::commit() {
+    QSqlDatabase db = getDatabase();
+    db.transaction();
+    QSqlQuery query(db);
+    int removed = 0;
+    int changed = 0;
+    
+    // Only the rows that differ from the stored index are written
+    query.prepare("DELETE FROM subscriptions WHERE service = ? AND userId = ? AND id = ?");
+    
+    foreach (const QString &id, m_ids.keys()) {
+        if (!m_pending.contains(id)) {
+            query.addBindValue(service());
+            query.addBindValue(userId());
+            query.addBindValue(id);
+            
+            if (!query.exec()) {
+                Logger::log("SubscriptionIndex::commit(): database error: " + query.lastError().text());
+                db.rollback();
+                return;
+            }
+            
+            removed++;
+        }
+    }
+    
+    query.prepare("INSERT OR REPLACE INTO subscriptions VALUES (?, ?, ?, ?)");
+    QHash<QString, QString>::const_iterator iterator = m_pending.constBegin();
+    
+    while (iterator != m_pending.constEnd()) {
+        const QHash<QString, QString>::const_iterator existing = m_ids.constFind(iterator.key());
+        
+        if ((existing == m_ids.constEnd()) || (existing.value() != iterator.value())) {
+            query.addBindValue(service());
+            query.addBindValue(userId());
+            query.addBindValue(iterator.key());
+            query.addBindValue(iterator.value());
+            
+            if (!query.exec()) {
+                Logger::log("SubscriptionIndex::commit(): database error: " + query.lastError().text());
+                db.rollback();
+                return;
+            }
+            
+            changed++;
+        }
+        
+        ++iterator;
+    }
+    
+    const QDateTime synced = QDateTime::currentDateTime();
+    query.prepare("INSERT OR REPLACE INTO subscriptionSyncs VALUES (?, ?, ?)");
+    query.addBindValue(service());
+    query.addBindValue(userId());
+    query.addBindValue(synced.toString(Qt::ISODate));
+    
+    if (!query.exec()) {
+        Logger::log("SubscriptionIndex::commit(): database error: " + query.lastError().text());
+        db.rollback();
+        return;
+    }
+    
+    if (!db.commit()) {
+        Logger::log("SubscriptionIndex::commit(): database error: " + db.lastError().text());
+        db.rollback();
+        return;
+    }
+    
+    // The in-memory index is only replaced once the stored one matches it
+    m_ids = m_pending;
+    m_lastSync = synced;
+    Logger::log(QString("SubscriptionIndex::commit(). Service: %1, User ID: %2, Removed: %3, Added/changed: %4")
+                       .arg(service()).arg(userId()).arg(removed).arg(changed), Logger::MediumVerbosity);
+}
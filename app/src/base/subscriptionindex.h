@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SUBSCRIPTIONINDEX_H
+#define SUBSCRIPTIONINDEX_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QVariant>
+
+/*
+ * Keeps the ids of the users that the current account subscribes to, persisted in the database.
+ *
+ * The stored index is read when the account changes, so membership is known from startup without
+ * any requests. It is refreshed in the background once it is older than syncInterval(). A refresh
+ * walks the pages of the account's subscriptions and then writes only the rows that changed.
+ *
+ * A service that lists the most recent subscriptions first can pass the total to addPage(), and the
+ * refresh then stops at the first page that reaches the stored index if nothing was removed since.
+ * Otherwise every page is fetched on each refresh.
+ *
+ * Subclasses fetch the pages from their service (see fetchPage()).
+ */
+class SubscriptionIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~SubscriptionIndex();
+    
+    QString service() const;
+    QString userId() const;
+    
+    bool isLoaded() const;
+    bool isSyncing() const;
+    
+    QDateTime lastSync() const;
+    
+    QStringList ids() const;
+    
+    bool contains(const QString &id) const;
+    QString subscriptionId(const QString &id) const;
+    
+    void insert(const QString &id, const QString &subscriptionId = QString());
+    void remove(const QString &id);
+    
+    static int syncInterval();
+    static void setSyncInterval(int seconds);
+
+public Q_SLOTS:
+    void setUserId(const QString &userId);
+    
+    void sync();
+    void cancel();
+
+Q_SIGNALS:
+    void synced();
+
+protected:
+    explicit SubscriptionIndex(const QString &service, QObject *parent = 0);
+    
+    // Requests the page that follows cursor, or the first page if cursor is null
+    virtual void fetchPage(const QVariant &cursor) = 0;
+    virtual void cancelPage() = 0;
+    
+    // A null next cursor marks the last page. A total of -1 means the listing is not ordered newest first.
+    void addPage(const QHash<QString, QString> &ids, const QVariant &next, int total = -1);
+    void pageFailed(const QString &errorString);
+
+private:
+    int mergedCount() const;
+    
+    void load();
+    void commit();
+    
+    QString m_service;
+    QString m_userId;
+    
+    QHash<QString, QString> m_ids;
+    QHash<QString, QString> m_pending;
+    
+    QDateTime m_lastSync;
+    
+    bool m_syncing;
+    
+    static int interval;
+};
+
+#endif // SUBSCRIPTIONINDEX_H
@@ -92,6 +92,59 @@ QVariant TransferModel::headerData(int section, Qt::Orientation orientation, int
     }
 }
 
+QVariant TransferModel::roleData(const Transfer *transfer, int role) {
+    switch (role) {
+    case BytesTransferredRole:
+        return transfer->bytesTransferred();
+    case CategoryRole:
+        return transfer->category();
+    case CustomCommandRole:
+        return transfer->customCommand();
+    case CustomCommandOverrideEnabledRole:
+        return transfer->customCommandOverrideEnabled();
+    case DownloadPathRole:
+        return transfer->downloadPath();
+    case DownloadSubtitlesRole:
+        return transfer->downloadSubtitles();
+    case ErrorStringRole:
+        return transfer->errorString();
+    case FileNameRole:
+        return transfer->fileName();
+    case IdRole:
+        return transfer->id();
+    case PriorityRole:
+        return int(transfer->priority());
+    case PriorityStringRole:
+        return transfer->priorityString();
+    case ProgressRole:
+        return transfer->progress();
+    case ProgressStringRole:
+        return transfer->progressString();
+    case ServiceRole:
+        return transfer->service();
+    case SizeRole:
+        return transfer->size();
+    case StatusRole:
+        return int(transfer->status());
+    case StatusStringRole:
+        return transfer->statusString();
+    case StreamIdRole:
+        return transfer->streamId();
+    case SubtitlesLanguageRole:
+        return transfer->subtitlesLanguage();
+    case TitleRole:
+        return transfer->title();
+    case TransferTypeRole:
+        return int(transfer->transferType());
+    case UrlRole:
+        return transfer->url();
+    case VideoIdRole:
+        return transfer->videoId();
+    default:
+        return QVariant();
+    }
+}
+
 QVariant TransferModel::data(const QModelIndex &index, int role) const {
     if (const Transfer *transfer = Transfers::instance()->get(index.row())) {
         if (role == Qt::DisplayRole) {
@@ -111,7 +164,7 @@ QVariant TransferModel::data(const QModelIndex &index, int role) const {
             }
         }
         else {
-            return transfer->property(m_roles[role]);
+            return roleData(transfer, role);
         }
     }
     
@@ -126,7 +179,7 @@ QMap<int, QVariant> TransferModel::itemData(const QModelIndex &index) const {
         
         while (iterator.hasNext()) {
             iterator.next();
-            map[iterator.key()] = transfer->property(iterator.value());
+            map[iterator.key()] = roleData(transfer, iterator.key());
         }
     }
     
@@ -157,7 +210,7 @@ bool TransferModel::setItemData(const QModelIndex &index, const QMap<int, QVaria
 
 QVariant TransferModel::data(int row, const QByteArray &role) const {
     if (const Transfer *transfer = Transfers::instance()->get(row)) {
-        return transfer->property(role);
+        return roleData(transfer, m_roles.key(role));
     }
 
     return QVariant();
@@ -167,8 +220,11 @@ QVariantMap TransferModel::itemData(int row) const {
     QVariantMap map;
     
     if (const Transfer *transfer = Transfers::instance()->get(row)) {
-        foreach (const QByteArray &value, m_roles.values()) {
-            map[value] = transfer->property(value);
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.value()] = roleData(transfer, iterator.key());
         }
     }
     
@@ -77,6 +77,8 @@ public:
     Q_INVOKABLE int match(const QByteArray &role, const QVariant &value) const;
     
 private:
+    static QVariant roleData(const Transfer *transfer, int role);
+    
     int indexOf(Transfer *transfer) const;
     
 private Q_SLOTS:
@@ -16,15 +16,22 @@
 
 #include "transfers.h"
 #include "dailymotiontransfer.h"
+#include "dailymotionvideo.h"
 #include "definitions.h"
+#include "library.h"
 #include "logger.h"
 #include "plugintransfer.h"
+#include "pluginvideo.h"
 #include "resources.h"
 #include "settings.h"
+#include "urlrouter.h"
 #include "utils.h"
 #include "vimeotransfer.h"
+#include "vimeovideo.h"
 #include "youtubetransfer.h"
+#include "youtubevideo.h"
 #include <QNetworkAccessManager>
+#include <QSet>
 #include <QSettings>
 
 Transfers* Transfers::self = 0;
@@ -79,6 +86,73 @@ void Transfers::addDownloadTransfer(const QString &service, const QString &video
                                     bool customCommandOverrideEnabled) {
     Logger::log(QString("Transfers::addDownloadTransfer(). Service: %1, Video ID: %2, Stream ID: %3, Stream URL: %4, Title: %5, Category: %6, Subtitles: %7, Command: %8").arg(service).arg(videoId).arg(streamId).arg(streamUrl.toString())
                                                   .arg(title).arg(category).arg(subtitlesLanguage).arg(customCommand));
+    Transfer *transfer = createDownloadTransfer(service, videoId, streamId, streamUrl, title, category,
+                                                subtitlesLanguage, customCommand, customCommandOverrideEnabled);
+    m_transfers << transfer;
+    emit countChanged(count());
+    emit transferAdded(transfer);
+    
+    if (Settings::startTransfersAutomatically()) {
+        transfer->queue();
+    }
+}
+
+int Transfers::addDownloadTransfers(const QStringList &urls, const QString &category) {
+    Logger::log(QString("Transfers::addDownloadTransfers(). %1 URLs").arg(urls.size()), Logger::MediumVerbosity);
+    // Videos that are already in the queue are not added again
+    QSet<QString> existing;
+    
+    foreach (const Transfer *transfer, m_transfers) {
+        existing << transfer->service() + "/" + transfer->videoId();
+    }
+    
+    const QString cat = category.isEmpty() ? Settings::defaultCategory() : category;
+    QList<Transfer*> added;
+    
+    foreach (const QVariantMap &resource, UrlRouter::instance()->route(urls)) {
+        if (resource.value("type") != Resources::VIDEO) {
+            continue;
+        }
+        
+        const QString service = resource.value("service").toString();
+        const QString videoId = resource.value("id").toString();
+        const QString key = service + "/" + videoId;
+        
+        if (existing.contains(key)) {
+            continue;
+        }
+        
+        existing << key;
+        // The title is not known until the video is requested, so the ID is used as a placeholder
+        Transfer *transfer = createDownloadTransfer(service, videoId, Settings::defaultDownloadFormat(service), QUrl(),
+                                                    videoId, cat);
+        loadVideoTitle(transfer);
+        added << transfer;
+    }
+    
+    if (added.isEmpty()) {
+        return 0;
+    }
+    
+    // The transfers are added as one batch, so that models are only updated once
+    m_transfers << added;
+    emit countChanged(count());
+    
+    foreach (Transfer *transfer, added) {
+        emit transferAdded(transfer);
+        
+        if (Settings::startTransfersAutomatically()) {
+            transfer->queue();
+        }
+    }
+    
+    return added.size();
+}
+
+Transfer* Transfers::createDownloadTransfer(const QString &service, const QString &videoId, const QString &streamId,
+                                           const QUrl &streamUrl, const QString &title, const QString &category,
+                                           const QString &subtitlesLanguage, const QString &customCommand,
+                                           bool customCommandOverrideEnabled) {
     Transfer *transfer = createTransfer(service, this);
     transfer->setNetworkAccessManager(m_nam);
     transfer->setId(Utils::createId());
@@ -98,13 +172,33 @@ void Transfers::addDownloadTransfer(const QString &service, const QString &video
     }
     
     connect(transfer, SIGNAL(statusChanged()), this, SLOT(onTransferStatusChanged()));
+    return transfer;
+}
+
+void Transfers::loadVideoTitle(Transfer *transfer) {
+    // The video is a child of the transfer, so it is deleted along with the transfer if the title is never loaded
+    const QString service = transfer->service();
+    const QString id = transfer->videoId();
     
-    m_transfers << transfer;
-    emit countChanged(count());
-    emit transferAdded(transfer);
-    
-    if (Settings::startTransfersAutomatically()) {
-        transfer->queue();
+    if (service == Resources::YOUTUBE) {
+        YouTubeVideo *video = new YouTubeVideo(transfer);
+        connect(video, SIGNAL(titleChanged()), this, SLOT(onVideoTitleChanged()));
+        video->loadVideo(id);
+    }
+    else if (service == Resources::DAILYMOTION) {
+        DailymotionVideo *video = new DailymotionVideo(transfer);
+        connect(video, SIGNAL(titleChanged()), this, SLOT(onVideoTitleChanged()));
+        video->loadVideo(id);
+    }
+    else if (service == Resources::VIMEO) {
+        VimeoVideo *video = new VimeoVideo(transfer);
+        connect(video, SIGNAL(titleChanged()), this, SLOT(onVideoTitleChanged()));
+        video->loadVideo(id);
+    }
+    else {
+        PluginVideo *video = new PluginVideo(transfer);
+        connect(video, SIGNAL(titleChanged()), this, SLOT(onVideoTitleChanged()));
+        video->loadVideo(service, id);
     }
 }
 
@@ -295,8 +389,17 @@ void Transfers::onTransferStatusChanged() {
         case Transfer::Failed:
             removeActiveTransfer(transfer);
             break;
-        case Transfer::Canceled:
         case Transfer::Completed:
+            // The file path is only set for downloads
+            if (!transfer->filePath().isEmpty()) {
+                Library::instance()->add(transfer->service(), transfer->videoId(), transfer->title(),
+                                         transfer->category(), transfer->filePath(), transfer->size());
+            }
+            
+            removeTransfer(transfer);
+            save();
+            break;
+        case Transfer::Canceled:
             removeTransfer(transfer);
             save();
             break;
@@ -312,6 +415,27 @@ void Transfers::onTransferStatusChanged() {
     }
 }
 
+void Transfers::onVideoTitleChanged() {
+    CTVideo *video = qobject_cast<CTVideo*>(sender());
+    
+    if ((!video) || (video->title().isEmpty())) {
+        return;
+    }
+    
+    if (Transfer *transfer = qobject_cast<Transfer*>(video->parent())) {
+        Logger::log(QString("Transfers::onVideoTitleChanged(). ID: %1, Title: %2").arg(transfer->id())
+                           .arg(video->title()), Logger::MediumVerbosity);
+        transfer->setTitle(video->title());
+        
+        // A download that has already written data keeps its file name, so that it can be resumed
+        if ((transfer->status() < Transfer::Connecting) && (transfer->bytesTransferred() == 0)) {
+            transfer->setFileName(video->title() + ".mp4");
+        }
+    }
+    
+    video->deleteLater();
+}
+
 void Transfers::onMaximumConcurrentTransfersChanged(int maximum) {
     int act = active();
     
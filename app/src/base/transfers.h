@@ -47,6 +47,8 @@ public:
     Q_INVOKABLE Transfer* get(const QString &id) const;
     
 public Q_SLOTS:
+    int addDownloadTransfers(const QStringList &urls, const QString &category = QString());
+    
     bool start();
     bool pause();
     bool start(const QString &id);
@@ -57,8 +59,16 @@ public Q_SLOTS:
     void restore();
     
 private:
+    Transfer* createDownloadTransfer(const QString &service, const QString &videoId, const QString &streamId,
+                                     const QUrl &streamUrl, const QString &title, const QString &category,
+                                     const QString &subtitlesLanguage = QString(),
+                                     const QString &customCommand = QString(),
+                                     bool customCommandOverrideEnabled = false);
+    
     void getNextTransfers();
     
+    void loadVideoTitle(Transfer *transfer);
+    
     void removeTransfer(Transfer *transfer);
 
     void addActiveTransfer(Transfer *transfer);
@@ -68,6 +78,7 @@ private Q_SLOTS:
     void startNextTransfers();
     
     void onTransferStatusChanged();
+    void onVideoTitleChanged();
     void onMaximumConcurrentTransfersChanged(int maximum);
     
 Q_SIGNALS:
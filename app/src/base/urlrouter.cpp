@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "urlrouter.h"
+#include "dailymotion.h"
+#include "logger.h"
+#include "pluginmanager.h"
+#include "resources.h"
+#include "utils.h"
+#include "vimeo.h"
+#include "youtube.h"
+#include <QUrl>
+
+static const QRegExp YOUTUBE_ID_PREFIX("v=|list=|/");
+static const QRegExp YOUTUBE_ID_SUFFIX("&|\\?");
+static const QRegExp NON_DIGITS("\\D+");
+
+UrlRouter* UrlRouter::self = 0;
+
+UrlRouter::UrlRouter() :
+    QObject()
+{
+    reload();
+    connect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(reload()));
+}
+
+UrlRouter::~UrlRouter() {
+    self = 0;
+}
+
+UrlRouter* UrlRouter::instance() {
+    return self ? self : self = new UrlRouter;
+}
+
+QVariantMap UrlRouter::route(const QString &url) const {
+    const QString u = Utils::unescape(url);
+    const QVector<int> indexes = candidates(u);
+    int previous = -1;
+    
+    foreach (int i, indexes) {
+        // A route can be reached through more than one host
+        if (i == previous) {
+            continue;
+        }
+        
+        previous = i;
+        const Route &r = m_routes.at(i);
+        
+        if (r.regExp.indexIn(u) == 0) {
+            return resource(r, u);
+        }
+    }
+    
+    return QVariantMap();
+}
+
+QList<QVariantMap> UrlRouter::route(const QStringList &urls) const {
+    QList<QVariantMap> resources;
+    QHash<QString, QVariantMap> routed;
+    
+    foreach (const QString &url, urls) {
+        QHash<QString, QVariantMap>::const_iterator iterator = routed.constFind(url);
+        
+        if (iterator == routed.constEnd()) {
+            iterator = routed.insert(url, route(url));
+        }
+        
+        resources << iterator.value();
+    }
+    
+    return resources;
+}
+
+QString UrlRouter::hostFromPattern(const QString &pattern) {
+    int i = pattern.indexOf("://");
+    
+    if (i == -1) {
+        return QString();
+    }
+    
+    i += 3;
+    
+    // Optional subdomain groups, e.g. "(www.|m.|)", are skipped, as the host is matched by suffix
+    while ((i < pattern.size()) && (pattern.at(i) == '(')) {
+        const int end = pattern.indexOf(')', i);
+        
+        if (end == -1) {
+            return QString();
+        }
+        
+        const QString group = pattern.mid(i + 1, end - i - 1);
+        
+        if (group.contains('(')) {
+            return QString();
+        }
+        
+        bool optional = (end + 1 < pattern.size()) && (pattern.at(end + 1) == '?');
+        
+        foreach (const QString &alternative, group.split('|')) {
+            if (alternative.isEmpty()) {
+                optional = true;
+            }
+            else if (!alternative.endsWith('.')) {
+                return QString();
+            }
+        }
+        
+        if (!optional) {
+            return QString();
+        }
+        
+        i = end + 1;
+        
+        if ((i < pattern.size()) && (pattern.at(i) == '?')) {
+            i++;
+        }
+    }
+    
+    QString host;
+    
+    while (i < pattern.size()) {
+        const QChar c = pattern.at(i);
+        
+        if ((c.isLetterOrNumber()) || (c == '-') || (c == '.')) {
+            host.append(c.toLower());
+        }
+        else if ((c == '\\') && (i + 1 < pattern.size()) && (pattern.at(i + 1) == '.')) {
+            host.append('.');
+            i++;
+        }
+        else if ((c == '/') || ((c == '\\') && (i + 1 < pattern.size()) && (pattern.at(i + 1) == '/'))) {
+            // The host must be followed by a path, otherwise the pattern also matches longer hosts
+            return host.contains('.') ? host : QString();
+        }
+        else {
+            return QString();
+        }
+        
+        i++;
+    }
+    
+    return QString();
+}
+
+void UrlRouter::reload() {
+    m_routes.clear();
+    m_hosts.clear();
+    m_anyHost.clear();
+    
+    addRoute(YouTubeRoute, Resources::YOUTUBE, QString(), YouTube::URL_REGEXP,
+             QStringList() << "youtube.com" << "youtu.be");
+    addRoute(DailymotionRoute, Resources::DAILYMOTION, QString(), Dailymotion::URL_REGEXP,
+             QStringList() << "dailymotion.com" << "dai.ly");
+    addRoute(VimeoRoute, Resources::VIMEO, QString(), Vimeo::URL_REGEXP, QStringList() << "vimeo.com");
+    
+    foreach (const ServicePluginPair &pair, PluginManager::instance()->plugins()) {
+        if (const ServicePluginConfig *config = pair.config) {
+            foreach (const GetResource &resource, config->getResources()) {
+                const QRegExp regExp = resource.regExp();
+                const QString host = hostFromPattern(regExp.pattern());
+                addRoute(PluginRoute, config->id(), resource.type(), regExp,
+                         host.isEmpty() ? QStringList() : QStringList() << host);
+            }
+        }
+    }
+    
+    Logger::log(QString("UrlRouter::reload(). %1 routes, %2 hosts, %3 routes for any host").arg(m_routes.size())
+                .arg(m_hosts.size()).arg(m_anyHost.size()), Logger::MediumVerbosity);
+}
+
+void UrlRouter::addRoute(RouteKind kind, const QString &service, const QString &type, const QRegExp &regExp,
+                         const QStringList &hosts) {
+    Route r;
+    r.kind = kind;
+    r.service = service;
+    r.type = type;
+    r.regExp = regExp;
+    m_routes << r;
+    
+    if (hosts.isEmpty()) {
+        m_anyHost << m_routes.size() - 1;
+    }
+    else {
+        foreach (const QString &host, hosts) {
+            m_hosts[host] << m_routes.size() - 1;
+        }
+    }
+}
+
+QVector<int> UrlRouter::candidates(const QString &url) const {
+    QVector<int> indexes = m_anyHost;
+    QString host = QUrl(url).host().toLower();
+    
+    // e.g. "m.youtube.com", then "youtube.com", then "com"
+    while (!host.isEmpty()) {
+        QHash<QString, QVector<int> >::const_iterator iterator = m_hosts.constFind(host);
+        
+        if (iterator != m_hosts.constEnd()) {
+            indexes << iterator.value();
+        }
+        
+        const int dot = host.indexOf('.');
+        
+        if (dot == -1) {
+            break;
+        }
+        
+        host = host.mid(dot + 1);
+    }
+    
+    qSort(indexes);
+    return indexes;
+}
+
+QVariantMap UrlRouter::resource(const Route &r, const QString &url) const {
+    QVariantMap result;
+    result.insert("service", r.service);
+    
+    switch (r.kind) {
+    case YouTubeRoute:
+        result.insert("id", url.section(YOUTUBE_ID_PREFIX, -1).section(YOUTUBE_ID_SUFFIX, 0, 0));
+        
+        if ((url.contains("youtu.be")) || (url.contains("v=") || (url.contains("/v/")))) {
+            result.insert("type", Resources::VIDEO);
+        }
+        else if (url.contains("list=")) {
+            result.insert("type", Resources::PLAYLIST);
+        }
+        else {
+            result.insert("type", Resources::USER);
+        }
+        
+        break;
+    case DailymotionRoute:
+        result.insert("id", url.section('/', -1).section('_', 0, 0));
+        
+        if ((url.contains("dai.ly") || (url.contains("/video/")))) {
+            result.insert("type", Resources::VIDEO);
+        }
+        else if (url.contains("/playlist/")) {
+            result.insert("type", Resources::PLAYLIST);
+        }
+        else {
+            result.insert("type", Resources::USER);
+        }
+        
+        break;
+    case VimeoRoute:
+        result.insert("id", url.section('/', -1));
+        
+        if (url.contains("/album/")) {
+            result.insert("type", Resources::PLAYLIST);
+        }
+        else if (url.section('/', -1).contains(NON_DIGITS)) {
+            result.insert("type", Resources::USER);
+        }
+        else {
+            result.insert("type", Resources::VIDEO);
+        }
+        
+        break;
+    default:
+        result.insert("type", r.type);
+        result.insert("id", url);
+        break;
+    }
+    
+    return result;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef URLROUTER_H
+#define URLROUTER_H
+
+#include <QHash>
+#include <QObject>
+#include <QRegExp>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+/*
+ * Maps URLs to resources (service, type and id).
+ *
+ * The routes of the built-in services and the 'get' resources of the plugins are compiled once, when the plugins are
+ * loaded. Routes are indexed by host where the host can be read from the pattern, so that a URL is only tested
+ * against the routes for its host and those that can match any host. Routes are tested in order of registration.
+ */
+class UrlRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~UrlRouter();
+    
+    static UrlRouter* instance();
+    
+    QVariantMap route(const QString &url) const;
+    QList<QVariantMap> route(const QStringList &urls) const;
+    
+    static QString hostFromPattern(const QString &pattern);
+
+public Q_SLOTS:
+    void reload();
+
+private:
+    enum RouteKind {
+        YouTubeRoute = 0,
+        DailymotionRoute,
+        VimeoRoute,
+        PluginRoute
+    };
+    
+    struct Route
+    {
+        RouteKind kind;
+        QString service;
+        QString type;
+        QRegExp regExp;
+    };
+    
+    UrlRouter();
+    
+    void addRoute(RouteKind kind, const QString &service, const QString &type, const QRegExp &regExp,
+                  const QStringList &hosts);
+    
+    QVector<int> candidates(const QString &url) const;
+    
+    QVariantMap resource(const Route &r, const QString &url) const;
+    
+    static UrlRouter *self;
+    
+    QVector<Route> m_routes;
+    
+    QHash<QString, QVector<int> > m_hosts;
+    
+    QVector<int> m_anyHost;
+};
+
+#endif // URLROUTER_H
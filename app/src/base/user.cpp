@@ -15,10 +15,14 @@
  */
 
 #include "user.h"
+#include "objectregistry.h"
+
+static ObjectRegistry<CTUser> registry;
 
 CTUser::CTUser(QObject *parent) :
     QObject(parent)
 {
+    registry.insert(m_service, m_id, this);
 }
 
 CTUser::CTUser(const CTUser *user, QObject *parent) :
@@ -30,6 +34,15 @@ CTUser::CTUser(const CTUser *user, QObject *parent) :
     m_thumbnailUrl(user->thumbnailUrl()),
     m_username(user->username())
 {
+    registry.insert(m_service, m_id, this);
+}
+
+CTUser::~CTUser() {
+    registry.remove(m_service, m_id, this);
+}
+
+QList<CTUser*> CTUser::instances(const QString &service, const QString &id) {
+    return registry.objects(service, id);
 }
 
 QString CTUser::description() const {
@@ -49,7 +62,9 @@ QString CTUser::id() const {
 
 void CTUser::setId(const QString &i) {
     if (i != id()) {
+        registry.remove(m_service, m_id, this);
         m_id = i;
+        registry.insert(m_service, m_id, this);
         emit idChanged();
     }
 }
@@ -71,7 +86,9 @@ QString CTUser::service() const {
 
 void CTUser::setService(const QString &s) {
     if (s != service()) {
+        registry.remove(m_service, m_id, this);
         m_service = s;
+        registry.insert(m_service, m_id, this);
         emit serviceChanged();
     }
 }
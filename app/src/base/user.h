@@ -34,6 +34,9 @@ class CTUser : public QObject
 public:
     explicit CTUser(QObject *parent = 0);
     explicit CTUser(const CTUser *user, QObject *parent = 0);
+    ~CTUser();
+    
+    static QList<CTUser*> instances(const QString &service, const QString &id);
             
     QString description() const;
             
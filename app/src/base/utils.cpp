@@ -30,6 +30,24 @@ QString Utils::createId() {
     return uuid.mid(1, uuid.size() - 2);
 }
 
+QStringList Utils::extractUrls(const QString &text) {
+    static const QRegExp re("http(s|)://[^\\s<>\"']+");
+    QStringList urls;
+    int pos = 0;
+    
+    while ((pos = re.indexIn(text, pos)) != -1) {
+        const QString url = re.cap(0);
+        
+        if (!urls.contains(url)) {
+            urls << url;
+        }
+        
+        pos += re.matchedLength();
+    }
+    
+    return urls;
+}
+
 QString Utils::formatBytes(qint64 bytes) {
     if (bytes <= 0) {
         return QString("0B");
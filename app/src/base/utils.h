@@ -18,6 +18,7 @@
 #define UTILS_H
 
 #include <QObject>
+#include <QStringList>
 
 class QString;
 class QUrl;
@@ -31,6 +32,8 @@ public:
     
     Q_INVOKABLE static QString createId();
     
+    Q_INVOKABLE static QStringList extractUrls(const QString &text);
+    
     Q_INVOKABLE static QString formatBytes(qint64 bytes);
     
     Q_INVOKABLE static QString formatLargeNumber(qint64 num);
@@ -15,6 +15,36 @@
  */
 
 #include "video.h"
+#include "objectregistry.h"
+#include <QMetaProperty>
+
+static ObjectRegistry<CTVideo> registry;
+
+CTVideoData::CTVideoData() :
+    downloadable(true),
+    subtitles(false),
+    viewCount(0)
+{
+}
+
+CTVideoData::CTVideoData(const CTVideo *video) :
+    date(video->date()),
+    description(video->description()),
+    downloadable(video->isDownloadable()),
+    duration(video->duration()),
+    id(video->id()),
+    largeThumbnailUrl(video->largeThumbnailUrl()),
+    service(video->service()),
+    streamUrl(video->streamUrl()),
+    subtitles(video->hasSubtitles()),
+    thumbnailUrl(video->thumbnailUrl()),
+    title(video->title()),
+    url(video->url()),
+    userId(video->userId()),
+    username(video->username()),
+    viewCount(video->viewCount())
+{
+}
 
 CTVideo::CTVideo(QObject *parent) :
     QObject(parent),
@@ -22,6 +52,7 @@ CTVideo::CTVideo(QObject *parent) :
     m_subtitles(false),
     m_viewCount(0)
 {
+    registry.insert(m_service, m_id, this);
 }
 
 CTVideo::CTVideo(const CTVideo *video, QObject *parent) :
@@ -42,6 +73,54 @@ CTVideo::CTVideo(const CTVideo *video, QObject *parent) :
     m_username(video->username()),
     m_viewCount(video->viewCount())
 {
+    registry.insert(m_service, m_id, this);
+}
+
+CTVideo::CTVideo(const CTVideoData &video, QObject *parent) :
+    QObject(parent),
+    m_date(video.date),
+    m_description(video.description),
+    m_downloadable(video.downloadable),
+    m_duration(video.duration),
+    m_id(video.id),
+    m_largeThumbnailUrl(video.largeThumbnailUrl),
+    m_service(video.service),
+    m_streamUrl(video.streamUrl),
+    m_subtitles(video.subtitles),
+    m_thumbnailUrl(video.thumbnailUrl),
+    m_title(video.title),
+    m_url(video.url),
+    m_userId(video.userId),
+    m_username(video.username),
+    m_viewCount(video.viewCount)
+{
+    registry.insert(m_service, m_id, this);
+}
+
+CTVideo::~CTVideo() {
+    registry.remove(m_service, m_id, this);
+}
+
+QList<CTVideo*> CTVideo::instances(const QString &service, const QString &id) {
+    return registry.objects(service, id);
+}
+
+void CTVideo::connectChangeSignals(QObject *receiver, const char *method) const {
+    // Connects the notify signal of every property, including those of subclasses
+    const QMetaObject *mo = metaObject();
+    
+    for (int i = 0; i < mo->propertyCount(); i++) {
+        const QMetaProperty property = mo->property(i);
+        
+        if (property.hasNotifySignal()) {
+#if QT_VERSION >= 0x050000
+            const QByteArray signal = "2" + property.notifySignal().methodSignature();
+#else
+            const QByteArray signal = QByteArray("2") + property.notifySignal().signature();
+#endif
+            connect(this, signal.constData(), receiver, method, Qt::UniqueConnection);
+        }
+    }
 }
 
 QString CTVideo::date() const {
@@ -94,7 +173,9 @@ QString CTVideo::id() const {
 
 void CTVideo::setId(const QString &i) {
     if (i != id()) {
+        registry.remove(m_service, m_id, this);
         m_id = i;
+        registry.insert(m_service, m_id, this);
         emit idChanged();
     }
 }
@@ -127,7 +208,9 @@ QString CTVideo::service() const {
 
 void CTVideo::setService(const QString &s) {
     if (s != service()) {
+        registry.remove(m_service, m_id, this);
         m_service = s;
+        registry.insert(m_service, m_id, this);
         emit serviceChanged();
     }
 }
@@ -213,6 +296,24 @@ void CTVideo::viewed() {
     setViewCount(viewCount() + 1);
 }
 
+void CTVideo::loadData(const CTVideoData &video) {
+    setDate(video.date);
+    setDescription(video.description);
+    setDownloadable(video.downloadable);
+    setDuration(video.duration);
+    setHasSubtitles(video.subtitles);
+    setId(video.id);
+    setLargeThumbnailUrl(video.largeThumbnailUrl);
+    setService(video.service);
+    setStreamUrl(video.streamUrl);
+    setThumbnailUrl(video.thumbnailUrl);
+    setTitle(video.title);
+    setUrl(video.url);
+    setUserId(video.userId);
+    setUsername(video.username);
+    setViewCount(video.viewCount);
+}
+
 void CTVideo::loadVideo(CTVideo *video) {
     setDate(video->date());
     setDescription(video->description());
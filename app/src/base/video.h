@@ -18,8 +18,34 @@
 #define VIDEO_H
 
 #include <QObject>
+#include <QSharedData>
 #include <QUrl>
 
+class CTVideo;
+
+class CTVideoData : public QSharedData
+{
+public:
+    CTVideoData();
+    explicit CTVideoData(const CTVideo *video);
+    
+    QString date;
+    QString description;
+    bool downloadable;
+    QString duration;
+    QString id;
+    QUrl largeThumbnailUrl;
+    QString service;
+    QUrl streamUrl;
+    bool subtitles;
+    QUrl thumbnailUrl;
+    QString title;
+    QUrl url;
+    QString userId;
+    QString username;
+    qint64 viewCount;
+};
+
 class CTVideo : public QObject
 {
     Q_OBJECT
@@ -43,6 +69,12 @@ class CTVideo : public QObject
 public:
     explicit CTVideo(QObject *parent = 0);
     explicit CTVideo(const CTVideo *video, QObject *parent = 0);
+    explicit CTVideo(const CTVideoData &video, QObject *parent = 0);
+    ~CTVideo();
+    
+    static QList<CTVideo*> instances(const QString &service, const QString &id);
+    
+    void connectChangeSignals(QObject *receiver, const char *method) const;
         
     QString date() const;
     
@@ -80,6 +112,8 @@ public Q_SLOTS:
     virtual void viewed();
     
 protected:
+    void loadData(const CTVideoData &video);
+    
     void setDate(const QString &d);
     
     void setDescription(const QString &d);
@@ -15,11 +15,16 @@
  */
 
 #include "dailymotion.h"
-#include "database.h"
+#include "accountstore.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
+#include "dailymotionplaylist.h"
+#include "dailymotionsubscriptionindex.h"
+#include "dailymotionuser.h"
+#include "dailymotionvideo.h"
 #include <qdailymotion/urls.h>
 #include <QSettings>
-#include <QSqlRecord>
 #if QT_VERSION >= 0x050000
 #include <QUrlQuery>
 #endif
@@ -59,13 +64,29 @@ const QStringList Dailymotion::VIDEO_FIELDS = QStringList() << "id" << "created_
                                                 
 const QRegExp Dailymotion::URL_REGEXP("(http(s|)://(www.|)dailymotion.com/|http://dai.ly/)\\w+", Qt::CaseInsensitive);
 
-Dailymotion::SubscriptionCache Dailymotion::subscriptionCache;
-
 Dailymotion* Dailymotion::self = 0;
 
 Dailymotion::Dailymotion() :
     QObject()
 {
+    // Cached responses may be out of date once the user changes account or modifies their content
+    connect(this, SIGNAL(userIdChanged(QString)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistCreated(DailymotionPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistDeleted(DailymotionPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userSubscribed(DailymotionUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userUnsubscribed(DailymotionUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoAddedToPlaylist(DailymotionVideo*,DailymotionPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*,DailymotionPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoFavourited(DailymotionVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoUnfavourited(DailymotionVideo*)), this, SLOT(clearResponseCache()));
+
+    // Changes are delivered only to the objects that represent the modified resource
+    connect(this, SIGNAL(userSubscribed(DailymotionUser*)), this, SLOT(updateUser(DailymotionUser*)));
+    connect(this, SIGNAL(userUnsubscribed(DailymotionUser*)), this, SLOT(updateUser(DailymotionUser*)));
+    connect(this, SIGNAL(videoAddedToPlaylist(DailymotionVideo*,DailymotionPlaylist*)), this, SLOT(updatePlaylist(DailymotionVideo*,DailymotionPlaylist*)));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*,DailymotionPlaylist*)), this, SLOT(updatePlaylist(DailymotionVideo*,DailymotionPlaylist*)));
+    connect(this, SIGNAL(videoFavourited(DailymotionVideo*)), this, SLOT(updateVideo(DailymotionVideo*)));
+    connect(this, SIGNAL(videoUnfavourited(DailymotionVideo*)), this, SLOT(updateVideo(DailymotionVideo*)));
 }
 
 Dailymotion::~Dailymotion() {
@@ -80,6 +101,9 @@ void Dailymotion::init() {
     if (accessToken().isEmpty()) {
         setUserId(QString());
     }
+    
+    // The stored subscriptions are read now, so that they are known before any user is shown
+    DailymotionSubscriptionIndex::instance()->setUserId(userId());
 }
 
 QString Dailymotion::getErrorString(const QVariantMap &error) {
@@ -132,9 +156,7 @@ void Dailymotion::setUserId(const QString &id) {
     
     if (id != userId()) {
         QSettings().setValue("Dailymotion/userId", id);
-        subscriptionCache.ids.clear();
-        subscriptionCache.filters.clear();
-        subscriptionCache.hasMore = true;
+        DailymotionSubscriptionIndex::instance()->setUserId(id);
 
         if (self) {
             emit self->userIdChanged(id);
@@ -143,67 +165,25 @@ void Dailymotion::setUserId(const QString &id) {
 }
 
 QString Dailymotion::accessToken() {
-    if (userId().isEmpty()) {
-        return QString();
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT accessToken FROM dailymotionAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("Dailymotion::accessToken(): database error: " + query.lastError().text());
-        return QString();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString();
-    }
-    
-    return QString();
+    return AccountStore::value("dailymotionAccounts", userId(), "accessToken").toString();
 }
 
 void Dailymotion::setAccessToken(const QString &token) {
     Logger::log("Dailymotion::setAccessToken(). Token: " + token, Logger::MediumVerbosity);
-    QSqlQuery query = getDatabase().exec(QString("UPDATE dailymotionAccounts SET accessToken = '%1' WHERE userId = '%2'")
-                                                .arg(token).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("Dailymotion::setAccessToken(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    
+    if ((AccountStore::setValue("dailymotionAccounts", userId(), "accessToken", token)) && (self)) {
         emit self->accessTokenChanged(token);
     }
 }
 
 QString Dailymotion::refreshToken() {
-    if (userId().isEmpty()) {
-        return QString();
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT refreshToken FROM dailymotionAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("Dailymotion::refreshToken(): database error: " + query.lastError().text());
-        return QString();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString();
-    }
-    
-    return QString();
+    return AccountStore::value("dailymotionAccounts", userId(), "refreshToken").toString();
 }
 
 void Dailymotion::setRefreshToken(const QString &token) {
     Logger::log("Dailymotion::setRefreshToken(). Token: " + token, Logger::MediumVerbosity);
-    QSqlQuery query = getDatabase().exec(QString("UPDATE dailymotionAccounts SET refreshToken = '%1' WHERE userId = '%2'")
-                                                .arg(token).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("Dailymotion::setRefreshToken(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    
+    if ((AccountStore::setValue("dailymotionAccounts", userId(), "refreshToken", token)) && (self)) {
         emit self->accessTokenChanged(token);
     }
 }
@@ -273,23 +253,7 @@ void Dailymotion::setScopes(const QStringList &s) {
 }
 
 bool Dailymotion::hasScope(const QString &scope) {    
-    if (userId().isEmpty()) {
-        return false;
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT scopes FROM dailymotionAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("Dailymotion::hasScope(): database error: " + query.lastError().text());
-        return false;
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString().contains(scope);
-    }
-    
-    return false;
+    return AccountStore::value("dailymotionAccounts", userId(), "scopes").toString().contains(scope);
 }
 
 QString Dailymotion::emailScope() {
@@ -331,3 +295,37 @@ QString Dailymotion::manageVideosScope() {
 QString Dailymotion::userInfoScope() {
     return QDailymotion::USER_INFO_SCOPE;
 }
+
+void Dailymotion::clearResponseCache() {
+    ResponseCache::invalidate(Resources::DAILYMOTION);
+}
+
+void Dailymotion::updatePlaylist(DailymotionVideo*, DailymotionPlaylist *playlist) {
+    foreach (CTPlaylist *object, CTPlaylist::instances(playlist->service(), playlist->id())) {
+        if (object != playlist) {
+            if (DailymotionPlaylist *p = qobject_cast<DailymotionPlaylist*>(object)) {
+                p->CTPlaylist::loadPlaylist(playlist);
+            }
+        }
+    }
+}
+
+void Dailymotion::updateUser(DailymotionUser *user) {
+    foreach (CTUser *object, CTUser::instances(user->service(), user->id())) {
+        if (object != user) {
+            if (DailymotionUser *u = qobject_cast<DailymotionUser*>(object)) {
+                u->loadUser(user);
+            }
+        }
+    }
+}
+
+void Dailymotion::updateVideo(DailymotionVideo *video) {
+    foreach (CTVideo *object, CTVideo::instances(video->service(), video->id())) {
+        if (object != video) {
+            if (DailymotionVideo *v = qobject_cast<DailymotionVideo*>(object)) {
+                v->loadVideo(video);
+            }
+        }
+    }
+}
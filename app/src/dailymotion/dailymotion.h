@@ -135,21 +135,15 @@ Q_SIGNALS:
     void videoFavourited(DailymotionVideo *video);
     void videoUnfavourited(DailymotionVideo *video);
 
+private Q_SLOTS:
+    void clearResponseCache();
+    void updatePlaylist(DailymotionVideo*, DailymotionPlaylist *playlist);
+    void updateUser(DailymotionUser *user);
+    void updateVideo(DailymotionVideo *video);
+    
 private:
     Dailymotion();
     
-    struct SubscriptionCache {
-        QStringList ids;
-        QVariantMap filters;
-        bool hasMore;
-
-        SubscriptionCache() :
-            hasMore(true)
-        {
-        }
-    };
-    
-    static SubscriptionCache subscriptionCache;
     static Dailymotion *self;
     
     static const QString CLIENT_ID;
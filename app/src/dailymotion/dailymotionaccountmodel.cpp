@@ -15,6 +15,7 @@
  */
 
 #include "dailymotionaccountmodel.h"
+#include "accountstore.h"
 #include "dailymotion.h"
 #include "logger.h"
 #include <QSqlRecord>
@@ -96,6 +97,7 @@ bool DailymotionAccountModel::addAccount(const QString &userId, const QString &u
     for (int i = 0; i < count; i++) {
         if (data(index(i, 0)) == userId) {
             if (setRecord(i, record)) {
+                AccountStore::invalidate("dailymotionAccounts");
                 Dailymotion::setUserId(userId);
                 return true;
             }
@@ -105,6 +107,7 @@ bool DailymotionAccountModel::addAccount(const QString &userId, const QString &u
     }
     
     if (insertRecord(-1, record)) {
+        AccountStore::invalidate("dailymotionAccounts");
         Dailymotion::setUserId(userId);
         const int count = rowCount();
         emit dataChanged(index(0, 0), index(count - 1, columnCount() - 1));
@@ -121,6 +124,8 @@ bool DailymotionAccountModel::removeAccount(int row) {
                 Logger::MediumVerbosity);
     
     if (removeRows(row, 1)) {
+        AccountStore::invalidate("dailymotionAccounts");
+        
         if (userId == Dailymotion::userId()) {
             if (rowCount() > 0) {
                 selectAccount(0);
@@ -21,6 +21,7 @@
 DailymotionCommentModel::DailymotionCommentModel(QObject *parent) :
     QAbstractListModel(parent),
     m_request(new QDailymotion::ResourcesRequest(this)),
+    m_prefetchRequest(new QDailymotion::ResourcesRequest(this)),
     m_hasMore(false)
 {
     m_roles[BodyRole] = "body";
@@ -43,13 +44,36 @@ DailymotionCommentModel::DailymotionCommentModel(QObject *parent) :
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
     connect(Dailymotion::instance(), SIGNAL(commentAdded(DailymotionComment*)),
             this, SLOT(onCommentAdded(DailymotionComment*)));
+    
+    m_prefetchRequest->setClientId(Dailymotion::clientId());
+    m_prefetchRequest->setClientSecret(Dailymotion::clientSecret());
+    m_prefetchRequest->setAccessToken(Dailymotion::accessToken());
+    m_prefetchRequest->setRefreshToken(Dailymotion::refreshToken());
+    
+    connect(m_prefetchRequest, SIGNAL(accessTokenChanged(QString)), Dailymotion::instance(), SLOT(setAccessToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(refreshTokenChanged(QString)), Dailymotion::instance(), SLOT(setRefreshToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(finished()), this, SLOT(onPrefetchRequestFinished()));
 }
 
 QString DailymotionCommentModel::errorString() const {
     return Dailymotion::getErrorString(m_request->result().toMap());
 }
 
+int DailymotionCommentModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void DailymotionCommentModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
+    }
+}
+
 QDailymotion::ResourcesRequest::Status DailymotionCommentModel::status() const {
+    if (m_prefetcher.isWanted()) {
+        return QDailymotion::ResourcesRequest::Loading;
+    }
+    
     return m_request->status();
 }
 
@@ -72,8 +96,19 @@ void DailymotionCommentModel::fetchMore(const QModelIndex &) {
         return;
     }
     
-    const int page = m_filters.value("page").toInt();
-    m_filters["page"] = (page > 0 ? page + 1 : 2);
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if (m_prefetchRequest->status() == QDailymotion::ResourcesRequest::Loading) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
+    m_filters["page"] = nextPage();
     m_request->list(m_resourcePath, m_filters, Dailymotion::COMMENT_FIELDS);
     emit statusChanged(status());
 }
@@ -143,6 +178,9 @@ void DailymotionCommentModel::list(const QString &resourcePath, const QVariantMa
 }
 
 void DailymotionCommentModel::clear() {
+    m_prefetcher.clear();
+    m_prefetchRequest->cancel();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -155,6 +193,12 @@ void DailymotionCommentModel::clear() {
 
 void DailymotionCommentModel::cancel() {
     m_request->cancel();
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        m_prefetchRequest->cancel();
+        emit statusChanged(status());
+    }
 }
 
 void DailymotionCommentModel::reload() {
@@ -193,22 +237,52 @@ void DailymotionCommentModel::remove(int row) {
     }
 }
 
+int DailymotionCommentModel::nextPage() const {
+    const int page = m_filters.value("page").toInt();
+    return page > 0 ? page + 1 : 2;
+}
+
+void DailymotionCommentModel::addComments(const QVariantMap &result) {
+    m_hasMore = result.value("has_more").toBool();
+    const QVariantList list = result.value("list").toList();
+    
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+    
+    foreach (const QVariant &item, list) {
+        m_items << new DailymotionComment(item.toMap(), this);
+    }
+    
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
+void DailymotionCommentModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((!m_hasMore) || (status() == QDailymotion::ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), nextPage()))) {
+        return;
+    }
+    
+    QVariantMap filters = m_filters;
+    filters["page"] = nextPage();
+    Logger::log("DailymotionCommentModel::setVisibleRange(). Prefetching page: " + QString::number(nextPage()),
+                Logger::HighVerbosity);
+    m_prefetchRequest->list(m_resourcePath, filters, Dailymotion::COMMENT_FIELDS);
+}
+
+void DailymotionCommentModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed
+    m_filters["page"] = m_prefetcher.page();
+    addComments(m_prefetcher.takeResult());
+    emit statusChanged(status());
+}
+
 void DailymotionCommentModel::onRequestFinished() {
     if (m_request->status() == QDailymotion::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_hasMore = result.value("has_more").toBool();
-            const QVariantList list = result.value("list").toList();
-
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-    
-            foreach (const QVariant &item, list) {
-                m_items << new DailymotionComment(item.toMap(), this);
-            }
-
-            endInsertRows();
-            emit countChanged(rowCount());
+            addComments(result);
         }
     }
     else {
@@ -218,6 +292,30 @@ void DailymotionCommentModel::onRequestFinished() {
     emit statusChanged(status());
 }
 
+void DailymotionCommentModel::onPrefetchRequestFinished() {
+    if (m_prefetchRequest->status() == QDailymotion::ResourcesRequest::Ready) {
+        const QVariantMap result = m_prefetchRequest->result().toMap();
+        
+        if (!result.isEmpty()) {
+            if (m_prefetcher.setResult(result)) {
+                addPrefetchResult();
+            }
+            
+            return;
+        }
+    }
+    else {
+        Logger::log("DailymotionCommentModel::onPrefetchRequestFinished(). Error: "
+                    + Dailymotion::getErrorString(m_prefetchRequest->result().toMap()));
+    }
+    
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
+}
+
 void DailymotionCommentModel::onCommentAdded(DailymotionComment *comment) {
     if (comment->videoId() == m_resourcePath.section('/', 1, 1)) {
         insert(0, new DailymotionComment(comment, this));
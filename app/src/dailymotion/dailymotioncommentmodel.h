@@ -18,6 +18,7 @@
 #define DAILYMOTIONCOMMENTMODEL_H
 
 #include "dailymotioncomment.h"
+#include "pageprefetcher.h"
 #include <QAbstractListModel>
 
 class DailymotionCommentModel : public QAbstractListModel
@@ -27,6 +28,8 @@ class DailymotionCommentModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QDailymotion::ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
 public:
@@ -44,6 +47,9 @@ public:
     
     QString errorString() const;
     
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
     QDailymotion::ResourcesRequest::Status status() const;
     
 #if QT_VERSION >= 0x050000
@@ -69,27 +75,39 @@ public Q_SLOTS:
     void cancel();
     void reload();
     
+    void setVisibleRange(int first, int last);
+    
 private:
     void append(DailymotionComment *comment);
     void insert(int row, DailymotionComment *comment);
     void remove(int row);
     
+    int nextPage() const;
+    void addComments(const QVariantMap &result);
+    
+    void addPrefetchResult();
+    
 private Q_SLOTS:
     void onRequestFinished();
+    void onPrefetchRequestFinished();
     
     void onCommentAdded(DailymotionComment *comment);
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void statusChanged(QDailymotion::ResourcesRequest::Status s);
     
 private:
     QDailymotion::ResourcesRequest *m_request;
+    QDailymotion::ResourcesRequest *m_prefetchRequest;
     
     QString m_resourcePath;
     QVariantMap m_filters;
     bool m_hasMore;
         
+    PagePrefetcher m_prefetcher;
+    
     QList<DailymotionComment*> m_items;
     
     QHash<int, QByteArray> m_roles;
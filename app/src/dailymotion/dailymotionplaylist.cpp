@@ -27,10 +27,6 @@ DailymotionPlaylist::DailymotionPlaylist(QObject *parent) :
     m_video(0)
 {
     setService(Resources::DAILYMOTION);
-    connect(Dailymotion::instance(), SIGNAL(videoAddedToPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
-    connect(Dailymotion::instance(), SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
 }
 
 DailymotionPlaylist::DailymotionPlaylist(const QString &id, QObject *parent) :
@@ -40,10 +36,6 @@ DailymotionPlaylist::DailymotionPlaylist(const QString &id, QObject *parent) :
 {
     setService(Resources::DAILYMOTION);
     loadPlaylist(id);
-    connect(Dailymotion::instance(), SIGNAL(videoAddedToPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
-    connect(Dailymotion::instance(), SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
 }
 
 DailymotionPlaylist::DailymotionPlaylist(const QVariantMap &playlist, QObject *parent) :
@@ -53,10 +45,6 @@ DailymotionPlaylist::DailymotionPlaylist(const QVariantMap &playlist, QObject *p
 {
     setService(Resources::DAILYMOTION);
     loadPlaylist(playlist);
-    connect(Dailymotion::instance(), SIGNAL(videoAddedToPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
-    connect(Dailymotion::instance(), SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
 }
 
 DailymotionPlaylist::DailymotionPlaylist(const DailymotionPlaylist *playlist, QObject *parent) :
@@ -64,10 +52,6 @@ DailymotionPlaylist::DailymotionPlaylist(const DailymotionPlaylist *playlist, QO
     m_request(0),
     m_video(0)
 {
-    connect(Dailymotion::instance(), SIGNAL(videoAddedToPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
-    connect(Dailymotion::instance(), SIGNAL(videoRemovedFromPlaylist(DailymotionVideo*, DailymotionPlaylist*)),
-            this, SLOT(onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*)));
 }
 
 QString DailymotionPlaylist::errorString() const {
@@ -236,9 +220,3 @@ void DailymotionPlaylist::onRemoveVideoRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onRemoveVideoRequestFinished()));
     emit statusChanged(status());
 }
-
-void DailymotionPlaylist::onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist *playlist) {
-    if ((playlist->id() == id()) && (playlist != this)) {
-        CTPlaylist::loadPlaylist(playlist);
-    }
-}
@@ -56,7 +56,6 @@ private Q_SLOTS:
     void onCreatePlaylistRequestFinished();
     void onAddVideoRequestFinished();
     void onRemoveVideoRequestFinished();
-    void onPlaylistUpdated(DailymotionVideo*, DailymotionPlaylist*);
     
 Q_SIGNALS:
     void statusChanged(QDailymotion::ResourcesRequest::Status s);
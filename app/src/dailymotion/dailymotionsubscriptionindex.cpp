@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dailymotionsubscriptionindex.h"
+#include "resources.h"
+#include "dailymotion.h"
+#include <qdailymotion/resourcesrequest.h>
+
+DailymotionSubscriptionIndex* DailymotionSubscriptionIndex::self = 0;
+
+DailymotionSubscriptionIndex::DailymotionSubscriptionIndex() :
+    SubscriptionIndex(Resources::DAILYMOTION),
+    m_request(0),
+    m_page(1)
+{
+    setUserId(Dailymotion::userId());
+}
+
+DailymotionSubscriptionIndex::~DailymotionSubscriptionIndex() {
+    self = 0;
+}
+
+DailymotionSubscriptionIndex* DailymotionSubscriptionIndex::instance() {
+    return self ? self : self = new DailymotionSubscriptionIndex;
+}
+
+void DailymotionSubscriptionIndex::fetchPage(const QVariant &cursor) {
+    if (!m_request) {
+        m_request = new QDailymotion::ResourcesRequest(this);
+        connect(m_request, SIGNAL(accessTokenChanged(QString)), Dailymotion::instance(), SLOT(setAccessToken(QString)));
+        connect(m_request, SIGNAL(refreshTokenChanged(QString)), Dailymotion::instance(), SLOT(setRefreshToken(QString)));
+        connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    }
+    
+    // The account may have changed since the last page
+    m_request->setClientId(Dailymotion::clientId());
+    m_request->setClientSecret(Dailymotion::clientSecret());
+    m_request->setAccessToken(Dailymotion::accessToken());
+    m_request->setRefreshToken(Dailymotion::refreshToken());
+    m_page = (cursor.isNull() ? 1 : cursor.toInt());
+    
+    QVariantMap filters;
+    filters["limit"] = 50;
+    filters["family_filter"] = false;
+    filters["page"] = m_page;
+    m_request->list("/me/following", filters, QStringList() << "id");
+}
+
+void DailymotionSubscriptionIndex::cancelPage() {
+    if (m_request) {
+        m_request->cancel();
+    }
+}
+
+void DailymotionSubscriptionIndex::onRequestFinished() {
+    const QVariantMap result = m_request->result().toMap();
+    
+    if (m_request->status() != QDailymotion::ResourcesRequest::Ready) {
+        pageFailed(Dailymotion::getErrorString(result));
+        return;
+    }
+    
+    QHash<QString, QString> ids;
+    
+    foreach (const QVariant &item, result.value("list").toList()) {
+        ids.insert(item.toMap().value("id").toString(), QString());
+    }
+    
+    addPage(ids, result.value("has_more").toBool() ? QVariant(m_page + 1) : QVariant());
+}
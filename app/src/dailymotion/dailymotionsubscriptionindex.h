@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DAILYMOTIONSUBSCRIPTIONINDEX_H
+#define DAILYMOTIONSUBSCRIPTIONINDEX_H
+
+#include "subscriptionindex.h"
+
+namespace QDailymotion {
+    class ResourcesRequest;
+}
+
+class DailymotionSubscriptionIndex : public SubscriptionIndex
+{
+    Q_OBJECT
+
+public:
+    ~DailymotionSubscriptionIndex();
+    
+    static DailymotionSubscriptionIndex* instance();
+
+protected:
+    virtual void fetchPage(const QVariant &cursor);
+    virtual void cancelPage();
+
+private Q_SLOTS:
+    void onRequestFinished();
+
+private:
+    DailymotionSubscriptionIndex();
+    
+    static DailymotionSubscriptionIndex *self;
+    
+    QDailymotion::ResourcesRequest *m_request;
+    
+    int m_page;
+};
+
+#endif // DAILYMOTIONSUBSCRIPTIONINDEX_H
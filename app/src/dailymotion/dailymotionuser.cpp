@@ -16,6 +16,7 @@
 
 #include "dailymotionuser.h"
 #include "dailymotion.h"
+#include "dailymotionsubscriptionindex.h"
 #include "logger.h"
 #include "resources.h"
 
@@ -27,10 +28,6 @@ DailymotionUser::DailymotionUser(QObject *parent) :
     m_viewCount(0)
 {
     setService(Resources::DAILYMOTION);
-    connect(Dailymotion::instance(), SIGNAL(userSubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
-    connect(Dailymotion::instance(), SIGNAL(userUnsubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
 }
 
 DailymotionUser::DailymotionUser(const QString &id, QObject *parent) :
@@ -42,10 +39,6 @@ DailymotionUser::DailymotionUser(const QString &id, QObject *parent) :
 {
     setService(Resources::DAILYMOTION);
     loadUser(id);
-    connect(Dailymotion::instance(), SIGNAL(userSubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
-    connect(Dailymotion::instance(), SIGNAL(userUnsubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
 }
 
 DailymotionUser::DailymotionUser(const QVariantMap &user, QObject *parent) :
@@ -57,10 +50,6 @@ DailymotionUser::DailymotionUser(const QVariantMap &user, QObject *parent) :
 {
     setService(Resources::DAILYMOTION);
     loadUser(user);
-    connect(Dailymotion::instance(), SIGNAL(userSubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
-    connect(Dailymotion::instance(), SIGNAL(userUnsubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
 }
 
 DailymotionUser::DailymotionUser(const DailymotionUser *user, QObject *parent) :
@@ -72,10 +61,6 @@ DailymotionUser::DailymotionUser(const DailymotionUser *user, QObject *parent) :
     m_subscriberCount(user->subscriberCount()),
     m_viewCount(user->viewCount())
 {
-    connect(Dailymotion::instance(), SIGNAL(userSubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
-    connect(Dailymotion::instance(), SIGNAL(userUnsubscribed(DailymotionUser*)),
-            this, SLOT(onUserUpdated(DailymotionUser*)));
 }
 
 QUrl DailymotionUser::bannerUrl() const {
@@ -174,27 +159,18 @@ void DailymotionUser::loadUser(DailymotionUser *user) {
 }
 
 void DailymotionUser::checkIfSubscribed() {
-    if (Dailymotion::subscriptionCache.ids.contains(id())) {
-        setSubscribed(true);
-        return;
-    }
-    
-    if (status() == QDailymotion::ResourcesRequest::Loading) {
-        return;
-    }
+    DailymotionSubscriptionIndex *index = DailymotionSubscriptionIndex::instance();
     
-    if (!Dailymotion::subscriptionCache.hasMore) {
-        setSubscribed(false);
+    if ((index->isLoaded()) || (index->contains(id()))) {
+        setSubscribed(index->contains(id()));
         return;
     }
     
-    Logger::log("DailymotionUser::checkIfSubscribed(). ID: " + id(), Logger::MediumVerbosity);
-    initRequest();
-    Dailymotion::subscriptionCache.filters["limit"] = 50;
-    Dailymotion::subscriptionCache.filters["family_filter"] = false;
-    m_request->list("/me/following", Dailymotion::subscriptionCache.filters, QStringList() << "id");
-    connect(m_request, SIGNAL(finished()), this, SLOT(onSubscribeCheckRequestFinished()));
-    emit statusChanged(status());
+    // The account's subscriptions have not been indexed yet, so the result is set once they are
+    Logger::log("DailymotionUser::checkIfSubscribed(). Waiting for subscriptions. ID: " + id(),
+                Logger::MediumVerbosity);
+    connect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()), Qt::UniqueConnection);
+    index->sync();
 }
 
 void DailymotionUser::subscribe() {
@@ -243,36 +219,11 @@ void DailymotionUser::onUserRequestFinished() {
     emit statusChanged(status());
 }
 
-void DailymotionUser::onSubscribeCheckRequestFinished() {
-    if (m_request->status() == QDailymotion::ResourcesRequest::Ready) {
-        const QVariantMap result = m_request->result().toMap();
-        const QVariantList list = result.value("list").toList();
-        Dailymotion::subscriptionCache.hasMore = result.value("has_more").toBool();
-        
-        const int page = Dailymotion::subscriptionCache.filters.value("page").toInt();
-        Dailymotion::subscriptionCache.filters["page"] = (page > 0 ? page + 1 : 2);
-        
-        foreach (const QVariant &item, list) {
-            const QVariantMap map = item.toMap();
-            Dailymotion::subscriptionCache.ids.append(map.value("id").toString());
-        }
-        
-        disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-        emit statusChanged(status());
-        checkIfSubscribed();
-        return;
-    }
-    
-    Logger::log("DailymotionUser::onSubcribeCheckRequestFinished(). Error: " + errorString());
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-    emit statusChanged(status());
-}
-
 void DailymotionUser::onSubscribeRequestFinished() {
     if (m_request->status() == QDailymotion::ResourcesRequest::Ready) {
         setSubscribed(true);
         setSubscriberCount(subscriberCount() + 1);
-        Dailymotion::subscriptionCache.ids.append(id());
+        DailymotionSubscriptionIndex::instance()->insert(id());
         Logger::log("DailymotionUser::onSubscribeRequestFinished(). Subscription added. ID: " + id(),
                     Logger::MediumVerbosity);
         emit Dailymotion::instance()->userSubscribed(this);
@@ -289,7 +240,7 @@ void DailymotionUser::onUnsubscribeRequestFinished() {
     if (m_request->status() == QDailymotion::ResourcesRequest::Ready) {
         setSubscribed(false);
         setSubscriberCount(subscriberCount() - 1);
-        Dailymotion::subscriptionCache.ids.removeOne(id());
+        DailymotionSubscriptionIndex::instance()->remove(id());
         Logger::log("DailymotionUser::onUnsubscribeRequestFinished(). Subscription removed. ID: " + id(),
                     Logger::MediumVerbosity);
         emit Dailymotion::instance()->userUnsubscribed(this);
@@ -302,8 +253,12 @@ void DailymotionUser::onUnsubscribeRequestFinished() {
     emit statusChanged(status());
 }
 
-void DailymotionUser::onUserUpdated(DailymotionUser *user) {
-    if ((user->id() == id()) && (user != this)) {
-        loadUser(user);
+void DailymotionUser::onSubscriptionsSynced() {
+    DailymotionSubscriptionIndex *index = DailymotionSubscriptionIndex::instance();
+    disconnect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()));
+    
+    // A failed sync leaves the subscription state as it is
+    if (index->isLoaded()) {
+        setSubscribed(index->contains(id()));
     }
 }
@@ -76,10 +76,9 @@ private:
         
 private Q_SLOTS:
     void onUserRequestFinished();
-    void onSubscribeCheckRequestFinished();
     void onSubscribeRequestFinished();
     void onUnsubscribeRequestFinished();
-    void onUserUpdated(DailymotionUser *user);
+    void onSubscriptionsSynced();
     
 Q_SIGNALS:
     void bannerUrlChanged();
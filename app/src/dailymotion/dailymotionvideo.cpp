@@ -21,6 +21,39 @@
 #include "utils.h"
 #include <QDateTime>
 
+DailymotionVideoData::DailymotionVideoData() :
+    CTVideoData(),
+    favourite(false)
+{
+    service = Resources::DAILYMOTION;
+    subtitles = true;
+}
+
+DailymotionVideoData::DailymotionVideoData(const QVariantMap &video) :
+    CTVideoData(),
+    favourite(video.value("favorited_at").toLongLong() > 0)
+{
+    service = Resources::DAILYMOTION;
+    subtitles = true;
+    date = QDateTime::fromTime_t(video.value("created_time").toLongLong()).toString("dd MMM yyyy");
+    description = video.value("description").toString();
+    duration = Utils::formatSecs(video.value("duration").toLongLong());
+    id = video.value("id").toString();
+    largeThumbnailUrl = video.value("thumbnail_360_url").toString();
+    url = video.value("url").toString();
+    userId = video.value("owner.id").toString();
+    username = video.value("owner.screenname").toString();
+    thumbnailUrl = video.value("thumbnail_120_url").toString();
+    title = video.value("title").toString();
+    viewCount = video.value("views_total").toLongLong();
+}
+
+DailymotionVideoData::DailymotionVideoData(const DailymotionVideo *video) :
+    CTVideoData(video),
+    favourite(video->isFavourite())
+{
+}
+
 DailymotionVideo::DailymotionVideo(QObject *parent) :
     CTVideo(parent),
     m_request(0),
@@ -28,10 +61,6 @@ DailymotionVideo::DailymotionVideo(QObject *parent) :
 {
     setHasSubtitles(true);
     setService(Resources::DAILYMOTION);
-    connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
-    connect(Dailymotion::instance(), SIGNAL(videoUnfavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
 }
 
 DailymotionVideo::DailymotionVideo(const QString &id, QObject *parent) :
@@ -42,10 +71,6 @@ DailymotionVideo::DailymotionVideo(const QString &id, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::DAILYMOTION);
     loadVideo(id);
-    connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
-    connect(Dailymotion::instance(), SIGNAL(videoUnfavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
 }
 
 DailymotionVideo::DailymotionVideo(const QVariantMap &video, QObject *parent) :
@@ -56,10 +81,6 @@ DailymotionVideo::DailymotionVideo(const QVariantMap &video, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::DAILYMOTION);
     loadVideo(video);
-    connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
-    connect(Dailymotion::instance(), SIGNAL(videoUnfavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
 }
 
 DailymotionVideo::DailymotionVideo(const DailymotionVideo *video, QObject *parent) :
@@ -67,10 +88,13 @@ DailymotionVideo::DailymotionVideo(const DailymotionVideo *video, QObject *paren
     m_request(0),
     m_favourite(video->isFavourite())
 {
-    connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
-    connect(Dailymotion::instance(), SIGNAL(videoUnfavourited(DailymotionVideo*)),
-            this, SLOT(onVideoUpdated(DailymotionVideo*)));
+}
+
+DailymotionVideo::DailymotionVideo(const DailymotionVideoData &video, QObject *parent) :
+    CTVideo(video, parent),
+    m_request(0),
+    m_favourite(video.favourite)
+{
 }
 
 QString DailymotionVideo::errorString() const {
@@ -108,18 +132,12 @@ void DailymotionVideo::loadVideo(const QString &id) {
 }
 
 void DailymotionVideo::loadVideo(const QVariantMap &video) {
-    setDate(QDateTime::fromTime_t(video.value("created_time").toLongLong()).toString("dd MMM yyyy"));
-    setDescription(video.value("description").toString());
-    setDuration(Utils::formatSecs(video.value("duration").toLongLong()));
-    setFavourite(video.value("favorited_at").toLongLong() > 0);
-    setId(video.value("id").toString());
-    setLargeThumbnailUrl(video.value("thumbnail_360_url").toString());
-    setUrl(video.value("url").toString());
-    setUserId(video.value("owner.id").toString());
-    setUsername(video.value("owner.screenname").toString());
-    setThumbnailUrl(video.value("thumbnail_120_url").toString());
-    setTitle(video.value("title").toString());
-    setViewCount(video.value("views_total").toLongLong());
+    loadData(DailymotionVideoData(video));
+}
+
+void DailymotionVideo::loadData(const DailymotionVideoData &video) {
+    CTVideo::loadData(video);
+    setFavourite(video.favourite);
 }
 
 void DailymotionVideo::loadVideo(DailymotionVideo *video) {
@@ -202,9 +220,3 @@ void DailymotionVideo::onUnfavouriteRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onUnfavouriteRequestFinished()));
     emit statusChanged(status());
 }
-
-void DailymotionVideo::onVideoUpdated(DailymotionVideo *video) {
-    if ((video->id() == id()) && (video != this)) {
-        loadVideo(video);
-    }
-}
@@ -20,6 +20,18 @@
 #include "video.h"
 #include <qdailymotion/resourcesrequest.h>
 
+class DailymotionVideo;
+
+class DailymotionVideoData : public CTVideoData
+{
+public:
+    DailymotionVideoData();
+    explicit DailymotionVideoData(const QVariantMap &video);
+    explicit DailymotionVideoData(const DailymotionVideo *video);
+    
+    bool favourite;
+};
+
 class DailymotionVideo : public CTVideo
 {
     Q_OBJECT
@@ -33,6 +45,7 @@ public:
     explicit DailymotionVideo(const QString &id, QObject *parent = 0);
     explicit DailymotionVideo(const QVariantMap &video, QObject *parent = 0);
     explicit DailymotionVideo(const DailymotionVideo *video, QObject *parent = 0);
+    explicit DailymotionVideo(const DailymotionVideoData &video, QObject *parent = 0);
     
     QString errorString() const;
     
@@ -51,13 +64,14 @@ public Q_SLOTS:
 private:
     void initRequest();
     
+    void loadData(const DailymotionVideoData &video);
+    
     void setFavourite(bool f);
         
 private Q_SLOTS:
     void onVideoRequestFinished();
     void onFavouriteRequestFinished();
     void onUnfavouriteRequestFinished();
-    void onVideoUpdated(DailymotionVideo *video);
     
 Q_SIGNALS:
     void favouriteChanged();
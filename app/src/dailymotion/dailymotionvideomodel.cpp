@@ -18,11 +18,15 @@
 #include "dailymotion.h"
 #include "dailymotionplaylist.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
 
 DailymotionVideoModel::DailymotionVideoModel(QObject *parent) :
     QAbstractListModel(parent),
     m_request(new QDailymotion::ResourcesRequest(this)),
-    m_hasMore(false)
+    m_hasMore(false),
+    m_cached(false),
+    m_revalidating(false)
 {
     m_roles[DateRole] = "date";
     m_roles[DescriptionRole] = "description";
@@ -57,7 +61,7 @@ QString DailymotionVideoModel::errorString() const {
 }
 
 QDailymotion::ResourcesRequest::Status DailymotionVideoModel::status() const {
-    return m_request->status();
+    return m_cached ? QDailymotion::ResourcesRequest::Ready : m_request->status();
 }
 
 #if QT_VERSION >=0x050000
@@ -81,13 +85,59 @@ void DailymotionVideoModel::fetchMore(const QModelIndex &) {
     
     const int page = m_filters.value("page").toInt();
     m_filters["page"] = (page > 0 ? page + 1 : 2);
-    m_request->list(m_resourcePath, m_filters, Dailymotion::VIDEO_FIELDS);
+    const QVariantMap result = ResponseCache::result(cacheKey()).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos();
+    }
+    else {
+        m_cached = true;
+        addVideos(result);
+    }
+    
     emit statusChanged(status());
 }
 
+QVariant DailymotionVideoModel::roleData(const DailymotionVideoData *video, int role) {
+    switch (role) {
+    case DateRole:
+        return video->date;
+    case DescriptionRole:
+        return video->description;
+    case DownloadableRole:
+        return video->downloadable;
+    case DurationRole:
+        return video->duration;
+    case FavouriteRole:
+        return video->favourite;
+    case IdRole:
+        return video->id;
+    case LargeThumbnailUrlRole:
+        return video->largeThumbnailUrl;
+    case StreamUrlRole:
+        return video->streamUrl;
+    case SubtitlesRole:
+        return video->subtitles;
+    case ThumbnailUrlRole:
+        return video->thumbnailUrl;
+    case TitleRole:
+        return video->title;
+    case UrlRole:
+        return video->url;
+    case UserIdRole:
+        return video->userId;
+    case UsernameRole:
+        return video->username;
+    case ViewCountRole:
+        return video->viewCount;
+    default:
+        return QVariant();
+    }
+}
+
 QVariant DailymotionVideoModel::data(const QModelIndex &index, int role) const {
-    if (DailymotionVideo *video = get(index.row())) {
-        return video->property(m_roles[role]);
+    if (const DailymotionVideoData *video = videoData(index.row())) {
+        return roleData(video, role);
     }
     
     return QVariant();
@@ -96,12 +146,12 @@ QVariant DailymotionVideoModel::data(const QModelIndex &index, int role) const {
 QMap<int, QVariant> DailymotionVideoModel::itemData(const QModelIndex &index) const {
     QMap<int, QVariant> map;
     
-    if (const DailymotionVideo *video = get(index.row())) {
+    if (const DailymotionVideoData *video = videoData(index.row())) {
         QHashIterator<int, QByteArray> iterator(m_roles);
         
         while (iterator.hasNext()) {
             iterator.next();
-            map[iterator.key()] = video->property(iterator.value());
+            map[iterator.key()] = roleData(video, iterator.key());
         }
     }
     
@@ -109,8 +159,8 @@ QMap<int, QVariant> DailymotionVideoModel::itemData(const QModelIndex &index) co
 }
 
 QVariant DailymotionVideoModel::data(int row, const QByteArray &role) const {
-    if (const DailymotionVideo *video = get(row)) {
-        return video->property(role);
+    if (const DailymotionVideoData *video = videoData(row)) {
+        return roleData(video, m_roles.key(role));
     }
     
     return QVariant();
@@ -119,9 +169,12 @@ QVariant DailymotionVideoModel::data(int row, const QByteArray &role) const {
 QVariantMap DailymotionVideoModel::itemData(int row) const {
     QVariantMap map;
     
-    if (const DailymotionVideo *video = get(row)) {
-        foreach (const QByteArray &role, m_roles.values()) {
-            map[role] = video->property(role);
+    if (const DailymotionVideoData *video = videoData(row)) {
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.value()] = roleData(video, iterator.key());
         }
     }
     
@@ -130,7 +183,22 @@ QVariantMap DailymotionVideoModel::itemData(int row) const {
 
 DailymotionVideo* DailymotionVideoModel::get(int row) const {
     if ((row >= 0) && (row < m_items.size())) {
-        return m_items.at(row);
+        // Rows are stored as values, so the QObject is only created when a page or QML asks for it
+        if (!m_videos.at(row)) {
+            m_videos[row] = new DailymotionVideo(*m_items.at(row), const_cast<DailymotionVideoModel*>(this));
+            // Keep the row in step with any change to the object, such as a reload of its details
+            m_videos.at(row)->connectChangeSignals(const_cast<DailymotionVideoModel*>(this), SLOT(onVideoChanged()));
+        }
+        
+        return m_videos.at(row);
+    }
+    
+    return 0;
+}
+
+const DailymotionVideoData* DailymotionVideoModel::videoData(int row) const {
+    if ((row >= 0) && (row < m_items.size())) {
+        return m_items.at(row).constData();
     }
     
     return 0;
@@ -145,10 +213,30 @@ void DailymotionVideoModel::list(const QString &resourcePath, const QVariantMap
     clear();
     m_resourcePath = resourcePath;
     m_filters = filters;
-    m_request->list(resourcePath, filters, Dailymotion::VIDEO_FIELDS);
+    bool stale = false;
+    const QVariantMap result = ResponseCache::result(cacheKey(), &stale).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos();
+    }
+    else {
+        // Show the cached videos immediately, and replace them if they need to be revalidated
+        addVideos(result);
+        
+        if (stale) {
+            m_revalidating = true;
+            getVideos();
+        }
+        else {
+            m_cached = true;
+        }
+    }
+    
     emit statusChanged(status());
     
     disconnect(Dailymotion::instance(), 0, this, 0);
+    connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)), this, SLOT(onVideoUpdated(DailymotionVideo*)));
+    connect(Dailymotion::instance(), SIGNAL(videoUnfavourited(DailymotionVideo*)), this, SLOT(onVideoUpdated(DailymotionVideo*)));
         
     if (resourcePath == "/me/favorites") {
         connect(Dailymotion::instance(), SIGNAL(videoFavourited(DailymotionVideo*)),
@@ -167,8 +255,9 @@ void DailymotionVideoModel::list(const QString &resourcePath, const QVariantMap
 void DailymotionVideoModel::clear() {
     if (!m_items.isEmpty()) {
         beginResetModel();
-        qDeleteAll(m_items);
+        qDeleteAll(m_videos);
         m_items.clear();
+        m_videos.clear();
         m_hasMore = false;
         endResetModel();
         emit countChanged(rowCount());
@@ -186,20 +275,31 @@ void DailymotionVideoModel::reload() {
     
     Logger::log("DailymotionVideoModel::reload(). Resource path: " + m_resourcePath, Logger::HighVerbosity);
     clear();
-    m_request->list(m_resourcePath, m_filters, Dailymotion::VIDEO_FIELDS);
+    getVideos();
     emit statusChanged(status());
 }
 
-void DailymotionVideoModel::append(DailymotionVideo *video) {
+QString DailymotionVideoModel::cacheKey() const {
+    return ResponseCache::key(Resources::DAILYMOTION, m_resourcePath, m_filters);
+}
+
+void DailymotionVideoModel::getVideos() {
+    m_cached = false;
+    m_request->list(m_resourcePath, m_filters, Dailymotion::VIDEO_FIELDS);
+}
+
+void DailymotionVideoModel::append(DailymotionVideoData *video) {
     beginInsertRows(QModelIndex(), m_items.size(), m_items.size());
-    m_items << video;
+    m_items << QSharedDataPointer<DailymotionVideoData>(video);
+    m_videos << 0;
     endInsertRows();
 }
 
-void DailymotionVideoModel::insert(int row, DailymotionVideo *video) {
+void DailymotionVideoModel::insert(int row, DailymotionVideoData *video) {
     if ((row >= 0) && (row < m_items.size())) {
         beginInsertRows(QModelIndex(), row, row);
-        m_items.insert(row, video);
+        m_items.insert(row, QSharedDataPointer<DailymotionVideoData>(video));
+        m_videos.insert(row, 0);
         endInsertRows();
     }
     else {
@@ -210,39 +310,57 @@ void DailymotionVideoModel::insert(int row, DailymotionVideo *video) {
 void DailymotionVideoModel::remove(int row) {
     if ((row >= 0) && (row < m_items.size())) {
         beginRemoveRows(QModelIndex(), row, row);
-        m_items.takeAt(row)->deleteLater();
+        m_items.removeAt(row);
+        
+        if (DailymotionVideo *video = m_videos.takeAt(row)) {
+            video->deleteLater();
+        }
+        
         endRemoveRows();
     }
 }
 
+void DailymotionVideoModel::addVideos(const QVariantMap &result) {
+    m_hasMore = result.value("has_more").toBool();
+    const QVariantList list = result.value("list").toList();
+
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+
+    foreach (const QVariant &item, list) {
+        m_items << QSharedDataPointer<DailymotionVideoData>(new DailymotionVideoData(item.toMap()));
+        m_videos << 0;
+    }
+
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
 void DailymotionVideoModel::onRequestFinished() {
     if (m_request->status() == QDailymotion::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_hasMore = result.value("has_more").toBool();
-            const QVariantList list = result.value("list").toList();
-
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-    
-            foreach (const QVariant &item, list) {
-                m_items << new DailymotionVideo(item.toMap(), this);
+            ResponseCache::insert(cacheKey(), Resources::DAILYMOTION, ResponseCache::resourceType(m_resourcePath),
+                                  result);
+            
+            if (m_revalidating) {
+                clear();
             }
-
-            endInsertRows();
-            emit countChanged(rowCount());
+            
+            addVideos(result);
         }
     }
     else {
         Logger::log("DailymotionVideoModel::onRequestFinished(). Error: " + errorString());
     }
     
+    m_revalidating = false;
     emit statusChanged(status());
 }
 
 void DailymotionVideoModel::onVideoAddedToPlaylist(DailymotionVideo *video, DailymotionPlaylist *playlist) {
     if (m_resourcePath.section('/', -2, -2) == playlist->id()) {
-        insert(0, new DailymotionVideo(video, this));
+        insert(0, new DailymotionVideoData(video));
     }
 }
 
@@ -257,7 +375,7 @@ void DailymotionVideoModel::onVideoRemovedFromPlaylist(DailymotionVideo *video,
 }
 
 void DailymotionVideoModel::onVideoFavourited(DailymotionVideo *video) {
-    insert(0, new DailymotionVideo(video, this));
+    insert(0, new DailymotionVideoData(video));
 }
 
 void DailymotionVideoModel::onVideoUnfavourited(DailymotionVideo *video) {
@@ -267,3 +385,23 @@ void DailymotionVideoModel::onVideoUnfavourited(DailymotionVideo *video) {
         remove(list.first().row());
     }
 }
+
+void DailymotionVideoModel::onVideoUpdated(DailymotionVideo *video) {
+    for (int i = 0; i < m_items.size(); i++) {
+        if (m_items.at(i)->id == video->id()) {
+            m_items[i] = QSharedDataPointer<DailymotionVideoData>(new DailymotionVideoData(video));
+            const QModelIndex idx = index(i);
+            emit dataChanged(idx, idx);
+        }
+    }
+}
+
+void DailymotionVideoModel::onVideoChanged() {
+    const int i = m_videos.indexOf(qobject_cast<DailymotionVideo*>(sender()));
+    
+    if (i >= 0) {
+        m_items[i] = QSharedDataPointer<DailymotionVideoData>(new DailymotionVideoData(m_videos.at(i)));
+        const QModelIndex idx = index(i);
+        emit dataChanged(idx, idx);
+    }
+}
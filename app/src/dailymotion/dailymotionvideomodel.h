@@ -80,8 +80,17 @@ public Q_SLOTS:
     void reload();
     
 private:
-    void append(DailymotionVideo *video);
-    void insert(int row, DailymotionVideo *video);
+    static QVariant roleData(const DailymotionVideoData *video, int role);
+    
+    const DailymotionVideoData* videoData(int row) const;
+    
+    QString cacheKey() const;
+    
+    void getVideos();
+    void addVideos(const QVariantMap &result);
+    
+    void append(DailymotionVideoData *video);
+    void insert(int row, DailymotionVideoData *video);
     void remove(int row);
     
 private Q_SLOTS:
@@ -90,6 +99,8 @@ private Q_SLOTS:
     void onVideoRemovedFromPlaylist(DailymotionVideo *video, DailymotionPlaylist *playlist);
     void onVideoFavourited(DailymotionVideo *video);
     void onVideoUnfavourited(DailymotionVideo *video);
+    void onVideoUpdated(DailymotionVideo *video);
+    void onVideoChanged();
     
 Q_SIGNALS:
     void countChanged(int count);
@@ -101,8 +112,12 @@ private:
     QString m_resourcePath;
     QVariantMap m_filters;
     bool m_hasMore;
+    
+    bool m_cached;
+    bool m_revalidating;
         
-    QList<DailymotionVideo*> m_items;
+    QList< QSharedDataPointer<DailymotionVideoData> > m_items;
+    mutable QList<DailymotionVideo*> m_videos;
     
     QHash<int, QByteArray> m_roles;
 };
@@ -17,6 +17,7 @@
 #include "dbusservice.h"
 #include "logger.h"
 #include "resources.h"
+#include "transfers.h"
 #include <QDBusConnection>
 #include <QStringList>
 
@@ -46,9 +47,17 @@ bool DBusService::showResource(const QString &url) {
 }
 
 bool DBusService::showResource(const QStringList &url) {
-    if (!url.isEmpty()) {
+    switch (url.size()) {
+    case 0:
+        return false;
+    case 1:
         return showResource(url.first());
+    default:
+        return addDownloads(url) > 0;
     }
+}
 
-    return false;
+int DBusService::addDownloads(const QStringList &urls) {
+    Logger::log(QString("DBusService::addDownloads(). %1 URLs").arg(urls.size()), Logger::MediumVerbosity);
+    return Transfers::instance()->addDownloadTransfers(urls);
 }
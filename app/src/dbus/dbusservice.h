@@ -37,6 +37,8 @@ public Q_SLOTS:
     Q_SCRIPTABLE bool showResource(const QString &url);
     Q_SCRIPTABLE bool showResource(const QStringList &url);
     
+    Q_SCRIPTABLE int addDownloads(const QStringList &urls);
+    
 Q_SIGNALS:
     void resourceRequested(const QVariantMap &resource);
     
@@ -42,6 +42,7 @@ DailymotionVideosPage::DailymotionVideosPage(QWidget *parent) :
 {
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, DailymotionVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_layout->addWidget(m_view);
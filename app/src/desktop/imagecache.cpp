@@ -16,8 +16,11 @@
 
 #include "imagecache.h"
 #include "definitions.h"
+#include <QAbstractItemView>
+#include <QMutexLocker>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QScrollBar>
 #include <QThread>
 
 class CachedImage
@@ -29,22 +32,36 @@ public:
     {
     }
     
+    ~CachedImage() {
+        if (!image.isNull()) {
+            ImageCache::evictions++;
+        }
+    }
+    
     const QUrl url;
     QImage image;    
 };
 
 QThread* ImageCache::thread = 0;
+QMutex ImageCache::mutex;
 QQueue<QUrl> ImageCache::queue;
-QCache<QUrl, CachedImage> ImageCache::cache;
+QHash<QUrl, ImageRequest*> ImageCache::requests;
+QCache<QUrl, CachedImage> ImageCache::cache(IMAGE_CACHE_SIZE);
+QSet<QUrl> ImageCache::oversized;
 
 int ImageCache::requestCount = 0;
 int ImageCache::refCount = 0;
 
+int ImageCache::hits = 0;
+int ImageCache::misses = 0;
+int ImageCache::evictions = 0;
+
 const int ImageCache::MAX_REQUESTS = 8;
 
 ImageCache::ImageCache() :
     QObject(),
-    m_manager(new QNetworkAccessManager)
+    m_manager(new QNetworkAccessManager),
+    m_urlRole(-1)
 {
     refCount++;
     
@@ -57,6 +74,21 @@ ImageCache::ImageCache() :
 }
 
 ImageCache::~ImageCache() {
+    QMutexLocker locker(&mutex);
+    QMutableHashIterator<QUrl, ImageRequest*> iterator(requests);
+    
+    while (iterator.hasNext()) {
+        ImageRequest *request = iterator.next().value();
+        
+        if (request->reply->manager() == m_manager) {
+            iterator.remove();
+            cache.remove(request->url);
+            delete request;
+            requestCount--;
+        }
+    }
+    
+    locker.unlock();
     delete m_manager;
     m_manager = 0;
     refCount--;
@@ -70,12 +102,22 @@ ImageCache::~ImageCache() {
 
 QImage ImageCache::image(const QUrl &url, const QSize &size, Qt::AspectRatioMode aspectRatioMode,
                          Qt::TransformationMode transformationMode) {
+    QMutexLocker locker(&mutex);
+    
     if (CachedImage *ci = cache.object(url)) {
+        hits++;
+        const QImage image = ci->image;
+        locker.unlock();
         return (!size.isEmpty())
-               && (!ci->image.isNull()) ? ci->image.scaled(size, aspectRatioMode, transformationMode)
-                                        : ci->image;
+               && (!image.isNull()) ? image.scaled(size, aspectRatioMode, transformationMode) : image;
+    }
+    
+    // Images that do not fit in the cache are not requested again, since they could never be shown
+    if (oversized.contains(url)) {
+        return QImage();
     }
     
+    misses++;
     cache.insert(url, new CachedImage(url));
     
     if (requestCount < MAX_REQUESTS) {
@@ -88,26 +130,245 @@ QImage ImageCache::image(const QUrl &url, const QSize &size, Qt::AspectRatioMode
     return QImage();
 }
 
+QAbstractItemView* ImageCache::view() const {
+    return m_view;
+}
+
+void ImageCache::setView(QAbstractItemView *view, int urlRole) {
+    if (m_view) {
+        disconnect(m_view->verticalScrollBar(), 0, this, 0);
+        
+        if (m_view->model()) {
+            disconnect(m_view->model(), 0, this, 0);
+        }
+    }
+    
+    m_view = view;
+    m_urlRole = urlRole;
+    m_nearUrls.clear();
+    
+    if (!view) {
+        return;
+    }
+    
+    // The view can only be queried in the GUI thread, so use direct connections
+    connect(view->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateVisibleRange()),
+            Qt::DirectConnection);
+    
+    if (QAbstractItemModel *model = view->model()) {
+        connect(model, SIGNAL(modelReset()), this, SLOT(updateVisibleRange()), Qt::DirectConnection);
+        connect(model, SIGNAL(rowsInserted(QModelIndex, int, int)), this, SLOT(updateVisibleRange()),
+                Qt::DirectConnection);
+        connect(model, SIGNAL(rowsRemoved(QModelIndex, int, int)), this, SLOT(updateVisibleRange()),
+                Qt::DirectConnection);
+    }
+}
+
+void ImageCache::setVisibleRange(int first, int last) {
+    QList<QUrl> visibleUrls;
+    QList<QUrl> nearUrls;
+    QSet<QUrl> keepUrls;
+    
+    if ((first >= 0) && (last >= first)) {
+        const int count = last - first + 1;
+        
+        for (int row = first; row <= last; row++) {
+            const QUrl url = urlForRow(row);
+            
+            if (!url.isEmpty()) {
+                visibleUrls << url;
+                keepUrls << url;
+            }
+        }
+        
+        // Prefetch the next page first, since the view is most likely to be scrolled forward
+        for (int row = last + 1; row <= last + count; row++) {
+            const QUrl url = urlForRow(row);
+            
+            if (!url.isEmpty()) {
+                nearUrls << url;
+                keepUrls << url;
+            }
+        }
+        
+        for (int row = first - 1; row >= qMax(0, first - count); row--) {
+            const QUrl url = urlForRow(row);
+            
+            if (!url.isEmpty()) {
+                nearUrls << url;
+                keepUrls << url;
+            }
+        }
+    }
+    
+    QMutexLocker locker(&mutex);
+    
+    foreach (const QUrl &url, m_nearUrls) {
+        if (!keepUrls.contains(url)) {
+            abortImage(url);
+        }
+    }
+    
+    m_nearUrls = keepUrls;
+    
+    // Move the nearby and then the visible images to the front of the queue, so that visible images are fetched first
+    for (int i = nearUrls.size() - 1; i >= 0; i--) {
+        prioritizeImage(nearUrls.at(i));
+    }
+    
+    for (int i = visibleUrls.size() - 1; i >= 0; i--) {
+        prioritizeImage(visibleUrls.at(i));
+    }
+    
+    while ((!queue.isEmpty()) && (requestCount < MAX_REQUESTS)) {
+        getImage(queue.dequeue());
+    }
+    
+    locker.unlock();
+    emit visibleRangeChanged(first, last);
+}
+
+void ImageCache::updateVisibleRange() {
+    if ((!m_view) || (!m_view->model())) {
+        setVisibleRange(-1, -1);
+        return;
+    }
+    
+    const int rowCount = m_view->model()->rowCount();
+    
+    if (rowCount == 0) {
+        setVisibleRange(-1, -1);
+        return;
+    }
+    
+    const QRect rect = m_view->viewport()->rect();
+    const int first = qMax(0, m_view->indexAt(rect.topLeft()).row());
+    const int rowHeight = qMax(1, m_view->sizeHintForRow(first));
+    const int last = qMin(rowCount - 1, first + rect.height() / rowHeight);
+    setVisibleRange(first, last);
+}
+
+int ImageCache::maximumCost() {
+    QMutexLocker locker(&mutex);
+    return cache.maxCost();
+}
+
+void ImageCache::setMaximumCost(int cost) {
+    QMutexLocker locker(&mutex);
+    cache.setMaxCost(qMax(1, cost));
+    // Images that were too large for the previous size may fit now
+    oversized.clear();
+}
+
+int ImageCache::totalCost() {
+    QMutexLocker locker(&mutex);
+    return cache.totalCost();
+}
+
+int ImageCache::hitCount() {
+    QMutexLocker locker(&mutex);
+    return hits;
+}
+
+int ImageCache::missCount() {
+    QMutexLocker locker(&mutex);
+    return misses;
+}
+
+int ImageCache::evictionCount() {
+    QMutexLocker locker(&mutex);
+    return evictions;
+}
+
+// getImage(), prioritizeImage() and abortImage() must be called with the mutex locked
 void ImageCache::getImage(const QUrl &url) {
     requestCount++;
     ImageRequest *request = new ImageRequest(m_manager, url);
+    requests.insert(url, request);
     connect(request, SIGNAL(finished(ImageRequest*)), this, SLOT(onRequestFinished(ImageRequest*)));
 }
 
-void ImageCache::onRequestFinished(ImageRequest *request) {    
-    if (CachedImage *ci = cache.object(request->url)) {
-        QImage image;
+void ImageCache::prioritizeImage(const QUrl &url) {
+    if (oversized.contains(url)) {
+        return;
+    }
+    
+    if (!cache.contains(url)) {
+        cache.insert(url, new CachedImage(url));
+        queue.prepend(url);
+    }
+    else if (queue.removeOne(url)) {
+        queue.prepend(url);
+    }
+}
+
+void ImageCache::abortImage(const QUrl &url) {
+    if (ImageRequest *request = requests.take(url)) {
+        // Remove the placeholder so that the image is requested again if the row becomes visible
+        cache.remove(url);
+        request->reply->abort();
+    }
+    else if (queue.removeOne(url)) {
+        cache.remove(url);
+    }
+}
+
+QUrl ImageCache::urlForRow(int row) const {
+    if ((!m_view) || (!m_view->model())) {
+        return QUrl();
+    }
+    
+    return m_view->model()->index(row, 0).data(m_urlRole).toString();
+}
+
+void ImageCache::onRequestFinished(ImageRequest *request) {
+    // Aborted requests are discarded, since the placeholder was removed when the row scrolled out of view
+    const bool aborted = (request->reply->error() == QNetworkReply::OperationCanceledError);
+    QImage image;
+    
+    if (!aborted) {
+        // Decode before locking, so that the GUI thread is not blocked
         image.loadFromData(request->reply->readAll());
-        ci->image = image;
-        emit imageReady();
     }
     
-    request->deleteLater();
+    bool ready = false;
+    QMutexLocker locker(&mutex);
+    
+    if (requests.value(request->url) == request) {
+        requests.remove(request->url);
+    }
+    
+    if (!aborted) {
+        if (CachedImage *ci = cache.take(request->url)) {
+            const int cost = qMax(1, image.byteCount());
+            
+            if (cost > cache.maxCost()) {
+                // QCache would delete an image that costs more than the whole cache, and the view would request it
+                // again on every repaint
+                oversized.insert(request->url);
+                delete ci;
+            }
+            else {
+                // Re-insert the placeholder so that its cost is the size of the decoded image
+                ci->image = image;
+                cache.insert(request->url, ci, cost);
+                ready = true;
+            }
+        }
+    }
+    
     requestCount--;
     
     if ((!queue.isEmpty()) && (requestCount < MAX_REQUESTS)) {
         getImage(queue.dequeue());
     }
+    
+    locker.unlock();
+    request->deleteLater();
+    
+    if (ready) {
+        emit imageReady();
+    }
 }
 
 ImageRequest::ImageRequest(QNetworkAccessManager *manager, const QUrl &u) :
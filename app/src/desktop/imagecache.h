@@ -19,11 +19,16 @@
 
 #include <QQueue>
 #include <QCache>
+#include <QHash>
 #include <QImage>
+#include <QMutex>
+#include <QPointer>
+#include <QSet>
 #include <QUrl>
 
 class CachedImage;
 class ImageRequest;
+class QAbstractItemView;
 class QThread;
 class QNetworkAccessManager;
 class QNetworkReply;
@@ -39,26 +44,63 @@ public:
     QImage image(const QUrl &url, const QSize &size = QSize(), Qt::AspectRatioMode aspectRatioMode = Qt::KeepAspectRatio,
                  Qt::TransformationMode transformatioMode = Qt::SmoothTransformation);
     
+    QAbstractItemView* view() const;
+    void setView(QAbstractItemView *view, int urlRole);
+    
+    static int maximumCost();
+    static void setMaximumCost(int cost);
+    
+    static int totalCost();
+    
+    static int hitCount();
+    static int missCount();
+    static int evictionCount();
+    
+public Q_SLOTS:
+    void setVisibleRange(int first, int last);
+    
 private Q_SLOTS:
+    void updateVisibleRange();
     void onRequestFinished(ImageRequest *request);
     
 Q_SIGNALS:
     void imageReady();
+    void visibleRangeChanged(int first, int last);
     
 private:
     void getImage(const QUrl &url);
+    void prioritizeImage(const QUrl &url);
+    void abortImage(const QUrl &url);
+    
+    QUrl urlForRow(int row) const;
     
     static QThread *thread;
     
+    // Guards the shared state, which is used by both the GUI thread and the cache thread
+    static QMutex mutex;
+    
     static QQueue<QUrl> queue;
+    static QHash<QUrl, ImageRequest*> requests;
     static QCache<QUrl, CachedImage> cache;
+    static QSet<QUrl> oversized;
     
     static int requestCount;
     static int refCount;
     
+    static int hits;
+    static int misses;
+    static int evictions;
+    
     static const int MAX_REQUESTS;
     
     QNetworkAccessManager *m_manager;
+    
+    QPointer<QAbstractItemView> m_view;
+    int m_urlRole;
+    
+    QSet<QUrl> m_nearUrls;
+    
+    friend class CachedImage;
 };
 
 class ImageRequest : public QObject
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "librarywindow.h"
+#include "librarymodel.h"
+#include <QDesktopServices>
+#include <QLineEdit>
+#include <QListView>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMessageBox>
+#include <QStatusBar>
+#include <QTimer>
+#include <QToolBar>
+
+LibraryWindow* LibraryWindow::self = 0;
+
+LibraryWindow::LibraryWindow() :
+    QMainWindow(),
+    m_model(new LibraryModel(this)),
+    m_videoMenu(new QMenu(tr("&Video"), this)),
+    m_pruneAction(new QAction(QIcon::fromTheme("edit-clear"), tr("Remove &missing files"), this)),
+    m_openAction(new QAction(QIcon::fromTheme("media-playback-start"), tr("&Open"), this)),
+    m_removeAction(new QAction(QIcon::fromTheme("edit-delete"), tr("&Remove from library"), this)),
+    m_toolBar(new QToolBar(this)),
+    m_searchEdit(new QLineEdit(this)),
+    m_searchTimer(new QTimer(this)),
+    m_view(new QListView(this))
+{
+    setWindowTitle(tr("Library"));
+    setCentralWidget(m_view);
+    addToolBar(Qt::TopToolBarArea, m_toolBar);
+    
+    menuBar()->addMenu(m_videoMenu);
+    
+    m_videoMenu->addAction(m_openAction);
+    m_videoMenu->addAction(m_removeAction);
+    m_videoMenu->setEnabled(false);
+    
+    m_searchEdit->setPlaceholderText(tr("Search"));
+    
+    m_toolBar->setObjectName("libraryToolBar");
+    m_toolBar->setWindowTitle(tr("Toolbar"));
+    m_toolBar->setAllowedAreas(Qt::TopToolBarArea);
+    m_toolBar->setMovable(false);
+    m_toolBar->addWidget(m_searchEdit);
+    m_toolBar->addAction(m_pruneAction);
+    
+    // Searches are made once the user stops typing
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(300);
+    
+    m_view->setModel(m_model);
+    m_view->setAlternatingRowColors(true);
+    m_view->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_view->setEditTriggers(QListView::NoEditTriggers);
+    m_view->setUniformItemSizes(true);
+    
+    connect(m_model, SIGNAL(countChanged(int)), this, SLOT(onCountChanged()));
+    connect(m_pruneAction, SIGNAL(triggered()), m_model, SLOT(prune()));
+    connect(m_openAction, SIGNAL(triggered()), this, SLOT(openVideo()));
+    connect(m_removeAction, SIGNAL(triggered()), this, SLOT(removeVideo()));
+    connect(m_searchEdit, SIGNAL(textChanged(QString)), m_searchTimer, SLOT(start()));
+    connect(m_searchTimer, SIGNAL(timeout()), this, SLOT(search()));
+    connect(m_view, SIGNAL(activated(QModelIndex)), this, SLOT(openVideo(QModelIndex)));
+    connect(m_view, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
+    
+    onCountChanged();
+}
+
+LibraryWindow::~LibraryWindow() {
+    self = 0;
+}
+
+LibraryWindow* LibraryWindow::instance() {
+    return self ? self : self = new LibraryWindow;
+}
+
+void LibraryWindow::search() {
+    m_model->search(m_searchEdit->text());
+}
+
+void LibraryWindow::openVideo() {
+    if (m_view->currentIndex().isValid()) {
+        openVideo(m_view->currentIndex());
+    }
+}
+
+void LibraryWindow::openVideo(const QModelIndex &index) {
+    if (!QDesktopServices::openUrl(index.data(LibraryModel::UrlRole).toUrl())) {
+        QMessageBox::critical(this, tr("Error"), tr("Cannot open '%1'")
+                              .arg(index.data(LibraryModel::FilePathRole).toString()));
+    }
+}
+
+void LibraryWindow::removeVideo() {
+    if (m_view->currentIndex().isValid()) {
+        removeVideo(m_view->currentIndex());
+    }
+}
+
+void LibraryWindow::removeVideo(const QModelIndex &index) {
+    // Only the library entry is removed. The file is left where it is.
+    if (QMessageBox::question(this, tr("Remove?"), tr("Do you want to remove '%1' from the library?")
+                              .arg(index.data(LibraryModel::TitleRole).toString()),
+                              QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+        m_model->remove(index.row());
+    }
+}
+
+void LibraryWindow::showContextMenu(const QPoint &pos) {
+    if (m_view->currentIndex().isValid()) {
+        m_videoMenu->popup(m_view->mapToGlobal(pos));
+    }
+}
+
+void LibraryWindow::onCountChanged() {
+    m_videoMenu->setEnabled(m_model->rowCount() > 0);
+    statusBar()->showMessage(tr("%1 videos").arg(m_model->total()));
+}
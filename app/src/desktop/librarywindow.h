@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBRARYWINDOW_H
+#define LIBRARYWINDOW_H
+
+#include <QMainWindow>
+
+class LibraryModel;
+class QLineEdit;
+class QListView;
+class QMenu;
+class QModelIndex;
+class QTimer;
+
+class LibraryWindow : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    ~LibraryWindow();
+    
+    static LibraryWindow* instance();
+
+private Q_SLOTS:
+    void search();
+    
+    void openVideo();
+    void openVideo(const QModelIndex &index);
+    
+    void removeVideo();
+    void removeVideo(const QModelIndex &index);
+    
+    void showContextMenu(const QPoint &pos);
+    
+    void onCountChanged();
+
+private:
+    LibraryWindow();
+    
+    static LibraryWindow *self;
+    
+    LibraryModel *m_model;
+    
+    QMenu *m_videoMenu;
+    
+    QAction *m_pruneAction;
+    QAction *m_openAction;
+    QAction *m_removeAction;
+    
+    QToolBar *m_toolBar;
+    
+    QLineEdit *m_searchEdit;
+    
+    QTimer *m_searchTimer;
+    
+    QListView *m_view;
+};
+
+#endif // LIBRARYWINDOW_H
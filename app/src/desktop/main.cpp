@@ -19,6 +19,7 @@
 #include "database.h"
 #include "dbusservice.h"
 #include "definitions.h"
+#include "imagecache.h"
 #include "logger.h"
 #include "mainwindow.h"
 #include "pluginmanager.h"
@@ -56,6 +57,7 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
     
     initDatabase();
     Settings::setNetworkProxy();
+    ImageCache::setMaximumCost(Settings::imageCacheSize());
     Dailymotion::init();
     Vimeo::init();
     YouTube::init();
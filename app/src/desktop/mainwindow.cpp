@@ -16,6 +16,7 @@
 
 #include "mainwindow.h"
 #include "dailymotionview.h"
+#include "librarywindow.h"
 #include "pluginmanager.h"
 #include "pluginview.h"
 #include "resources.h"
@@ -40,11 +41,13 @@ MainWindow::MainWindow(QWidget *parent) :
     m_editMenu(new QMenu(tr("&Edit"), this)),
     m_helpMenu(new QMenu(tr("&About"), this)),
     m_serviceGroup(new QActionGroup(this)),
+    m_pluginsSeparator(0),
     m_pluginsAction(new QAction(QIcon::fromTheme("view-refresh"), tr("&Load plugins"), this)),
     m_quitAction(new QAction(QIcon::fromTheme("application-exit"), tr("&Quit"), this)),
     m_backAction(new QAction(QIcon::fromTheme("go-previous"), tr("Go &back"), this)),
     m_reloadAction(new QAction(QIcon::fromTheme("view-refresh"), tr("&Reload"), this)),
     m_transfersAction(new QAction(QIcon::fromTheme("go-down"), tr("Show &transfers"), this)),
+    m_libraryAction(new QAction(QIcon::fromTheme("folder-videos"), tr("Show l&ibrary"), this)),
     m_playerAction(new QAction(QIcon::fromTheme("media-playback-start"), tr("Show video &player"), this)),
     m_settingsAction(new QAction(QIcon::fromTheme("preferences-desktop"), tr("&Preferences"), this)),
     m_aboutAction(new QAction(QIcon::fromTheme("help-about"), tr("&About"), this)),
@@ -78,17 +81,7 @@ MainWindow::MainWindow(QWidget *parent) :
     action->setShortcut(tr("Ctrl+3"));
     m_serviceGroup->addAction(action);
 
-    int count = m_serviceGroup->actions().size();
-    
-    foreach (const ServicePluginPair &pair, PluginManager::instance()->plugins()) {
-        action = m_serviceMenu->addAction(pair.config->displayName(), this, SLOT(setCurrentService()));
-        action->setData(pair.config->id());
-        action->setCheckable(true);
-        action->setShortcut(tr("Ctrl+%1").arg(++count));
-        m_serviceGroup->addAction(action);
-    }
-
-    m_serviceMenu->addSeparator();
+    m_pluginsSeparator = m_serviceMenu->addSeparator();
     m_serviceMenu->addAction(m_pluginsAction);
     m_serviceMenu->addAction(m_quitAction);
 
@@ -99,11 +92,13 @@ MainWindow::MainWindow(QWidget *parent) :
     m_viewMenu->addAction(m_reloadAction);
     m_viewMenu->addSeparator();
     m_viewMenu->addAction(m_transfersAction);
+    m_viewMenu->addAction(m_libraryAction);
     m_viewMenu->addAction(m_playerAction);
 
     m_backAction->setShortcut(tr("Ctrl+B"));
     m_reloadAction->setShortcut(tr("Ctrl+R"));
     m_transfersAction->setShortcut(tr("Ctrl+T"));
+    m_libraryAction->setShortcut(tr("Ctrl+I"));
     m_playerAction->setShortcut(tr("Ctrl+M"));
 
     m_editMenu->addAction(m_settingsAction);
@@ -123,16 +118,20 @@ MainWindow::MainWindow(QWidget *parent) :
     m_toolBar->addAction(m_reloadAction);
     m_toolBar->addSeparator();
     m_toolBar->addAction(m_transfersAction);
+    m_toolBar->addAction(m_libraryAction);
     m_toolBar->addAction(m_playerAction);
 
     connect(m_pluginsAction, SIGNAL(triggered()), this, SLOT(loadPlugins()));
     connect(m_quitAction, SIGNAL(triggered()), QApplication::instance(), SLOT(closeAllWindows()));
     connect(m_transfersAction, SIGNAL(triggered()), this, SLOT(showTransfers()));
+    connect(m_libraryAction, SIGNAL(triggered()), this, SLOT(showLibrary()));
     connect(m_playerAction, SIGNAL(triggered()), this, SLOT(showVideoPlayer()));
     connect(m_settingsAction, SIGNAL(triggered()), this, SLOT(showSettingsDialog()));
     connect(m_aboutAction, SIGNAL(triggered()), this, SLOT(showAboutDialog()));
     connect(Settings::instance(), SIGNAL(currentServiceChanged(QString)), this, SLOT(setCurrentService(QString)));
+    connect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(reloadPluginActions()));
 
+    reloadPluginActions();
     setCurrentService(Settings::currentService());
     
     restoreGeometry(Settings::mainWindowGeometry());
@@ -146,13 +145,35 @@ void MainWindow::closeEvent(QCloseEvent *event) {
 }
 
 void MainWindow::loadPlugins() {
-    const int count = PluginManager::instance()->load();
+    // New configs are parsed in the background, so the result is reported when loaded() is emitted
+    connect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(onPluginsLoaded(int)), Qt::UniqueConnection);
+    PluginManager::instance()->load();
+}
+
+void MainWindow::reloadPluginActions() {
+    // Configs that were not in the plugin index are parsed after the window is shown, so the plugin actions are
+    // rebuilt each time plugins are loaded
+    const QString service = Settings::currentService();
+    const bool wasChecked = (m_serviceGroup->checkedAction() != 0);
+    qDeleteAll(m_pluginActions);
+    m_pluginActions.clear();
+    int count = m_serviceGroup->actions().size();
     
-    if (count > 0) {
-        QMessageBox::information(this, tr("Load plugins"), tr("%1 new plugin(s) found"));
+    foreach (const ServicePluginPair &pair, PluginManager::instance()->plugins()) {
+        QAction *action = new QAction(pair.config->displayName(), this);
+        action->setData(pair.config->id());
+        action->setCheckable(true);
+        action->setShortcut(tr("Ctrl+%1").arg(++count));
+        action->setChecked(pair.config->id() == service);
+        connect(action, SIGNAL(triggered()), this, SLOT(setCurrentService()));
+        m_serviceMenu->insertAction(m_pluginsSeparator, action);
+        m_serviceGroup->addAction(action);
+        m_pluginActions << action;
     }
-    else {
-        QMessageBox::information(this, tr("Load plugins"), tr("No new plugins found"));
+    
+    if ((!wasChecked) && (m_serviceGroup->checkedAction()) && (centralWidget())) {
+        // The current service is a plugin that was not loaded when its view was created
+        setCurrentService(service);
     }
 }
 
@@ -197,6 +218,11 @@ void MainWindow::setCurrentService(const QString &service) {
 
 void MainWindow::showAboutDialog() {}
 
+void MainWindow::showLibrary() {
+    LibraryWindow::instance()->show();
+    LibraryWindow::instance()->activateWindow();
+}
+
 void MainWindow::showSettingsDialog() {
     SettingsDialog(this).exec();
 }
@@ -211,6 +237,17 @@ void MainWindow::showVideoPlayer() {
     VideoPlayerWindow::instance()->activateWindow();
 }
 
+void MainWindow::onPluginsLoaded(int count) {
+    disconnect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(onPluginsLoaded(int)));
+    
+    if (count > 0) {
+        QMessageBox::information(this, tr("Load plugins"), tr("%1 new plugin(s) found").arg(count));
+    }
+    else {
+        QMessageBox::information(this, tr("Load plugins"), tr("No new plugins found"));
+    }
+}
+
 void MainWindow::onPageStatusChanged(Page::Status status) {
     m_reloadAction->setEnabled(status != Page::Null);
 
@@ -32,15 +32,19 @@ public:
 
 private Q_SLOTS:
     void loadPlugins();
+    void reloadPluginActions();
     
     void setCurrentService();
     void setCurrentService(const QString &service);
     
     void showAboutDialog();
+    void showLibrary();
     void showSettingsDialog();
     void showTransfers();
     void showVideoPlayer();    
 
+    void onPluginsLoaded(int count);
+    
     void onPageStatusChanged(Page::Status status);
     void onPageWindowTitleChanged(const QString &text);
     
@@ -58,6 +62,9 @@ private:
     QMenu *m_helpMenu;
 
     QActionGroup *m_serviceGroup;
+    
+    QList<QAction*> m_pluginActions;
+    QAction *m_pluginsSeparator;
 
     QAction *m_pluginsAction;
     QAction *m_quitAction;
@@ -65,6 +72,7 @@ private:
     QAction *m_backAction;
     QAction *m_reloadAction;
     QAction *m_transfersAction;
+    QAction *m_libraryAction;
     QAction *m_playerAction;
 
     QAction *m_settingsAction;
@@ -39,6 +39,7 @@ PluginVideosPage::PluginVideosPage(const QString &service, QWidget *parent) :
 
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, PluginVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_layout->addWidget(m_view);
@@ -47,6 +48,7 @@ PluginVideosPage::PluginVideosPage(const QString &service, QWidget *parent) :
     connect(m_model, SIGNAL(statusChanged(ResourcesRequest::Status)),
             this, SLOT(onModelStatusChanged(ResourcesRequest::Status)));
     connect(m_cache, SIGNAL(imageReady()), this, SLOT(onImageReady()));
+    connect(m_cache, SIGNAL(visibleRangeChanged(int, int)), m_model, SLOT(setVisibleRange(int, int)));
     connect(m_delegate, SIGNAL(thumbnailClicked(QModelIndex)), this, SLOT(playVideo(QModelIndex)));
     connect(m_view, SIGNAL(clicked(QModelIndex)), this, SLOT(showVideo(QModelIndex)));
     connect(m_view, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
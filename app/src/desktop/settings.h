@@ -40,6 +40,7 @@ class Settings : public QObject
     Q_PROPERTY(bool customTransferCommandEnabled READ customTransferCommandEnabled WRITE setCustomTransferCommandEnabled
                NOTIFY customTransferCommandEnabledChanged)
     Q_PROPERTY(QString downloadPath READ downloadPath WRITE setDownloadPath NOTIFY downloadPathChanged)
+    Q_PROPERTY(int imageCacheSize READ imageCacheSize WRITE setImageCacheSize NOTIFY imageCacheSizeChanged)
     Q_PROPERTY(QString locale READ locale WRITE setLocale NOTIFY localeChanged)
     Q_PROPERTY(QString loggerFileName READ loggerFileName WRITE setLoggerFileName NOTIFY loggerFileNameChanged)
     Q_PROPERTY(int loggerVerbosity READ loggerVerbosity WRITE setLoggerVerbosity NOTIFY loggerVerbosityChanged)
@@ -100,6 +101,8 @@ public:
     static QString downloadPath();
     static QString downloadPath(const QString &category);
     
+    static int imageCacheSize();
+    
     static QString locale();
     
     static QString loggerFileName();
@@ -159,6 +162,8 @@ public Q_SLOTS:
         
     static void setDownloadPath(const QString &path);
     
+    static void setImageCacheSize(int size);
+    
     static void setLocale(const QString &name);
     
     static void setLoggerFileName(const QString &fileName);
@@ -210,6 +215,7 @@ Q_SIGNALS:
     void defaultSearchTypeChanged();
     void downloadFormatsChanged();
     void downloadPathChanged(const QString &path);
+    void imageCacheSizeChanged(int size);
     void localeChanged(const QString &locale);
     void loggerFileNameChanged(const QString &fileName);
     void loggerVerbosityChanged(int verbosity);
@@ -36,6 +36,7 @@ VimeoVideosPage::VimeoVideosPage(QWidget *parent) :
 {
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, VimeoVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_layout->addWidget(m_view);
@@ -36,6 +36,7 @@ YouTubeCommentsPage::YouTubeCommentsPage(QWidget *parent) :
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
     m_view->setUniformItemSizes(false);
+    m_cache->setView(m_view, YouTubeCommentModel::ThumbnailUrlRole);
 
     m_layout->addWidget(m_view);
     m_layout->setContentsMargins(0, 0, 0, 0);
@@ -43,6 +44,7 @@ YouTubeCommentsPage::YouTubeCommentsPage(QWidget *parent) :
     connect(m_model, SIGNAL(statusChanged(QYouTube::ResourcesRequest::Status)),
             this, SLOT(onModelStatusChanged(QYouTube::ResourcesRequest::Status)));
     connect(m_cache, SIGNAL(imageReady()), this, SLOT(onImageReady()));
+    connect(m_cache, SIGNAL(visibleRangeChanged(int, int)), m_model, SLOT(setVisibleRange(int, int)));
     connect(m_delegate, SIGNAL(thumbnailClicked(QModelIndex)), this, SLOT(showUser(QModelIndex)));
 }
 
@@ -28,9 +28,9 @@
 #include <QMessageBox>
 #include <QVBoxLayout>
 
-YouTubeVideosPage::YouTubeVideosPage(QWidget *parent) :
+YouTubeVideosPage::YouTubeVideosPage(QWidget *parent, YouTubeVideoModel *model) :
     Page(parent),
-    m_model(new YouTubeVideoModel(this)),
+    m_model(model ? model : new YouTubeVideoModel(this)),
     m_cache(new ImageCache),
     m_delegate(new VideoDelegate(m_cache, YouTubeVideoModel::DateRole, YouTubeVideoModel::DurationRole,
                                  YouTubeVideoModel::ThumbnailUrlRole, YouTubeVideoModel::TitleRole,
@@ -38,8 +38,11 @@ YouTubeVideosPage::YouTubeVideosPage(QWidget *parent) :
     m_view(new QListView(this)),
     m_layout(new QVBoxLayout(this))
 {
+    // The page takes ownership of a model that is passed in
+    m_model->setParent(this);
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, YouTubeVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_layout->addWidget(m_view);
@@ -48,6 +51,7 @@ YouTubeVideosPage::YouTubeVideosPage(QWidget *parent) :
     connect(m_model, SIGNAL(statusChanged(QYouTube::ResourcesRequest::Status)),
             this, SLOT(onModelStatusChanged(QYouTube::ResourcesRequest::Status)));
     connect(m_cache, SIGNAL(imageReady()), this, SLOT(onImageReady()));
+    connect(m_cache, SIGNAL(visibleRangeChanged(int, int)), m_model, SLOT(setVisibleRange(int, int)));
     connect(m_delegate, SIGNAL(thumbnailClicked(QModelIndex)), this, SLOT(playVideo(QModelIndex)));
     //connect(m_view, SIGNAL(clicked(QModelIndex)), this, SLOT(showVideo(QModelIndex)));
     connect(m_view, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
@@ -30,7 +30,7 @@ class YouTubeVideosPage : public Page
     Q_OBJECT
 
 public:
-    explicit YouTubeVideosPage(QWidget *parent = 0);
+    explicit YouTubeVideosPage(QWidget *parent = 0, YouTubeVideoModel *model = 0);
     ~YouTubeVideosPage();
 
     virtual Status status() const;
@@ -20,6 +20,7 @@
 #include "settings.h"
 #include "youtube.h"
 #include "youtubecategoriespage.h"
+#include "youtubefeedmodel.h"
 #include "youtubenavmodel.h"
 #include "youtubeplaylistspage.h"
 #include "youtubesearchdialog.h"
@@ -136,16 +137,13 @@ void YouTubeView::setCurrentPage(const QModelIndex &index) {
         listLikes();
         break;
     case 6:
-        listWatchLater();
+        listPlaylists();
         break;
     case 7:
-        listWatchHistory();
+        listSubscriptions();
         break;
     case 8:
-        listPlaylists();
-        break;
-    case 9:
-        listSubscriptions();
+        listLatestVideos();
         break;
     default:
         break;
@@ -230,6 +228,15 @@ void YouTubeView::listLikes() {
     push(page);
 }
 
+void YouTubeView::listLatestVideos() {
+    clear();
+    YouTubeFeedModel *model = new YouTubeFeedModel;
+    YouTubeVideosPage *page = new YouTubeVideosPage(this, model);
+    page->setWindowTitle(tr("Latest videos"));
+    model->list();
+    push(page);
+}
+
 void YouTubeView::listPlaylists() {
     clear();
     QVariantMap filters;
@@ -274,44 +281,6 @@ void YouTubeView::listUploads() {
     push(page);
 }
 
-void YouTubeView::listWatchHistory() {
-    const QString playlistId = YouTube::relatedPlaylist("watchHistory");
-    
-    if (playlistId.isEmpty()) {
-        QMessageBox::critical(this, tr("Not available"), tr("This channel does not have any watch history"));
-        return;
-    }
-    
-    clear();
-    QVariantMap filters;
-    filters["playlistId"] = playlistId;
-    QVariantMap params;
-    params["maxResults"] = MAX_RESULTS;
-    YouTubeVideosPage *page = new YouTubeVideosPage(this);
-    page->setWindowTitle(tr("Watch history"));
-    page->list("/playlistItems", QStringList() << "snippet", filters, params);
-    push(page);
-}
-
-void YouTubeView::listWatchLater() {
-    const QString playlistId = YouTube::relatedPlaylist("watchLater");
-    
-    if (playlistId.isEmpty()) {
-        QMessageBox::critical(this, tr("Not available"), tr("This channel does not have any watch later playlist"));
-        return;
-    }
-    
-    clear();
-    QVariantMap filters;
-    filters["playlistId"] = playlistId;
-    QVariantMap params;
-    params["maxResults"] = MAX_RESULTS;
-    YouTubeVideosPage *page = new YouTubeVideosPage(this);
-    page->setWindowTitle(tr("Watch later"));
-    page->list("/playlistItems", QStringList() << "snippet", filters, params);
-    push(page);
-}
-
 void YouTubeView::searchPlaylists(const QString &query, const QString &order) {
     clear();
     QVariantMap params;
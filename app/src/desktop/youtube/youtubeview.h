@@ -52,12 +52,11 @@ private:
     void listAccounts();
     void listCategories();
     void listFavourites();
+    void listLatestVideos();
     void listLikes();
     void listPlaylists();
     void listSubscriptions();
     void listUploads();
-    void listWatchHistory();
-    void listWatchLater();
 
     void searchPlaylists(const QString &query, const QString &order);
     void searchUsers(const QString &query, const QString &order);
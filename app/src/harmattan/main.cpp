@@ -34,6 +34,7 @@
 #include "database.h"
 #include "dbusservice.h"
 #include "definitions.h"
+#include "librarymodel.h"
 #include "localemodel.h"
 #include "logger.h"
 #include "maskeditem.h"
@@ -78,6 +79,7 @@
 #include "youtubeaccountmodel.h"
 #include "youtubecategorymodel.h"
 #include "youtubecommentmodel.h"
+#include "youtubefeedmodel.h"
 #include "youtubenavmodel.h"
 #include "youtubeplaylistmodel.h"
 #include "youtubesearchtypemodel.h"
@@ -123,6 +125,7 @@ inline void registerTypes() {
     qmlRegisterType<DailymotionUserModel>("cuteTube", 2, 0, "DailymotionUserModel");
     qmlRegisterType<DailymotionVideo>("cuteTube", 2, 0, "DailymotionVideo");
     qmlRegisterType<DailymotionVideoModel>("cuteTube", 2, 0, "DailymotionVideoModel");
+    qmlRegisterType<LibraryModel>("cuteTube", 2, 0, "LibraryModel");
     qmlRegisterType<LocaleModel>("cuteTube", 2, 0, "LocaleModel");
     qmlRegisterType<MaskedItem>("cuteTube", 2, 0, "MaskedItem");
     qmlRegisterType<NetworkProxyTypeModel>("cuteTube", 2, 0, "NetworkProxyTypeModel");
@@ -166,6 +169,7 @@ inline void registerTypes() {
     qmlRegisterType<YouTubeCategoryModel>("cuteTube", 2, 0, "YouTubeCategoryModel");
     qmlRegisterType<YouTubeComment>("cuteTube", 2, 0, "YouTubeComment");
     qmlRegisterType<YouTubeCommentModel>("cuteTube", 2, 0, "YouTubeCommentModel");
+    qmlRegisterType<YouTubeFeedModel>("cuteTube", 2, 0, "YouTubeFeedModel");
     qmlRegisterType<YouTubeNavModel>("cuteTube", 2, 0, "YouTubeNavModel");
     qmlRegisterType<YouTubePlaylist>("cuteTube", 2, 0, "YouTubePlaylist");
     qmlRegisterType<YouTubePlaylistModel>("cuteTube", 2, 0, "YouTubePlaylistModel");
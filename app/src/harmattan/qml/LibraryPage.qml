@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 3, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+import QtQuick 1.1
+import com.nokia.meego 1.0
+import cuteTube 2.0
+import "file:///usr/lib/qt4/imports/com/nokia/meego/UIConstants.js" as UI
+
+MyPage {
+    id: root
+
+    title: qsTr("Library")
+    tools: ToolBarLayout {
+
+        BackToolIcon {}
+
+        MyToolIcon {
+            platformIconId: "toolbar-delete"
+            onClicked: libraryModel.prune()
+        }
+    }
+
+    MyTextField {
+        id: searchField
+
+        anchors {
+            left: parent.left
+            right: parent.right
+            top: parent.top
+            margins: UI.PADDING_DOUBLE
+        }
+        placeholderText: qsTr("Search")
+        clearButtonEnabled: true
+        inputMethodHints: Qt.ImhNoPredictiveText
+        onTextChanged: libraryModel.search(text)
+        onAccepted: platformCloseSoftwareInputPanel()
+    }
+
+    ListView {
+        id: view
+
+        anchors {
+            left: parent.left
+            right: parent.right
+            top: searchField.bottom
+            topMargin: UI.PADDING_DOUBLE
+            bottom: parent.bottom
+        }
+        clip: true
+        cacheBuffer: 400
+        highlightFollowsCurrentItem: false
+        model: LibraryModel {
+            id: libraryModel
+        }
+        delegate: ListItem {
+            Column {
+                anchors {
+                    left: parent.left
+                    right: parent.right
+                    margins: UI.PADDING_DOUBLE
+                    verticalCenter: parent.verticalCenter
+                }
+
+                Label {
+                    width: parent.width
+                    font.bold: true
+                    verticalAlignment: Text.AlignVCenter
+                    elide: Text.ElideRight
+                    text: title
+                }
+
+                Label {
+                    width: parent.width
+                    font.pixelSize: UI.FONT_SMALL
+                    font.family: UI.FONT_FAMILY_LIGHT
+                    verticalAlignment: Text.AlignVCenter
+                    elide: Text.ElideRight
+                    text: category ? category + " - " + fileName : fileName
+                }
+            }
+
+            onClicked: VideoLauncher.playVideo(url)
+            onPressAndHold: {
+                view.currentIndex = index;
+                contextMenu.open();
+            }
+        }
+        onAtYEndChanged: if ((atYEnd) && (libraryModel.count < libraryModel.total)) libraryModel.fetchMore();
+    }
+
+    ScrollDecorator {
+        flickableItem: view
+    }
+
+    Label {
+        anchors {
+            fill: view
+            margins: UI.PADDING_DOUBLE
+        }
+        horizontalAlignment: Text.AlignHCenter
+        verticalAlignment: Text.AlignVCenter
+        wrapMode: Text.WordWrap
+        font.pixelSize: 60
+        color: UI.COLOR_INVERTED_SECONDARY_FOREGROUND
+        text: qsTr("No videos found")
+        visible: libraryModel.count == 0
+    }
+
+    ContextMenu {
+        id: contextMenu
+
+        MenuLayout {
+
+            MenuItem {
+                text: qsTr("Remove from library")
+                onClicked: libraryModel.remove(view.currentIndex)
+            }
+        }
+    }
+}
@@ -77,6 +77,11 @@ MyPage {
             onClicked: appWindow.pageStack.push(Qt.resolvedUrl("SettingsPage.qml"))
         }
 
+        MyToolIcon {
+            platformIconId: "toolbar-directory"
+            onClicked: appWindow.pageStack.push(Qt.resolvedUrl("LibraryPage.qml"))
+        }
+
         MyToolIcon {
             platformIconId: "toolbar-list"
             onClicked: {
@@ -190,6 +195,9 @@ MyPage {
                         appWindow.pageStack.push(Qt.resolvedUrl("youtube/YouTubeUsersPage.qml"), {title: qsTr("Subscriptions")})
                         .model.list("/subscriptions", ["snippet"], {mine: true}, {sort: "unread", maxResults: MAX_RESULTS});
                         break;
+                    case 8:
+                        appWindow.pageStack.push(Qt.resolvedUrl("youtube/YouTubeFeedPage.qml")).model.list();
+                        break;
                     }
                 }
             }
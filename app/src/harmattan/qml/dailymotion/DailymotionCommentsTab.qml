@@ -67,6 +67,7 @@ Tab {
         delegate: CommentDelegate {
             onThumbnailClicked: appWindow.pageStack.push(Qt.resolvedUrl("DailymotionUserPage.qml")).load(userId)
         }
+        onContentYChanged: commentModel.setVisibleRange(indexAt(0, contentY), indexAt(0, contentY + height - 1))
     }
 
     ScrollDecorator {
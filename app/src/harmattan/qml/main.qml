@@ -55,6 +55,7 @@ AppWindow {
         
         target: Clipboard
         onTextChanged: mainPage.showResourceFromUrl(text)
+        onUrlsChanged: Transfers.addDownloadTransfers(urls)
     }
 
     Connections {
@@ -80,6 +80,7 @@ Tab {
                 contextMenu.open();
             }
         }
+        onContentYChanged: videoModel.setVisibleRange(indexAt(0, contentY), indexAt(0, contentY + height - 1))
     }
 
     ScrollDecorator {
@@ -130,6 +130,8 @@ public:
     QString fileName() const;
     void setFileName(const QString &fn);
     
+    QString filePath() const;
+    
     QString id() const;
     void setId(const QString &i);
         
@@ -247,6 +249,7 @@ private:
     QString m_errorString;
     
     QString m_fileName;
+    QString m_filePath;
     
     QString m_id;
     
@@ -59,6 +59,7 @@ DailymotionVideosWindow::DailymotionVideosWindow(StackedWindow *parent) :
     
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, DailymotionVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_reloadAction->setEnabled(false);
@@ -38,11 +38,17 @@ static const QString PLUGIN_CONFIG_PATH(APP_CONFIG_PATH + "plugins/");
 static const QString DOWNLOAD_PATH(HOME_PATH + "MyDocs/cuteTube2/");
 static const QRegExp ILLEGAL_FILENAME_CHARS_RE("[\"@&~=\\/:?#!|<>*^]");
 
+// Images
+static const int IMAGE_CACHE_SIZE = 8 * 1024 * 1024;
+
 // Network
 static const int DOWNLOAD_BUFFER_SIZE = 64000;
 static const int MAX_CONCURRENT_TRANSFERS = 4;
 static const int MAX_REDIRECTS = 8;
 static const int MAX_RESULTS = 20;
+static const QString PLUGIN_CACHE_PATH(APP_CONFIG_PATH + "cache/plugins/");
+static const qint64 PLUGIN_CACHE_SIZE = 10 * 1024 * 1024;
+static const QString PLUGIN_INDEX_PATH(APP_CONFIG_PATH + "cache/plugins.index");
 static const QByteArray USER_AGENT("Wget/1.13.4 (linux-gnu)");
 
 // Version
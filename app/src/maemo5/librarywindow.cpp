@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "librarywindow.h"
+#include "filterbox.h"
+#include "librarymodel.h"
+#include "listview.h"
+#include "videolauncher.h"
+#include <QAction>
+#include <QKeyEvent>
+#include <QLabel>
+#include <QMenuBar>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+LibraryWindow::LibraryWindow(StackedWindow *parent) :
+    StackedWindow(parent),
+    m_model(new LibraryModel(this)),
+    m_view(new ListView(this)),
+    m_filterBox(new FilterBox(this)),
+    m_pruneAction(new QAction(tr("Remove missing files"), this)),
+    m_removeAction(new QAction(tr("Remove from library"), this)),
+    m_label(new QLabel(QString("<p align='center'; style='font-size: 40px; color: %1'>%2</p>")
+                              .arg(palette().color(QPalette::Mid).name()).arg(tr("No videos found")), this))
+{
+    setWindowTitle(tr("Library"));
+    setCentralWidget(new QWidget);
+    
+    m_view->setModel(m_model);
+    m_view->addAction(m_removeAction);
+    m_view->setContextMenuPolicy(Qt::ActionsContextMenu);
+    m_view->setUniformItemSizes(true);
+    
+    m_label->hide();
+    m_filterBox->hide();
+    
+    m_layout = new QVBoxLayout(centralWidget());
+    m_layout->addWidget(m_view);
+    m_layout->addWidget(m_label);
+    m_layout->addWidget(m_filterBox);
+    m_layout->setStretch(0, 1);
+    m_layout->setStretch(1, 1);
+    m_layout->setContentsMargins(0, 0, 0, 0);
+    
+    menuBar()->addAction(m_pruneAction);
+    
+    connect(m_model, SIGNAL(countChanged(int)), this, SLOT(onCountChanged(int)));
+    connect(m_view, SIGNAL(activated(QModelIndex)), this, SLOT(playVideo(QModelIndex)));
+    connect(m_filterBox, SIGNAL(textChanged(QString)), this, SLOT(onFilterTextChanged(QString)));
+    connect(m_pruneAction, SIGNAL(triggered()), m_model, SLOT(prune()));
+    connect(m_removeAction, SIGNAL(triggered()), this, SLOT(removeCurrentVideo()));
+    
+    onCountChanged(m_model->rowCount());
+}
+
+void LibraryWindow::keyPressEvent(QKeyEvent *e) {
+    if ((m_filterBox->isHidden()) && (e->key() >= Qt::Key_0) && (e->key() <= Qt::Key_Z)) {
+        m_filterBox->setText(e->text());
+        m_filterBox->setFocus(Qt::OtherFocusReason);
+    }
+    else {
+        StackedWindow::keyPressEvent(e);
+    }
+}
+
+void LibraryWindow::playVideo(const QModelIndex &index) {
+    if (!VideoLauncher::playVideo(index.data(LibraryModel::UrlRole).toString())) {
+        QMessageBox::critical(this, tr("Error"), tr("Unable to play video"));
+    }
+}
+
+void LibraryWindow::removeCurrentVideo() {
+    // Only the library entry is removed. The file is left where it is.
+    if (m_view->currentIndex().isValid()) {
+        m_model->remove(m_view->currentIndex().row());
+    }
+}
+
+void LibraryWindow::onCountChanged(int count) {
+    if (count > 0) {
+        m_label->hide();
+        m_view->show();
+    }
+    else {
+        m_view->hide();
+        m_label->show();
+    }
+}
+
+void LibraryWindow::onFilterTextChanged(const QString &text) {
+    m_model->search(text);
+    m_filterBox->setVisible(!text.isEmpty());
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBRARYWINDOW_H
+#define LIBRARYWINDOW_H
+
+#include "stackedwindow.h"
+
+class FilterBox;
+class LibraryModel;
+class ListView;
+class QAction;
+class QLabel;
+class QModelIndex;
+class QVBoxLayout;
+
+class LibraryWindow : public StackedWindow
+{
+    Q_OBJECT
+    
+public:
+    explicit LibraryWindow(StackedWindow *parent = 0);
+
+protected:
+    virtual void keyPressEvent(QKeyEvent *e);
+
+private Q_SLOTS:
+    void playVideo(const QModelIndex &index);
+    void removeCurrentVideo();
+    
+    void onCountChanged(int count);
+    void onFilterTextChanged(const QString &text);
+    
+private:
+    LibraryModel *m_model;
+    
+    ListView *m_view;
+    FilterBox *m_filterBox;
+    QAction *m_pruneAction;
+    QAction *m_removeAction;
+    QLabel *m_label;
+    QVBoxLayout *m_layout;
+};
+
+#endif // LIBRARYWINDOW_H
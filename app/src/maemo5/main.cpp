@@ -18,6 +18,7 @@
 #include "database.h"
 #include "dailymotion.h"
 #include "dbusservice.h"
+#include "imagecache.h"
 #include "logger.h"
 #include "mainwindow.h"
 #include "pluginmanager.h"
@@ -60,6 +61,7 @@ int main(int argc, char *argv[]) {
     
     initDatabase();
     Settings::setNetworkProxy();
+    ImageCache::setMaximumCost(Settings::imageCacheSize());
     Dailymotion::init();
     Vimeo::init();
     YouTube::init();
@@ -75,6 +77,8 @@ int main(int argc, char *argv[]) {
     QObject::connect(settings.data(), SIGNAL(clipboardMonitorEnabledChanged(bool)),
                      clipboard.data(), SLOT(setEnabled(bool)));
     QObject::connect(clipboard.data(), SIGNAL(textChanged(QString)), window.data(), SLOT(showResource(QString)));
+    QObject::connect(clipboard.data(), SIGNAL(urlsChanged(QStringList)),
+                     transfers.data(), SLOT(addDownloadTransfers(QStringList)));
     QObject::connect(&dbus, SIGNAL(resourceRequested(QVariantMap)), window.data(), SLOT(showResource(QVariantMap)));
     
     return app.exec();
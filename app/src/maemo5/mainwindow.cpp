@@ -17,6 +17,7 @@
 #include "mainwindow.h"
 #include "aboutdialog.h"
 #include "dailymotionview.h"
+#include "librarywindow.h"
 #include "pluginview.h"
 #include "resources.h"
 #include "servicemodel.h"
@@ -38,6 +39,7 @@ MainWindow::MainWindow() :
     m_serviceModel(new ServiceModel(this)),
     m_serviceAction(new ValueSelectorAction(this)),
     m_transfersAction(new QAction(tr("Transfers"), this)),
+    m_libraryAction(new QAction(tr("Library"), this)),
     m_settingsAction(new QAction(tr("Settings"), this)),
     m_aboutAction(new QAction(tr("About"), this))
 {
@@ -47,11 +49,13 @@ MainWindow::MainWindow() :
     
     menuBar()->addAction(m_serviceAction);
     menuBar()->addAction(m_transfersAction);
+    menuBar()->addAction(m_libraryAction);
     menuBar()->addAction(m_settingsAction);
     menuBar()->addAction(m_aboutAction);
     
     connect(m_serviceAction, SIGNAL(valueChanged(QVariant)), this, SLOT(setService(QVariant)));
     connect(m_transfersAction, SIGNAL(triggered()), this, SLOT(showTransfers()));
+    connect(m_libraryAction, SIGNAL(triggered()), this, SLOT(showLibrary()));
     connect(m_settingsAction, SIGNAL(triggered()), this, SLOT(showSettingsDialog()));
     connect(m_aboutAction, SIGNAL(triggered()), this, SLOT(showAboutDialog()));
     connect(Transfers::instance(), SIGNAL(transferAdded(Transfer*)), this, SLOT(onTransferAdded(Transfer*)));
@@ -131,6 +135,11 @@ void MainWindow::showAboutDialog() {
     AboutDialog(this).exec();
 }
 
+void MainWindow::showLibrary() {
+    LibraryWindow *window = new LibraryWindow(this);
+    window->show();
+}
+
 void MainWindow::showSettingsDialog() {
     SettingsDialog(this).exec();
 }
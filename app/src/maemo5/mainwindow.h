@@ -44,6 +44,7 @@ private Q_SLOTS:
     void setService(const QVariant &service);
     
     void showAboutDialog();
+    void showLibrary();
     void showSettingsDialog();
     void showTransfers();
     
@@ -58,6 +59,7 @@ private:
     
     ValueSelectorAction *m_serviceAction;
     QAction *m_transfersAction;
+    QAction *m_libraryAction;
     QAction *m_settingsAction;
     QAction *m_aboutAction;
 };
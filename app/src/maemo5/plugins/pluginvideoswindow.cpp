@@ -54,6 +54,7 @@ PluginVideosWindow::PluginVideosWindow(StackedWindow *parent) :
     
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, PluginVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_reloadAction->setEnabled(false);
@@ -73,6 +74,7 @@ PluginVideosWindow::PluginVideosWindow(StackedWindow *parent) :
     connect(m_model, SIGNAL(statusChanged(ResourcesRequest::Status)), this,
             SLOT(onModelStatusChanged(ResourcesRequest::Status)));
     connect(m_cache, SIGNAL(imageReady()), this, SLOT(onImageReady()));
+    connect(m_cache, SIGNAL(visibleRangeChanged(int, int)), m_model, SLOT(setVisibleRange(int, int)));
     connect(m_view, SIGNAL(activated(QModelIndex)), this, SLOT(showVideo(QModelIndex)));
     connect(m_view, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
     connect(m_delegate, SIGNAL(thumbnailClicked(QModelIndex)), this, SLOT(playVideo(QModelIndex)));
@@ -16,6 +16,7 @@
 
 #include "settings.h"
 #include "definitions.h"
+#include "imagecache.h"
 #include "resources.h"
 #include <QSettings>
 #include <QNetworkProxy>
@@ -239,6 +240,22 @@ void Settings::setDownloadPath(const QString &path) {
     }
 }
 
+int Settings::imageCacheSize() {
+    return qMax(1, value("Content/imageCacheSize", IMAGE_CACHE_SIZE).toInt());
+}
+
+void Settings::setImageCacheSize(int size) {
+    if (size != imageCacheSize()) {
+        size = qMax(1, size);
+        setValue("Content/imageCacheSize", size);
+        ImageCache::setMaximumCost(size);
+
+        if (self) {
+            emit self->imageCacheSizeChanged(size);
+        }
+    }
+}
+
 QString Settings::locale() {
     return value("Content/locale", QLocale().name()).toString();
 }
@@ -60,6 +60,7 @@ VimeoVideosWindow::VimeoVideosWindow(StackedWindow *parent) :
     
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, VimeoVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_reloadAction->setEnabled(false);
@@ -37,9 +37,9 @@
 #include <QMenu>
 #include <QMaemo5InformationBox>
 
-YouTubeVideosWindow::YouTubeVideosWindow(StackedWindow *parent) :
+YouTubeVideosWindow::YouTubeVideosWindow(StackedWindow *parent, YouTubeVideoModel *model) :
     StackedWindow(parent),
-    m_model(new YouTubeVideoModel(this)),
+    m_model(model ? model : new YouTubeVideoModel(this)),
     m_cache(new ImageCache),
     m_view(new ListView(this)),
     m_delegate(new VideoDelegate(m_cache, YouTubeVideoModel::DateRole, YouTubeVideoModel::DurationRole,
@@ -57,8 +57,11 @@ YouTubeVideosWindow::YouTubeVideosWindow(StackedWindow *parent) :
     setWindowTitle(tr("Videos"));
     setCentralWidget(new QWidget);
     
+    // The window takes ownership of a model that is passed in
+    m_model->setParent(this);
     m_view->setModel(m_model);
     m_view->setItemDelegate(m_delegate);
+    m_cache->setView(m_view, YouTubeVideoModel::ThumbnailUrlRole);
     m_view->setContextMenuPolicy(Qt::CustomContextMenu);
 
     m_reloadAction->setEnabled(false);
@@ -78,6 +81,7 @@ YouTubeVideosWindow::YouTubeVideosWindow(StackedWindow *parent) :
     connect(m_model, SIGNAL(statusChanged(QYouTube::ResourcesRequest::Status)), this,
             SLOT(onModelStatusChanged(QYouTube::ResourcesRequest::Status)));
     connect(m_cache, SIGNAL(imageReady()), this, SLOT(onImageReady()));
+    connect(m_cache, SIGNAL(visibleRangeChanged(int, int)), m_model, SLOT(setVisibleRange(int, int)));
     connect(m_view, SIGNAL(activated(QModelIndex)), this, SLOT(showVideo(QModelIndex)));
     connect(m_view, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
     connect(m_delegate, SIGNAL(thumbnailClicked(QModelIndex)), this, SLOT(playVideo(QModelIndex)));
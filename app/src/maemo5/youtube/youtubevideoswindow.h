@@ -32,7 +32,7 @@ class YouTubeVideosWindow : public StackedWindow
     Q_OBJECT
     
 public:
-    explicit YouTubeVideosWindow(StackedWindow *parent = 0);
+    explicit YouTubeVideosWindow(StackedWindow *parent = 0, YouTubeVideoModel *model = 0);
     ~YouTubeVideosWindow();
 
 public Q_SLOTS:
@@ -24,6 +24,7 @@
 #include "youtube.h"
 #include "youtubeaccountswindow.h"
 #include "youtubecategorieswindow.h"
+#include "youtubefeedmodel.h"
 #include "youtubenavmodel.h"
 #include "youtubeplaylist.h"
 #include "youtubeplaylistswindow.h"
@@ -157,15 +158,10 @@ void YouTubeView::showFavourites() {
 }
 
 void YouTubeView::showLatestVideos() {
-    QVariantMap filters;
-    filters["home"] = true;
-    
-    QVariantMap params;
-    params["maxResults"] = MAX_RESULTS;
-    
-    YouTubeVideosWindow *window = new YouTubeVideosWindow(StackedWindow::currentWindow());
+    YouTubeFeedModel *model = new YouTubeFeedModel;
+    YouTubeVideosWindow *window = new YouTubeVideosWindow(StackedWindow::currentWindow(), model);
     window->setWindowTitle(tr("Latest videos"));
-    window->list("/activities", QStringList() << "snippet" << "contentDetails", filters, params);
+    model->list();
     window->show();
 }
 
@@ -277,6 +273,9 @@ void YouTubeView::onItemActivated(const QModelIndex &index) {
     case 7:
         showSubscriptions();
         break;
+    case 8:
+        showLatestVideos();
+        break;
     default:
         break;
     }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "externalpluginworker.h"
+#include "json.h"
+#include "logger.h"
+#include <QProcess>
+#include <QStringList>
+
+ExternalPluginWorker::ExternalPluginWorker(const QString &id, const QString &fileName, QObject *parent) :
+    QObject(parent),
+    m_process(0),
+    m_fileName(fileName),
+    m_id(id),
+    m_nextId(1)
+{
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(60000);
+    connect(&m_idleTimer, SIGNAL(timeout()), this, SLOT(onIdleTimeout()));
+}
+
+ExternalPluginWorker::~ExternalPluginWorker() {
+    if ((m_process) && (m_process->state() != QProcess::NotRunning)) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(1000);
+    }
+}
+
+QString ExternalPluginWorker::fileName() const {
+    return m_fileName;
+}
+
+QString ExternalPluginWorker::id() const {
+    return m_id;
+}
+
+int ExternalPluginWorker::idleTimeout() const {
+    return m_idleTimer.interval() / 1000;
+}
+
+void ExternalPluginWorker::setIdleTimeout(int timeout) {
+    m_idleTimer.setInterval(qMax(1, timeout) * 1000);
+}
+
+QProcess* ExternalPluginWorker::process() {
+    if (!m_process) {
+        m_process = new QProcess(this);
+        connect(m_process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(onProcessError()));
+        connect(m_process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(onProcessFinished(int)));
+        connect(m_process, SIGNAL(readyReadStandardOutput()), this, SLOT(onProcessReadyRead()));
+        connect(m_process, SIGNAL(readyReadStandardError()), this, SLOT(onProcessReadyReadStandardError()));
+    }
+    
+    return m_process;
+}
+
+int ExternalPluginWorker::call(const QString &method, const QVariantList &params) {
+    QProcess *pr = process();
+    
+    if (pr->state() == QProcess::NotRunning) {
+        Logger::log("ExternalPluginWorker::call(). Starting worker: " + fileName(), Logger::MediumVerbosity);
+        m_buffer.clear();
+        pr->start(fileName(), QStringList() << "worker");
+        
+        if (pr->state() == QProcess::NotRunning) {
+            Logger::log("ExternalPluginWorker::call(). Error starting worker: " + fileName());
+            return -1;
+        }
+    }
+    
+    const int callId = m_nextId++;
+    QVariantMap message;
+    message["id"] = callId;
+    message["method"] = method;
+    message["params"] = params;
+    m_calls << callId;
+    m_idleTimer.stop();
+    Logger::log(QString("ExternalPluginWorker::call(). ID: %1, Method: %2").arg(callId).arg(method),
+                Logger::MediumVerbosity);
+    write(message);
+    return callId;
+}
+
+void ExternalPluginWorker::cancel(int callId) {
+    if (!m_calls.remove(callId)) {
+        return;
+    }
+    
+    Logger::log(QString("ExternalPluginWorker::cancel(). ID: %1").arg(callId), Logger::MediumVerbosity);
+    QVariantMap message;
+    message["id"] = callId;
+    message["method"] = "cancel";
+    write(message);
+    
+    if (m_calls.isEmpty()) {
+        m_idleTimer.start();
+    }
+}
+
+void ExternalPluginWorker::write(const QVariantMap &message) {
+    if (m_process) {
+        m_process->write(QtJson::Json::serialize(message) + "\n");
+    }
+}
+
+void ExternalPluginWorker::failAll(const QString &errorString) {
+    const QSet<int> calls = m_calls;
+    m_calls.clear();
+    
+    foreach (int callId, calls) {
+        emit error(callId, errorString);
+    }
+}
+
+void ExternalPluginWorker::onProcessError() {
+    const QString errorString = m_process->errorString();
+    Logger::log("ExternalPluginWorker::onProcessError(): " + errorString);
+    
+    if (m_process->state() == QProcess::NotRunning) {
+        failAll(errorString);
+    }
+}
+
+void ExternalPluginWorker::onProcessFinished(int exitCode) {
+    Logger::log(QString("ExternalPluginWorker::onProcessFinished(). Exit code: %1").arg(exitCode),
+                Logger::MediumVerbosity);
+    onProcessReadyRead();
+    m_idleTimer.stop();
+    
+    if (!m_calls.isEmpty()) {
+        failAll(tr("Plugin worker exited with code %1").arg(exitCode));
+    }
+}
+
+void ExternalPluginWorker::onProcessReadyRead() {
+    m_buffer += m_process->readAllStandardOutput();
+    int newline;
+    
+    while ((newline = m_buffer.indexOf('\n')) != -1) {
+        const QByteArray line = m_buffer.left(newline).trimmed();
+        m_buffer.remove(0, newline + 1);
+        
+        if (line.isEmpty()) {
+            continue;
+        }
+        
+        bool ok;
+        const QVariantMap response = QtJson::Json::parse(QString::fromUtf8(line), ok).toMap();
+        
+        if (!ok) {
+            Logger::log("ExternalPluginWorker::onProcessReadyRead(). Cannot parse response: "
+                        + QString::fromUtf8(line));
+            continue;
+        }
+        
+        const int callId = response.value("id").toInt();
+        
+        // Responses to canceled calls are discarded
+        if (!m_calls.remove(callId)) {
+            continue;
+        }
+        
+        if (response.contains("error")) {
+            const QString errorString = response.value("error").toString();
+            emit error(callId, errorString.isEmpty() ? tr("Unknown error") : errorString);
+        }
+        else {
+            emit finished(callId, response.value("result"));
+        }
+    }
+    
+    if ((m_calls.isEmpty()) && (m_process->state() == QProcess::Running)) {
+        m_idleTimer.start();
+    }
+}
+
+void ExternalPluginWorker::onProcessReadyReadStandardError() {
+    const QByteArray output = m_process->readAllStandardError().trimmed();
+    
+    if (!output.isEmpty()) {
+        Logger::log(QString("ExternalPluginWorker::onProcessReadyReadStandardError(). %1: %2").arg(fileName())
+                           .arg(QString::fromUtf8(output)), Logger::HighVerbosity);
+    }
+}
+
+void ExternalPluginWorker::onIdleTimeout() {
+    if ((!m_calls.isEmpty()) || (!m_process)) {
+        return;
+    }
+    
+    Logger::log("ExternalPluginWorker::onIdleTimeout(). Closing idle worker: " + fileName(), Logger::MediumVerbosity);
+    // The plugin is expected to exit when stdin is closed. It is detached first, so that a call made before
+    // it exits starts a new process instead of waiting for this one.
+    QProcess *pr = m_process;
+    m_process = 0;
+    m_buffer.clear();
+    pr->disconnect(this);
+    
+    if (pr->state() == QProcess::NotRunning) {
+        pr->deleteLater();
+        return;
+    }
+    
+    connect(pr, SIGNAL(finished(int, QProcess::ExitStatus)), pr, SLOT(deleteLater()));
+    pr->closeReadChannel(QProcess::StandardOutput);
+    pr->closeReadChannel(QProcess::StandardError);
+    pr->closeWriteChannel();
+    QTimer::singleShot(5000, pr, SLOT(kill()));
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EXTERNALPLUGINWORKER_H
+#define EXTERNALPLUGINWORKER_H
+
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QVariant>
+
+class QProcess;
+
+/*
+ * Runs an external plugin as a long-lived process (<plugin> worker), used when the plugin config contains "worker".
+ *
+ * Calls are written to stdin as JSON, one per line: {"id": 1, "method": "list", "params": ["video", "..."]}.
+ * The plugin writes one line per response to stdout, in any order: {"id": 1, "result": ...} or
+ * {"id": 1, "error": "..."}. A call can be canceled with {"id": 1, "method": "cancel"}, which has no response.
+ * The process is started on the first call and stdin is closed once it has been idle for idleTimeout() seconds.
+ * Anything the plugin writes to stderr is logged.
+ */
+class ExternalPluginWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ExternalPluginWorker(const QString &id, const QString &fileName, QObject *parent = 0);
+    ~ExternalPluginWorker();
+    
+    QString fileName() const;
+    
+    QString id() const;
+    
+    int idleTimeout() const;
+    void setIdleTimeout(int timeout);
+    
+    int call(const QString &method, const QVariantList &params);
+    void cancel(int callId);
+
+Q_SIGNALS:
+    void error(int callId, const QString &errorString);
+    void finished(int callId, const QVariant &result);
+
+private Q_SLOTS:
+    void onProcessError();
+    void onProcessFinished(int exitCode);
+    void onProcessReadyRead();
+    void onProcessReadyReadStandardError();
+    void onIdleTimeout();
+
+private:
+    QProcess* process();
+    
+    void write(const QVariantMap &message);
+    
+    void failAll(const QString &errorString);
+    
+    QProcess *m_process;
+    
+    QString m_fileName;
+    QString m_id;
+    
+    QByteArray m_buffer;
+    
+    QSet<int> m_calls;
+    
+    int m_nextId;
+    
+    QTimer m_idleTimer;
+};
+
+#endif // EXTERNALPLUGINWORKER_H
@@ -15,6 +15,7 @@
  */
 
 #include "externalresourcesrequest.h"
+#include "externalpluginworker.h"
 #include "json.h"
 #include "logger.h"
 #include <QProcess>
@@ -22,11 +23,32 @@
 ExternalResourcesRequest::ExternalResourcesRequest(const QString &id, const QString &fileName, QObject *parent) :
     ResourcesRequest(parent),
     m_process(0),
+    m_callId(-1),
     m_fileName(fileName),
-    m_id(id)
+    m_id(id),
+    m_status(Null)
 {
 }
 
+ExternalResourcesRequest::ExternalResourcesRequest(ExternalPluginWorker *worker, QObject *parent) :
+    ResourcesRequest(parent),
+    m_process(0),
+    m_worker(worker),
+    m_callId(-1),
+    m_fileName(worker->fileName()),
+    m_id(worker->id()),
+    m_status(Null)
+{
+    connect(worker, SIGNAL(error(int, QString)), this, SLOT(onWorkerError(int, QString)));
+    connect(worker, SIGNAL(finished(int, QVariant)), this, SLOT(onWorkerFinished(int, QVariant)));
+}
+
+ExternalResourcesRequest::~ExternalResourcesRequest() {
+    if ((m_worker) && (m_callId != -1)) {
+        m_worker->cancel(m_callId);
+    }
+}
+
 QString ExternalResourcesRequest::fileName() const {
     return m_fileName;
 }
@@ -72,8 +94,37 @@ QProcess* ExternalResourcesRequest::process() {
     return m_process;
 }
 
+bool ExternalResourcesRequest::callWorker(const QString &method, const QVariantList &params) {
+    if (!m_worker) {
+        return false;
+    }
+    
+    setStatus(Loading);
+    m_callId = m_worker->call(method, params);
+    
+    if (m_callId == -1) {
+        Logger::log("ExternalResourcesRequest::callWorker(). Error calling worker method: " + method);
+        setErrorString(tr("Cannot start plugin worker"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
+    return true;
+}
+
 bool ExternalResourcesRequest::cancel() {
-    return false;
+    if ((!m_worker) || (status() != Loading)) {
+        return false;
+    }
+    
+    m_worker->cancel(m_callId);
+    m_callId = -1;
+    setErrorString(QString());
+    setResult(QVariant());
+    setStatus(Canceled);
+    emit finished();
+    return true;
 }
 
 bool ExternalResourcesRequest::del(const QString &sourceType, const QString &sourceId, const QString &destinationType,
@@ -82,6 +133,10 @@ bool ExternalResourcesRequest::del(const QString &sourceType, const QString &sou
         return false;
     }
     
+    if (m_worker) {
+        return callWorker("del", QVariantList() << sourceType << sourceId << destinationType << destinationId);
+    }
+    
     setStatus(Loading);
     const QString command = QString("\"%1\" del \"%2\" \"%3\" \"%4\" \"%5\"").arg(fileName()).arg(sourceType)
                                                                              .arg(sourceId).arg(destinationType)
@@ -105,6 +160,10 @@ bool ExternalResourcesRequest::get(const QString &resourceType, const QString &r
         return false;
     }
     
+    if (m_worker) {
+        return callWorker("get", QVariantList() << resourceType << resourceId);
+    }
+    
     setStatus(Loading);
     const QString command = QString("\"%1\" get \"%2\" \"%3\"").arg(fileName()).arg(resourceType).arg(resourceId);
     QProcess *pr = process();
@@ -127,6 +186,10 @@ bool ExternalResourcesRequest::insert(const QString &sourceType, const QString &
         return false;
     }
     
+    if (m_worker) {
+        return callWorker("insert", QVariantList() << sourceType << sourceId << destinationType << destinationId);
+    }
+    
     setStatus(Loading);
     const QString command = QString("\"%1\" insert \"%2\" \"%3\" \"%4\" \"%5\"").arg(fileName()).arg(sourceType)
                                                                                 .arg(sourceId).arg(destinationType)
@@ -150,6 +213,10 @@ bool ExternalResourcesRequest::list(const QString &resourceType, const QString &
         return false;
     }
     
+    if (m_worker) {
+        return callWorker("list", QVariantList() << resourceType << resourceId);
+    }
+    
     setStatus(Loading);
     const QString command = QString("\"%1\" list \"%2\" \"%3\"").arg(fileName()).arg(resourceType).arg(resourceId);
     QProcess *pr = process();
@@ -171,6 +238,10 @@ bool ExternalResourcesRequest::search(const QString &resourceType, const QString
         return false;
     }
     
+    if (m_worker) {
+        return callWorker("search", QVariantList() << resourceType << query << order);
+    }
+    
     setStatus(Loading);
     const QString command = QString("\"%1\" search \"%2\" \"%3\" \"%4\"").arg(fileName()).arg(resourceType).arg(query)
                                                                          .arg(order);
@@ -197,6 +268,32 @@ void ExternalResourcesRequest::onRequestError() {
     emit finished();
 }
 
+void ExternalResourcesRequest::onWorkerError(int callId, const QString &errorString) {
+    if (callId != m_callId) {
+        return;
+    }
+    
+    Logger::log("ExternalResourcesRequest::onWorkerError(): " + errorString);
+    m_callId = -1;
+    setErrorString(errorString);
+    setResult(QVariant());
+    setStatus(Failed);
+    emit finished();
+}
+
+void ExternalResourcesRequest::onWorkerFinished(int callId, const QVariant &result) {
+    if (callId != m_callId) {
+        return;
+    }
+    
+    Logger::log("ExternalResourcesRequest::onWorkerFinished()", Logger::MediumVerbosity);
+    m_callId = -1;
+    setErrorString(QString());
+    setResult(result);
+    setStatus(Ready);
+    emit finished();
+}
+
 void ExternalResourcesRequest::onRequestFinished(int exitCode) {
     const QVariant result = QtJson::Json::parse(QString::fromUtf8(m_process->readAllStandardOutput()));
     setResult(result);
@@ -18,7 +18,9 @@
 #define EXTERNALRESOURCESREQUEST_H
 
 #include "resourcesrequest.h"
+#include <QPointer>
 
+class ExternalPluginWorker;
 class QProcess;
 
 class ExternalResourcesRequest : public ResourcesRequest
@@ -30,6 +32,8 @@ class ExternalResourcesRequest : public ResourcesRequest
 
 public:
     explicit ExternalResourcesRequest(const QString &id, const QString &fileName, QObject *parent = 0);
+    explicit ExternalResourcesRequest(ExternalPluginWorker *worker, QObject *parent = 0);
+    ~ExternalResourcesRequest();
 
     QString fileName() const;
 
@@ -54,6 +58,8 @@ public Q_SLOTS:
 private Q_SLOTS:
     void onRequestError();
     void onRequestFinished(int exitCode);
+    void onWorkerError(int callId, const QString &errorString);
+    void onWorkerFinished(int callId, const QVariant &result);
 
 private:
     void setErrorString(const QString &e);
@@ -64,8 +70,14 @@ private:
     
     QProcess* process();
     
+    bool callWorker(const QString &method, const QVariantList &params);
+    
     QProcess *m_process;
     
+    QPointer<ExternalPluginWorker> m_worker;
+    
+    int m_callId;
+    
     QString m_fileName;
     QString m_id;
 
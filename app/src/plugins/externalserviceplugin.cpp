@@ -16,19 +16,26 @@
  */
 
 #include "externalserviceplugin.h"
+#include "externalpluginworker.h"
 #include "externalresourcesrequest.h"
 
 ExternalServicePlugin::ExternalServicePlugin(QObject *parent) :
     QObject(parent),
-    ServicePlugin()
+    ServicePlugin(),
+    m_worker(0),
+    m_workerEnabled(false),
+    m_workerIdleTimeout(60)
 {
 }
 
 ExternalServicePlugin::ExternalServicePlugin(const QString &id, const QString &fileName, QObject *parent) :
     QObject(parent),
     ServicePlugin(),
+    m_worker(0),
     m_fileName(fileName),
-    m_id(id)
+    m_id(id),
+    m_workerEnabled(false),
+    m_workerIdleTimeout(60)
 {
 }
 
@@ -48,6 +55,39 @@ void ExternalServicePlugin::setId(const QString &id) {
     m_id = id;
 }
 
+bool ExternalServicePlugin::workerEnabled() const {
+    return m_workerEnabled;
+}
+
+void ExternalServicePlugin::setWorkerEnabled(bool enabled) {
+    m_workerEnabled = enabled;
+}
+
+int ExternalServicePlugin::workerIdleTimeout() const {
+    return m_workerIdleTimeout;
+}
+
+void ExternalServicePlugin::setWorkerIdleTimeout(int timeout) {
+    m_workerIdleTimeout = timeout;
+    
+    if (m_worker) {
+        m_worker->setIdleTimeout(timeout);
+    }
+}
+
 ResourcesRequest* ExternalServicePlugin::createRequest(QObject *parent) {
+    if (workerEnabled()) {
+        return new ExternalResourcesRequest(worker(), parent);
+    }
+    
     return new ExternalResourcesRequest(id(), fileName(), parent);
 }
+
+ExternalPluginWorker* ExternalServicePlugin::worker() {
+    if (!m_worker) {
+        m_worker = new ExternalPluginWorker(id(), fileName(), this);
+        m_worker->setIdleTimeout(workerIdleTimeout());
+    }
+    
+    return m_worker;
+}
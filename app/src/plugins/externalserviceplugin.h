@@ -20,12 +20,16 @@
 
 #include "serviceplugin.h"
 
+class ExternalPluginWorker;
+
 class ExternalServicePlugin : public QObject, public ServicePlugin
 {
     Q_OBJECT
 
     Q_PROPERTY(QString fileName READ fileName WRITE setFileName)
     Q_PROPERTY(QString id READ id WRITE setId)
+    Q_PROPERTY(bool workerEnabled READ workerEnabled WRITE setWorkerEnabled)
+    Q_PROPERTY(int workerIdleTimeout READ workerIdleTimeout WRITE setWorkerIdleTimeout)
     
     Q_INTERFACES(ServicePlugin)
 
@@ -39,11 +43,24 @@ public:
     QString id() const;
     void setId(const QString &id);
     
+    bool workerEnabled() const;
+    void setWorkerEnabled(bool enabled);
+    
+    int workerIdleTimeout() const;
+    void setWorkerIdleTimeout(int timeout);
+    
     virtual ResourcesRequest* createRequest(QObject *parent = 0);
 
 private:
+    ExternalPluginWorker* worker();
+    
+    ExternalPluginWorker *m_worker;
+    
     QString m_fileName;
     QString m_id;
+    
+    bool m_workerEnabled;
+    int m_workerIdleTimeout;
 };
 
 #endif // EXTERNALSERVICEPLUGIN_H
@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef HTMLEXTRACTOR_H
+#define HTMLEXTRACTOR_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QQueue>
+#include <QString>
+#include <QVector>
+
+/*
+ * Extracts fields from an HTML page in one pass over its UTF-8 bytes.
+ *
+ * A field is the text following one or more markers (each searched for after the previous one) up to an end marker,
+ * so addField("title", QList<QByteArray>() << "<h1" << ">", "<") gives the same value as
+ * page.section("<h1", 1, 1).section(">", 1, 1).section("<", 0, 0) in the common case. All markers are matched
+ * together, so the cost of extract() does not grow with the number of fields, and only field values are converted
+ * to QString.
+ *
+ * Page fields take their first match in the whole page. If a record marker is set, Record fields are extracted
+ * again after each occurrence of it, which replaces page.split(marker). A field with an empty end marker runs to the
+ * end of its record or page.
+ *
+ * Extractors are usually declared once, as static constants, and shared by all requests.
+ */
+class HtmlExtractor
+{
+
+public:
+    enum Scope {
+        Page = 0,
+        Record
+    };
+    
+    typedef QHash<QString, QString> Fields;
+    
+    HtmlExtractor();
+    explicit HtmlExtractor(const QByteArray &recordMarker);
+    
+    QByteArray recordMarker() const;
+    HtmlExtractor& setRecordMarker(const QByteArray &marker);
+    
+    HtmlExtractor& addField(const QString &name, const QByteArray &marker, const QByteArray &end,
+                            Scope scope = Page);
+    HtmlExtractor& addField(const QString &name, const QList<QByteArray> &markers, const QByteArray &end,
+                            Scope scope = Page);
+    
+    Fields extract(const QByteArray &page, QList<Fields> *records = 0) const;
+
+private:
+    struct Field {
+        QString name;
+        QList<int> markers;
+        int end;
+        Scope scope;
+    };
+    
+    struct FieldState {
+        int stage;
+        int from;
+        int start;
+        bool done;
+    };
+    
+    struct Transition {
+        uchar byte;
+        int node;
+    };
+    
+    struct Node {
+        Node() : fail(0), pattern(-1), output(-1) {}
+        
+        QVector<Transition> transitions;
+        int fail;
+        int pattern;
+        int output;
+    };
+    
+    int addPattern(const QByteArray &pattern);
+    
+    int child(int node, uchar byte) const;
+    int step(int node, uchar byte) const;
+    
+    void compile();
+    
+    void reset(QVector<FieldState> &states, Scope scope, int from) const;
+    void close(const QByteArray &page, QVector<FieldState> &states, Fields &fields, Scope scope, int end) const;
+    
+    QList<QByteArray> m_patterns;
+    QHash<QByteArray, int> m_patternIndex;
+    
+    QList<Field> m_fields;
+    
+    QVector< QList< QPair<int, int> > > m_starts;
+    QVector< QList<int> > m_ends;
+    
+    QVector<Node> m_nodes;
+    
+    int m_record;
+};
+
+inline HtmlExtractor::HtmlExtractor() :
+    m_record(-1)
+{
+    compile();
+}
+
+inline HtmlExtractor::HtmlExtractor(const QByteArray &recordMarker) :
+    m_record(-1)
+{
+    setRecordMarker(recordMarker);
+}
+
+inline QByteArray HtmlExtractor::recordMarker() const {
+    return m_record >= 0 ? m_patterns.at(m_record) : QByteArray();
+}
+
+inline HtmlExtractor& HtmlExtractor::setRecordMarker(const QByteArray &marker) {
+    m_record = marker.isEmpty() ? -1 : addPattern(marker);
+    compile();
+    return *this;
+}
+
+inline HtmlExtractor& HtmlExtractor::addField(const QString &name, const QByteArray &marker, const QByteArray &end,
+                                              Scope scope) {
+    return addField(name, QList<QByteArray>() << marker, end, scope);
+}
+
+inline HtmlExtractor& HtmlExtractor::addField(const QString &name, const QList<QByteArray> &markers,
+                                              const QByteArray &end, Scope scope) {
+    Field field;
+    field.name = name;
+    field.end = end.isEmpty() ? -1 : addPattern(end);
+    field.scope = scope;
+    
+    foreach (const QByteArray &marker, markers) {
+        if (!marker.isEmpty()) {
+            field.markers << addPattern(marker);
+        }
+    }
+    
+    m_fields << field;
+    compile();
+    return *this;
+}
+
+inline HtmlExtractor::Fields HtmlExtractor::extract(const QByteArray &page, QList<Fields> *records) const {
+    Fields fields;
+    Fields record;
+    QVector<FieldState> states(m_fields.size());
+    reset(states, Page, 0);
+    reset(states, Record, 0);
+    bool inRecord = false;
+    const char *data = page.constData();
+    const int size = page.size();
+    int node = 0;
+    
+    for (int i = 0; i < size; i++) {
+        node = step(node, uchar(data[i]));
+        
+        for (int n = m_nodes.at(node).pattern >= 0 ? node : m_nodes.at(node).output; n > 0;
+             n = m_nodes.at(n).output) {
+            const int pattern = m_nodes.at(n).pattern;
+            const int matchStart = i - m_patterns.at(pattern).size() + 1;
+            
+            if (pattern == m_record) {
+                if (inRecord) {
+                    close(page, states, record, Record, matchStart);
+                    
+                    if (records) {
+                        records->append(record);
+                    }
+                    
+                    record.clear();
+                }
+                
+                inRecord = true;
+                reset(states, Record, i + 1);
+            }
+            
+            foreach (int f, m_ends.at(pattern)) {
+                FieldState &state = states[f];
+                
+                if ((!state.done) && (state.stage == m_fields.at(f).markers.size()) && (matchStart >= state.start)) {
+                    const QString value = QString::fromUtf8(data + state.start, matchStart - state.start);
+                    
+                    if (m_fields.at(f).scope == Page) {
+                        fields[m_fields.at(f).name] = value;
+                    }
+                    else {
+                        record[m_fields.at(f).name] = value;
+                    }
+                    
+                    state.done = true;
+                }
+            }
+            
+            for (int j = 0; j < m_starts.at(pattern).size(); j++) {
+                const int f = m_starts.at(pattern).at(j).first;
+                FieldState &state = states[f];
+                
+                if ((!state.done) && (state.stage == m_starts.at(pattern).at(j).second) && (matchStart >= state.from)
+                    && ((inRecord) || (m_fields.at(f).scope == Page))) {
+                    state.from = i + 1;
+                    
+                    if (++state.stage == m_fields.at(f).markers.size()) {
+                        state.start = i + 1;
+                    }
+                }
+            }
+        }
+    }
+    
+    if (inRecord) {
+        close(page, states, record, Record, size);
+        
+        if (records) {
+            records->append(record);
+        }
+    }
+    
+    close(page, states, fields, Page, size);
+    return fields;
+}
+
+inline int HtmlExtractor::addPattern(const QByteArray &pattern) {
+    if (m_patternIndex.contains(pattern)) {
+        return m_patternIndex.value(pattern);
+    }
+    
+    const int index = m_patterns.size();
+    m_patterns << pattern;
+    m_patternIndex[pattern] = index;
+    return index;
+}
+
+inline int HtmlExtractor::child(int node, uchar byte) const {
+    foreach (const Transition &transition, m_nodes.at(node).transitions) {
+        if (transition.byte == byte) {
+            return transition.node;
+        }
+    }
+    
+    return -1;
+}
+
+inline int HtmlExtractor::step(int node, uchar byte) const {
+    forever {
+        const int next = child(node, byte);
+        
+        if (next >= 0) {
+            return next;
+        }
+        
+        if (node == 0) {
+            return 0;
+        }
+        
+        node = m_nodes.at(node).fail;
+    }
+}
+
+inline void HtmlExtractor::compile() {
+    // Build an Aho-Corasick automaton over all markers, so that every marker is found in a single pass
+    m_nodes.clear();
+    m_nodes.append(Node());
+    
+    for (int p = 0; p < m_patterns.size(); p++) {
+        const QByteArray &pattern = m_patterns.at(p);
+        int node = 0;
+        
+        for (int i = 0; i < pattern.size(); i++) {
+            int next = child(node, uchar(pattern.at(i)));
+            
+            if (next < 0) {
+                next = m_nodes.size();
+                m_nodes.append(Node());
+                Transition transition;
+                transition.byte = uchar(pattern.at(i));
+                transition.node = next;
+                m_nodes[node].transitions.append(transition);
+            }
+            
+            node = next;
+        }
+        
+        m_nodes[node].pattern = p;
+    }
+    
+    QQueue<int> queue;
+    
+    foreach (const Transition &transition, m_nodes.at(0).transitions) {
+        queue.enqueue(transition.node);
+    }
+    
+    while (!queue.isEmpty()) {
+        const int node = queue.dequeue();
+        
+        foreach (const Transition &transition, m_nodes.at(node).transitions) {
+            int fail = m_nodes.at(node).fail;
+            
+            while ((fail > 0) && (child(fail, transition.byte) < 0)) {
+                fail = m_nodes.at(fail).fail;
+            }
+            
+            const int next = child(fail, transition.byte);
+            Node &target = m_nodes[transition.node];
+            target.fail = ((next >= 0) && (next != transition.node)) ? next : 0;
+            target.output = m_nodes.at(target.fail).pattern >= 0 ? target.fail : m_nodes.at(target.fail).output;
+            queue.enqueue(transition.node);
+        }
+    }
+    
+    m_starts.fill(QList< QPair<int, int> >(), m_patterns.size());
+    m_ends.fill(QList<int>(), m_patterns.size());
+    
+    for (int f = 0; f < m_fields.size(); f++) {
+        const Field &field = m_fields.at(f);
+        
+        for (int stage = 0; stage < field.markers.size(); stage++) {
+            m_starts[field.markers.at(stage)] << qMakePair(f, stage);
+        }
+        
+        if (field.end >= 0) {
+            m_ends[field.end] << f;
+        }
+    }
+}
+
+inline void HtmlExtractor::reset(QVector<FieldState> &states, Scope scope, int from) const {
+    for (int f = 0; f < m_fields.size(); f++) {
+        if (m_fields.at(f).scope == scope) {
+            FieldState &state = states[f];
+            state.stage = 0;
+            state.from = from;
+            state.start = from;
+            state.done = false;
+        }
+    }
+}
+
+inline void HtmlExtractor::close(const QByteArray &page, QVector<FieldState> &states, Fields &fields, Scope scope,
+                                 int end) const {
+    // Fields without an end marker run to the end of their record or page. Other unfinished fields are dropped.
+    for (int f = 0; f < m_fields.size(); f++) {
+        const Field &field = m_fields.at(f);
+        FieldState &state = states[f];
+        
+        if ((field.scope == scope) && (field.end < 0) && (!state.done) && (state.stage == field.markers.size())
+            && (end >= state.start)) {
+            fields[field.name] = QString::fromUtf8(page.constData() + state.start, end - state.start);
+            state.done = true;
+        }
+    }
+}
+
+#endif // HTMLEXTRACTOR_H
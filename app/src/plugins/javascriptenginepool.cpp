@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "javascriptenginepool.h"
+#include "javascriptresourcesrequestglobalobject.h"
+#include "logger.h"
+#include "pluginsettings.h"
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QScriptEngine>
+
+JavaScriptEnginePool::JavaScriptEnginePool(const QString &id, const QString &fileName, QObject *parent) :
+    QObject(parent),
+    m_fileName(fileName),
+    m_id(id),
+    m_compiled(false),
+    m_maximumIdle(2)
+{
+}
+
+QString JavaScriptEnginePool::fileName() const {
+    return m_fileName;
+}
+
+QString JavaScriptEnginePool::id() const {
+    return m_id;
+}
+
+int JavaScriptEnginePool::maximumIdleEngines() const {
+    return m_maximumIdle;
+}
+
+void JavaScriptEnginePool::setMaximumIdleEngines(int maximum) {
+    m_maximumIdle = qMax(0, maximum);
+    
+    while (m_idle.size() > m_maximumIdle) {
+        destroy(m_idle.takeLast());
+    }
+}
+
+QNetworkAccessManager* JavaScriptEnginePool::networkAccessManager() const {
+    return m_nam;
+}
+
+void JavaScriptEnginePool::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
+
+QScriptEngine* JavaScriptEnginePool::acquire() {
+    if (!m_idle.isEmpty()) {
+        Logger::log("JavaScriptEnginePool::acquire(). Using idle engine for plugin " + id(), Logger::HighVerbosity);
+        return m_idle.takeLast();
+    }
+    
+    if (!compile()) {
+        return 0;
+    }
+    
+    Logger::log("JavaScriptEnginePool::acquire(). Creating engine for plugin " + id(), Logger::MediumVerbosity);
+    QScriptEngine *engine = new QScriptEngine(this);
+    m_globals[engine] = engine->globalObject();
+    
+    if (!prepare(engine)) {
+        destroy(engine);
+        return 0;
+    }
+    
+    return engine;
+}
+
+void JavaScriptEnginePool::release(QScriptEngine *engine, bool reuse) {
+    if (!engine) {
+        return;
+    }
+    
+    // Engines with calls in progress are not reused, as their callbacks could still run
+    if ((!reuse) || (m_idle.size() >= m_maximumIdle)) {
+        destroy(engine);
+        return;
+    }
+    
+    if (JavaScriptResourcesRequestGlobalObject *global =
+        qobject_cast<JavaScriptResourcesRequestGlobalObject*>(engine->globalObject().toQObject())) {
+        engine->setGlobalObject(m_globals.value(engine));
+        delete global;
+    }
+    
+    if (prepare(engine)) {
+        m_idle << engine;
+    }
+    else {
+        destroy(engine);
+    }
+}
+
+bool JavaScriptEnginePool::compile() {
+    if (m_compiled) {
+        return true;
+    }
+    
+    QFile file(fileName());
+    
+    if (!file.open(QFile::ReadOnly)) {
+        Logger::log("JavaScriptEnginePool::compile(): Error reading JavaScript file: " + file.errorString());
+        return false;
+    }
+    
+    m_program = QScriptProgram(QString::fromUtf8(file.readAll()), fileName());
+    file.close();
+    m_compiled = true;
+    Logger::log("JavaScriptEnginePool::compile(). JavaScript file read OK: " + fileName(), Logger::MediumVerbosity);
+    return true;
+}
+
+bool JavaScriptEnginePool::prepare(QScriptEngine *engine) {
+    const QScriptValue result = engine->evaluate(m_program);
+    
+    if (result.isError()) {
+        Logger::log("JavaScriptEnginePool::prepare(): Error evaluating JavaScript file: " + result.toString());
+        return false;
+    }
+    
+    JavaScriptResourcesRequestGlobalObject *global = new JavaScriptResourcesRequestGlobalObject(engine, m_nam);
+    engine->installTranslatorFunctions();
+    engine->globalObject().setProperty("settings", engine->newQObject(new PluginSettings(id(), global)));
+    return true;
+}
+
+void JavaScriptEnginePool::destroy(QScriptEngine *engine) {
+    m_globals.remove(engine);
+    delete engine;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JAVASCRIPTENGINEPOOL_H
+#define JAVASCRIPTENGINEPOOL_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QScriptProgram>
+#include <QScriptValue>
+
+class QNetworkAccessManager;
+class QScriptEngine;
+
+/*
+ * Provides evaluated script engines for the requests of a JavaScript plugin.
+ *
+ * The plugin file is read and compiled once. Engines that are released are reset (the global object is replaced and
+ * the compiled program evaluated again), and kept until they are acquired by another request.
+ */
+class JavaScriptEnginePool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit JavaScriptEnginePool(const QString &id, const QString &fileName, QObject *parent = 0);
+    
+    QString fileName() const;
+    
+    QString id() const;
+    
+    int maximumIdleEngines() const;
+    void setMaximumIdleEngines(int maximum);
+    
+    QNetworkAccessManager* networkAccessManager() const;
+    void setNetworkAccessManager(QNetworkAccessManager *manager);
+    
+    QScriptEngine* acquire();
+    void release(QScriptEngine *engine, bool reuse = true);
+
+private:
+    bool compile();
+    bool prepare(QScriptEngine *engine);
+    
+    void destroy(QScriptEngine *engine);
+    
+    QString m_fileName;
+    QString m_id;
+    
+    QScriptProgram m_program;
+    
+    bool m_compiled;
+    
+    int m_maximumIdle;
+    
+    QPointer<QNetworkAccessManager> m_nam;
+    
+    QList<QScriptEngine*> m_idle;
+    
+    QHash<QScriptEngine*, QScriptValue> m_globals;
+};
+
+#endif // JAVASCRIPTENGINEPOOL_H
@@ -15,21 +15,26 @@
  */
 
 #include "javascriptresourcesrequest.h"
+#include "javascriptenginepool.h"
 #include "logger.h"
-#include "pluginsettings.h"
-#include <QFile>
 #include <QScriptEngine>
 
-JavaScriptResourcesRequest::JavaScriptResourcesRequest(const QString &id, const QString &fileName, QObject *parent) :
+JavaScriptResourcesRequest::JavaScriptResourcesRequest(JavaScriptEnginePool *pool, QObject *parent) :
     ResourcesRequest(parent),
-    m_global(0),
+    m_pool(pool),
     m_engine(0),
-    m_fileName(fileName),
-    m_id(id),
-    m_evaluated(false)
+    m_fileName(pool->fileName()),
+    m_id(pool->id()),
+    m_status(Null)
 {
 }
 
+JavaScriptResourcesRequest::~JavaScriptResourcesRequest() {
+    if ((m_pool) && (m_engine)) {
+        m_pool->release(m_engine, status() != Loading);
+    }
+}
+
 QString JavaScriptResourcesRequest::fileName() const {
     return m_fileName;
 }
@@ -65,41 +70,29 @@ void JavaScriptResourcesRequest::setStatus(ResourcesRequest::Status s) {
     }
 }
 
-void JavaScriptResourcesRequest::initEngine() {
-    if (m_evaluated) {
-        return;
+bool JavaScriptResourcesRequest::initEngine() {
+    if (m_engine) {
+        return true;
     }
     
-    if (!m_engine) {
-        m_engine = new QScriptEngine(this);
+    if (!m_pool) {
+        return false;
     }
-
-    QFile file(fileName());
     
-    if (file.open(QFile::ReadOnly)) {
-        const QScriptValue result = m_engine->evaluate(file.readAll(), fileName());
-        file.close();
-        
-        if (result.isError()) {
-            Logger::log("JavaScriptResourcesRequest::initEngine(): Error evaluating JavaScript file: "
-                        + result.toString());
-            return;
-        }
-        
-        Logger::log("JavaScriptResourcesRequest::initEngine(): JavaScript file evaluated OK", Logger::MediumVerbosity);
-        m_evaluated = true;
-        m_global = new JavaScriptResourcesRequestGlobalObject(m_engine);
-        
-        connect(m_global, SIGNAL(error(QString)), this, SLOT(onRequestError(QString)));
-        connect(m_global, SIGNAL(finished(QVariant)), this, SLOT(onRequestFinished(QVariant)));
-        
-        m_engine->installTranslatorFunctions();
-        m_engine->globalObject().setProperty("settings", m_engine->newQObject(new PluginSettings(id(), m_engine)));
+    // The engine is kept until the request is deleted, as plugins may keep state between calls
+    m_engine = m_pool->acquire();
+    
+    if (!m_engine) {
+        return false;
     }
-    else {
-        Logger::log("JavaScriptResourcesRequest::initEngine(): Error reading JavaScript file: "
-                    + file.errorString());
+    
+    if (JavaScriptResourcesRequestGlobalObject *global =
+        qobject_cast<JavaScriptResourcesRequestGlobalObject*>(m_engine->globalObject().toQObject())) {
+        connect(global, SIGNAL(error(QString)), this, SLOT(onRequestError(QString)));
+        connect(global, SIGNAL(finished(QVariant)), this, SLOT(onRequestFinished(QVariant)));
     }
+    
+    return true;
 }
 
 bool JavaScriptResourcesRequest::cancel() {
@@ -116,7 +109,13 @@ bool JavaScriptResourcesRequest::del(const QString &sourceType, const QString &s
         return false;
     }
     
-    initEngine();
+    if (!initEngine()) {
+        setErrorString(tr("Cannot load JavaScript file"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
     QScriptValue func = m_engine->globalObject().property("del");
 
     if (func.isFunction()) {
@@ -153,7 +152,13 @@ bool JavaScriptResourcesRequest::get(const QString &resourceType, const QString
         return false;
     }
     
-    initEngine();
+    if (!initEngine()) {
+        setErrorString(tr("Cannot load JavaScript file"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
     QScriptValue func = m_engine->globalObject().property("get");
 
     if (func.isFunction()) {
@@ -190,7 +195,13 @@ bool JavaScriptResourcesRequest::insert(const QString &sourceType, const QString
         return false;
     }
     
-    initEngine();
+    if (!initEngine()) {
+        setErrorString(tr("Cannot load JavaScript file"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
     QScriptValue func = m_engine->globalObject().property("insert");
 
     if (func.isFunction()) {
@@ -227,7 +238,13 @@ bool JavaScriptResourcesRequest::list(const QString &resourceType, const QString
         return false;
     }
     
-    initEngine();
+    if (!initEngine()) {
+        setErrorString(tr("Cannot load JavaScript file"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
     QScriptValue func = m_engine->globalObject().property("list");
 
     if (func.isFunction()) {
@@ -263,7 +280,13 @@ bool JavaScriptResourcesRequest::search(const QString &resourceType, const QStri
         return false;
     }
     
-    initEngine();
+    if (!initEngine()) {
+        setErrorString(tr("Cannot load JavaScript file"));
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
     QScriptValue func = m_engine->globalObject().property("search");
 
     if (func.isFunction()) {
@@ -19,7 +19,9 @@
 
 #include "resourcesrequest.h"
 #include "javascriptresourcesrequestglobalobject.h"
+#include <QPointer>
 
+class JavaScriptEnginePool;
 class QScriptEngine;
 
 class JavaScriptResourcesRequest : public ResourcesRequest
@@ -30,7 +32,8 @@ class JavaScriptResourcesRequest : public ResourcesRequest
     Q_PROPERTY(QString id READ id)
 
 public:
-    explicit JavaScriptResourcesRequest(const QString &id, const QString &fileName, QObject *parent = 0);
+    explicit JavaScriptResourcesRequest(JavaScriptEnginePool *pool, QObject *parent = 0);
+    ~JavaScriptResourcesRequest();
 
     QString fileName() const;
 
@@ -63,10 +66,10 @@ private:
     
     void setStatus(Status s);
     
-    void initEngine();
+    bool initEngine();
     
-    JavaScriptResourcesRequestGlobalObject *m_global;
-    QScriptEngine *m_engine;
+    QPointer<JavaScriptEnginePool> m_pool;
+    QPointer<QScriptEngine> m_engine;
     
     QString m_fileName;
     QString m_id;
@@ -76,8 +79,6 @@ private:
     QVariant m_result;
 
     Status m_status;
-    
-    bool m_evaluated;
 };
 
 #endif // JAVASCRIPTSERVICEPLUGIN_H
@@ -21,9 +21,10 @@
 #include <QScriptValueIterator>
 #include <QTimerEvent>
 
-JavaScriptResourcesRequestGlobalObject::JavaScriptResourcesRequestGlobalObject(QScriptEngine *engine) :
+JavaScriptResourcesRequestGlobalObject::JavaScriptResourcesRequestGlobalObject(QScriptEngine *engine,
+                                                                               QNetworkAccessManager *manager) :
     QObject(engine),
-    m_nam(0),
+    m_nam(manager),
     m_engine(engine)
 {
     QScriptValue oldGlobal = engine->globalObject();
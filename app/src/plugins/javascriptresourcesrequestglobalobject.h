@@ -28,7 +28,7 @@ class JavaScriptResourcesRequestGlobalObject : public QObject
     Q_OBJECT
 
 public:
-    explicit JavaScriptResourcesRequestGlobalObject(QScriptEngine *engine);
+    explicit JavaScriptResourcesRequestGlobalObject(QScriptEngine *engine, QNetworkAccessManager *manager = 0);
 
 public Q_SLOTS:
     QString atob(const QString &ascii) const;
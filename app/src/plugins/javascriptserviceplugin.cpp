@@ -16,17 +16,21 @@
  */
 
 #include "javascriptserviceplugin.h"
+#include "javascriptenginepool.h"
 #include "javascriptresourcesrequest.h"
+#include <QNetworkAccessManager>
 
 JavaScriptServicePlugin::JavaScriptServicePlugin(QObject *parent) :
     QObject(parent),
-    ServicePlugin()
+    ServicePlugin(),
+    m_pool(0)
 {
 }
 
 JavaScriptServicePlugin::JavaScriptServicePlugin(const QString &id, const QString &fileName, QObject *parent) :
     QObject(parent),
     ServicePlugin(),
+    m_pool(0),
     m_fileName(fileName),
     m_id(id)
 {
@@ -37,7 +41,14 @@ QString JavaScriptServicePlugin::fileName() const {
 }
 
 void JavaScriptServicePlugin::setFileName(const QString &fileName) {
-    m_fileName = fileName;
+    if (fileName != m_fileName) {
+        m_fileName = fileName;
+        
+        if (m_pool) {
+            delete m_pool;
+            m_pool = 0;
+        }
+    }
 }
 
 QString JavaScriptServicePlugin::id() const {
@@ -45,9 +56,33 @@ QString JavaScriptServicePlugin::id() const {
 }
 
 void JavaScriptServicePlugin::setId(const QString &id) {
-    m_id = id;
+    if (id != m_id) {
+        m_id = id;
+        
+        if (m_pool) {
+            delete m_pool;
+            m_pool = 0;
+        }
+    }
 }
 
 ResourcesRequest* JavaScriptServicePlugin::createRequest(QObject *parent) {
-    return new JavaScriptResourcesRequest(id(), fileName(), parent);
+    return new JavaScriptResourcesRequest(enginePool(), parent);
+}
+
+void JavaScriptServicePlugin::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+    
+    if (m_pool) {
+        m_pool->setNetworkAccessManager(manager);
+    }
+}
+
+JavaScriptEnginePool* JavaScriptServicePlugin::enginePool() {
+    if (!m_pool) {
+        m_pool = new JavaScriptEnginePool(id(), fileName(), this);
+        m_pool->setNetworkAccessManager(m_nam);
+    }
+    
+    return m_pool;
 }
@@ -19,6 +19,9 @@
 #define JAVASCRIPTSERVICEPLUGIN_H
 
 #include "serviceplugin.h"
+#include <QPointer>
+
+class JavaScriptEnginePool;
 
 class JavaScriptServicePlugin : public QObject, public ServicePlugin
 {
@@ -40,8 +43,16 @@ public:
     void setId(const QString &id);
     
     virtual ResourcesRequest* createRequest(QObject *parent = 0);
+    
+    virtual void setNetworkAccessManager(QNetworkAccessManager *manager);
 
 private:
+    JavaScriptEnginePool* enginePool();
+    
+    JavaScriptEnginePool *m_pool;
+    
+    QPointer<QNetworkAccessManager> m_nam;
+    
     QString m_fileName;
     QString m_id;
 };
@@ -40,6 +40,16 @@ QString PluginCommentModel::errorString() const {
     return m_request ? m_request->errorString() : QString();
 }
 
+int PluginCommentModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void PluginCommentModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
+    }
+}
+
 QString PluginCommentModel::service() const {
     return m_service;
 }
@@ -55,10 +65,20 @@ void PluginCommentModel::setService(const QString &s) {
             m_request->deleteLater();
             m_request = 0;
         }
+        
+        if (m_prefetchReply) {
+            m_prefetchReply->cancel();
+            m_prefetchReply->deleteLater();
+            m_prefetchReply = 0;
+        }
     }
 }
 
 ResourcesRequest::Status PluginCommentModel::status() const {
+    if (m_prefetcher.isWanted()) {
+        return ResourcesRequest::Loading;
+    }
+    
     return m_request ? m_request->status() : ResourcesRequest::Null;
 }
 
@@ -81,6 +101,18 @@ void PluginCommentModel::fetchMore(const QModelIndex &) {
         return;
     }
 
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if ((m_prefetchReply) && (m_prefetchReply->status() == ResourcesRequest::Loading)) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
     if (ResourcesRequest *r = request()) {
         r->list(Resources::COMMENT, m_next);
         emit statusChanged(status());
@@ -173,6 +205,12 @@ void PluginCommentModel::search(const QString &query, const QString &order) {
 }
 
 void PluginCommentModel::clear() {
+    m_prefetcher.clear();
+    
+    if (m_prefetchReply) {
+        m_prefetchReply->cancel();
+    }
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -187,6 +225,16 @@ void PluginCommentModel::cancel() {
     if (m_request) {
         m_request->cancel();
     }
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        
+        if (m_prefetchReply) {
+            m_prefetchReply->cancel();
+        }
+        
+        emit statusChanged(status());
+    }
 }
 
 void PluginCommentModel::reload() {
@@ -234,6 +282,46 @@ void PluginCommentModel::remove(int row) {
     }
 }
 
+void PluginCommentModel::addComments(const QVariantMap &result) {
+    m_next = result.value("next").toString();
+    const QVariantList list = result.value("items").toList();
+    
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+    
+    foreach (const QVariant &item, list) {
+        m_items << new PluginComment(service(), item.toMap(), this);
+    }
+    
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
+void PluginCommentModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((m_next.isEmpty()) || (status() == ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), m_next))) {
+        return;
+    }
+    
+    if (m_prefetchReply) {
+        m_prefetchReply->cancel();
+        m_prefetchReply->deleteLater();
+    }
+    
+    Logger::log("PluginCommentModel::setVisibleRange(). Prefetching resource ID: " + m_next, Logger::HighVerbosity);
+    m_prefetchReply = PluginManager::instance()->list(service(), Resources::COMMENT, m_next, this);
+    
+    if (m_prefetchReply) {
+        connect(m_prefetchReply, SIGNAL(finished()), this, SLOT(onPrefetchReplyFinished()));
+    }
+}
+
+void PluginCommentModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed
+    addComments(m_prefetcher.takeResult());
+    emit statusChanged(status());
+}
+
 ResourcesRequest* PluginCommentModel::request() {
     if (!m_request) {
         m_request = PluginManager::instance()->createRequestForService(service(), this);
@@ -251,23 +339,45 @@ void PluginCommentModel::onRequestFinished() {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_next = result.value("next").toString();
-            const QVariantList list = result.value("items").toList();
+            addComments(result);
+        }
+    }
+    else {
+        Logger::log("PluginCommentModel::onRequestFinished(). Error: " + errorString());
+    }
+    
+    emit statusChanged(status());
+}
 
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+void PluginCommentModel::onPrefetchReplyFinished() {
+    ResourcesReply *reply = qobject_cast<ResourcesReply*>(sender());
+    
+    // Replies of superseded prefetches are already scheduled for deletion
+    if ((!reply) || (reply != m_prefetchReply)) {
+        return;
+    }
     
-            foreach (const QVariant &item, list) {
-                m_items << new PluginComment(service(), item.toMap(), this);
+    m_prefetchReply = 0;
+    reply->deleteLater();
+    
+    if (reply->status() == ResourcesRequest::Ready) {
+        const QVariantMap result = reply->result().toMap();
+        
+        if (!result.isEmpty()) {
+            if (m_prefetcher.setResult(result)) {
+                addPrefetchResult();
             }
-
-            endInsertRows();
-            emit countChanged(rowCount());
-                
+            
+            return;
         }
     }
     else {
-        Logger::log("PluginCommentModel::onRequestFinished(). Error: " + errorString());
+        Logger::log("PluginCommentModel::onPrefetchReplyFinished(). Error: " + reply->errorString());
     }
     
-    emit statusChanged(status());
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
 }
@@ -19,8 +19,12 @@
 #define PLUGINCOMMENTMODEL_H
 
 #include <QAbstractListModel>
+#include <QPointer>
+#include "pageprefetcher.h"
 #include "plugincomment.h"
 
+class ResourcesReply;
+
 class PluginCommentModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -28,6 +32,8 @@ class PluginCommentModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QString service READ service WRITE setService NOTIFY serviceChanged)
     Q_PROPERTY(ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
@@ -46,6 +52,9 @@ public:
         
     QString errorString() const;
 
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
     QString service() const;
     void setService(const QString &s);
     
@@ -75,11 +84,15 @@ public Q_SLOTS:
     void cancel();
     void reload();
     
+    void setVisibleRange(int first, int last);
+    
 private Q_SLOTS:
     void onRequestFinished();
+    void onPrefetchReplyFinished();
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void serviceChanged();
     void statusChanged(ResourcesRequest::Status s);
     
@@ -87,10 +100,15 @@ private:
     void append(PluginComment *comment);
     void insert(int row, PluginComment *comment);
     void remove(int row);
+    
+    void addComments(const QVariantMap &result);
+    
+    void addPrefetchResult();
 
     ResourcesRequest* request();
     
     ResourcesRequest *m_request;
+    QPointer<ResourcesReply> m_prefetchReply;
 
     QString m_service;
     QString m_resourceId;
@@ -98,6 +116,8 @@ private:
     QString m_order;
     QString m_next;
         
+    PagePrefetcher m_prefetcher;
+    
     QList<PluginComment*> m_items;
     
     QHash<int, QByteArray> m_roles;
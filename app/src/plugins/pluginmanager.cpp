@@ -20,20 +20,67 @@
 #include "externalserviceplugin.h"
 #include "javascriptserviceplugin.h"
 #include "logger.h"
+#include "pluginnetworkaccessmanager.h"
+#include "pluginnetworkcache.h"
+#include "scraperserviceplugin.h"
+#include "urlrouter.h"
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QPluginLoader>
+#include <QUrl>
+#if QT_VERSION >= 0x050000
+#include <QtConcurrent/QtConcurrentMap>
+#else
+#include <QtConcurrentMap>
+#endif
 
 static bool displayNameLessThan(const ServicePluginPair &pair, const ServicePluginPair &other) {
     return QString::localeAwareCompare(pair.config->displayName(), other.config->displayName()) < 0;
 }
 
+static bool isHostOrSubdomain(const QString &host, const QString &domain) {
+    return (!domain.isEmpty()) && ((host == domain) || (host.endsWith("." + domain)));
+}
+
+static bool isPluginHost(const ServicePluginConfig *config, const QString &host) {
+    // The hosts of a plugin are those of its listed URLs and of the URLs that it matches, including subdomains
+    const QString h = host.toLower();
+    
+    foreach (const ListResource &resource, config->listResources()) {
+        if (isHostOrSubdomain(h, QUrl(resource.id()).host().toLower())) {
+            return true;
+        }
+    }
+    
+    foreach (const GetResource &resource, config->getResources()) {
+        if (isHostOrSubdomain(h, UrlRouter::hostFromPattern(resource.regExp().pattern()))) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+static QVariantMap parseManifest(const QString &filePath) {
+    // Configs that cannot be parsed are indexed as empty, so they are not parsed again until modified
+    bool ok;
+    const QVariantMap manifest = ServicePluginConfig::parse(filePath, &ok);
+    return ok ? manifest : QVariantMap();
+}
+
 PluginManager* PluginManager::self = 0;
 
 PluginManager::PluginManager(QObject *parent) :
     QObject(parent),
-    m_lastLoaded(QDateTime::fromTime_t(0))
+    m_lastLoaded(QDateTime::fromTime_t(0)),
+    m_index(PLUGIN_INDEX_PATH),
+    m_watcher(new QFutureWatcher<QVariantMap>(this)),
+    m_loadCount(0),
+    m_nam(0),
+    m_cache(0)
 {
+    connect(m_watcher, SIGNAL(finished()), this, SLOT(onManifestsParsed()));
 }
 
 PluginManager::~PluginManager() {
@@ -44,53 +91,122 @@ PluginManager* PluginManager::instance() {
     return self ? self : self = new PluginManager;
 }
 
+QNetworkAccessManager* PluginManager::networkAccessManager() {
+    if (!m_nam) {
+        m_nam = new PluginNetworkAccessManager(this);
+        m_cache = new PluginNetworkCache;
+        m_cache->setCacheDirectory(PLUGIN_CACHE_PATH);
+        m_cache->setMaximumCacheSize(PLUGIN_CACHE_SIZE);
+        m_nam->setCache(m_cache);
+    }
+    
+    return m_nam;
+}
+
 ServicePluginList PluginManager::plugins() const {
     return m_plugins;
 }
 
 ServicePluginConfig* PluginManager::getConfigForService(const QString &service) const {
-    foreach (const ServicePluginPair &pair, m_plugins) {
-        if (pair.config->id() == service) {
-            Logger::log("PluginManager::getConfigForService(). PluginFound: " + service, Logger::HighVerbosity);
-            return pair.config;
-        }
+    const int i = m_ids.value(service, -1);
+    return i >= 0 ? m_plugins.at(i).config : 0;
+}
+
+ServicePluginConfig* PluginManager::getConfigByFilePath(const QString &filePath) const {
+    const int i = m_filePaths.value(filePath, -1);
+    return i >= 0 ? m_plugins.at(i).config : 0;
+}
+
+ServicePlugin* PluginManager::getPluginForService(const QString &service) {
+    const int i = m_ids.value(service, -1);
+    
+    if (i < 0) {
+        return 0;
     }
     
-    Logger::log("PluginManager::getConfigForService(). No Plugin found", Logger::HighVerbosity);
+    ServicePluginPair &pair = m_plugins[i];
+    
+    // Only Qt plugins are registered without an instance. They are loaded on first use, and a library that fails
+    // to load is not tried again
+    if ((!pair.plugin) && (!pair.loadFailed)) {
+        pair.plugin = loadQtPlugin(pair.config);
+        pair.loadFailed = (pair.plugin == 0);
+    }
+    
+    return pair.plugin;
+}
+
+ResourcesRequest* PluginManager::createRequestForService(const QString &service, QObject *parent) {
+    if (ServicePlugin *plugin = getPluginForService(service)) {
+        return plugin->createRequest(parent);
+    }
+
     return 0;
 }
 
-ServicePluginConfig* PluginManager::getConfigByFilePath(const QString &filePath) const {
-    foreach (const ServicePluginPair &pair, m_plugins) {
-        if (pair.config->filePath() == filePath) {
-            Logger::log("PluginManager::getConfigByFilePath(). PluginFound: " + pair.config->id(),
-                        Logger::HighVerbosity);
-            return pair.config;
-        }
+ResourcesReply* PluginManager::createReplyForService(const QString &service, QObject *parent) {
+    if (ResourcesRequest *request = createRequestForService(service)) {
+        return new ResourcesReply(request, parent);
     }
     
-    Logger::log("PluginManager::getConfigByFilePath(). No Plugin found", Logger::HighVerbosity);
     return 0;
 }
 
-ServicePlugin* PluginManager::getPluginForService(const QString &service) const {
-    foreach (const ServicePluginPair &pair, m_plugins) {
-        if (pair.config->id() == service) {
-            Logger::log("PluginManager::getPluginForService(). PluginFound: " + service, Logger::HighVerbosity);
-            return pair.plugin;
-        }
+ResourcesReply* PluginManager::del(const QString &service, const QString &sourceType, const QString &sourceId,
+                                   const QString &destinationType, const QString &destinationId,
+                                   QObject *parent) {
+    ResourcesReply *reply = createReplyForService(service, parent);
+    
+    if (reply) {
+        reply->setStarted(reply->request()->del(sourceType, sourceId, destinationType, destinationId));
     }
     
-    Logger::log("PluginManager::getPluginForService(). No Plugin found", Logger::HighVerbosity);
-    return 0;
+    return reply;
 }
 
-ResourcesRequest* PluginManager::createRequestForService(const QString &service, QObject *parent) const {
-    if (ServicePlugin *plugin = getPluginForService(service)) {
-        return plugin->createRequest(parent);
+ResourcesReply* PluginManager::get(const QString &service, const QString &resourceType, const QString &resourceId,
+                                   QObject *parent) {
+    ResourcesReply *reply = createReplyForService(service, parent);
+    
+    if (reply) {
+        reply->setStarted(reply->request()->get(resourceType, resourceId));
     }
+    
+    return reply;
+}
 
-    return 0;
+ResourcesReply* PluginManager::insert(const QString &service, const QString &sourceType, const QString &sourceId,
+                                      const QString &destinationType, const QString &destinationId,
+                                      QObject *parent) {
+    ResourcesReply *reply = createReplyForService(service, parent);
+    
+    if (reply) {
+        reply->setStarted(reply->request()->insert(sourceType, sourceId, destinationType, destinationId));
+    }
+    
+    return reply;
+}
+
+ResourcesReply* PluginManager::list(const QString &service, const QString &resourceType, const QString &resourceId,
+                                    QObject *parent) {
+    ResourcesReply *reply = createReplyForService(service, parent);
+    
+    if (reply) {
+        reply->setStarted(reply->request()->list(resourceType, resourceId));
+    }
+    
+    return reply;
+}
+
+ResourcesReply* PluginManager::search(const QString &service, const QString &resourceType, const QString &query,
+                                      const QString &order, QObject *parent) {
+    ResourcesReply *reply = createReplyForService(service, parent);
+    
+    if (reply) {
+        reply->setStarted(reply->request()->search(resourceType, query, order));
+    }
+    
+    return reply;
 }
 
 bool PluginManager::resourceTypeIsSupported(const QString &service, const QString &resourceType,
@@ -102,63 +218,38 @@ bool PluginManager::resourceTypeIsSupported(const QString &service, const QStrin
     return false;
 }
 
-int PluginManager::load() {
+void PluginManager::load() {
+    if (!m_unindexed.isEmpty()) {
+        // The pending load emits loaded() when its configs have been parsed
+        return;
+    }
+    
     Logger::log("PluginManager::load(): Loading plugins modified since "
                 + m_lastLoaded.toString(Qt::ISODate), Logger::LowVerbosity);
+    const bool scanAll = (m_lastLoaded.toTime_t() == 0);
     int count = 0;
     QDir dir;
+    QSet<QString> found;
+    m_index.load();
     
     foreach (const QString &path, PLUGIN_PATHS) {
         dir.setPath(path);
         
         foreach (const QFileInfo &info, dir.entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Time)) {
             if (info.lastModified() > m_lastLoaded) {
-                ServicePluginConfig *config = getConfigByFilePath(info.absoluteFilePath());
+                const QString filePath = info.absoluteFilePath();
+                found << filePath;
                 
-                if (!config) {
-                    config = new ServicePluginConfig(this);
-                    
-                    if (config->load(info.absoluteFilePath())) {
-                        if (config->pluginType() == "qt") {
-                            QPluginLoader loader(config->pluginFilePath());
-                            QObject *obj = loader.instance();
-                            
-                            if (obj) {
-                                if (ServicePlugin *plugin = qobject_cast<ServicePlugin*>(obj)) {
-                                    m_plugins << ServicePluginPair(config, plugin);
-                                    ++count;
-                                    Logger::log("PluginManager::load(). Qt Plugin loaded: " + config->id(),
-                                                Logger::MediumVerbosity);
-                                }
-                                else {
-                                    loader.unload();
-                                    Logger::log("PluginManager::load(). Error loading Qt plugin: "
-                                                + config->id());
-                                }
-                            }
-                            else {
-                                Logger::log("PluginManager::load(). Qt plugin is NULL: " + config->id());
-                            }
-                        }
-                        else if (config->pluginType() == "js") {
-                            JavaScriptServicePlugin *js =
-                            new JavaScriptServicePlugin(config->id(), config->pluginFilePath(), this);
-                            m_plugins << ServicePluginPair(config, js);
+                if (!getConfigByFilePath(filePath)) {
+                    if (m_index.contains(filePath, info.lastModified())) {
+                        // Configs that have not changed are loaded straight away from the index
+                        if (loadPlugin(filePath)) {
                             ++count;
-                            Logger::log("PluginManager::load(). JavaScript plugin loaded: " + config->id(),
-                                        Logger::MediumVerbosity);
-                        }
-                        else {
-                            ExternalServicePlugin *ext =
-                            new ExternalServicePlugin(config->id(), config->pluginFilePath(), this);
-                            m_plugins << ServicePluginPair(config, ext);
-                            ++count;
-                            Logger::log("PluginManager::load(). External plugin loaded: " + config->id(),
-                                        Logger::MediumVerbosity);
                         }
                     }
                     else {
-                        delete config;
+                        m_unindexed << filePath;
+                        m_unindexedModified << info.lastModified();
                     }
                 }
             }
@@ -167,14 +258,195 @@ int PluginManager::load() {
             }
         }
     }
+    
+    if (scanAll) {
+        // Drop entries for configs that have been removed
+        m_index.retain(found);
+    }
+    
+    m_lastLoaded = QDateTime::currentDateTime();
+    
+    if (count > 0) {
+        qSort(m_plugins.begin(), m_plugins.end(), displayNameLessThan);
+        updateIndexes();
+    }
+    
+    if (m_unindexed.isEmpty()) {
+        finishLoad(count);
+        return;
+    }
+    
+    // Parse new and modified configs on worker threads. The plugins are added by onManifestsParsed()
+    Logger::log(QString("PluginManager::load(). Parsing %1 config files").arg(m_unindexed.size()),
+                Logger::MediumVerbosity);
+    m_loadCount = count;
+    m_watcher->setFuture(QtConcurrent::mapped(m_unindexed, parseManifest));
+}
 
-    Logger::log(QString("PluginManager::load() %1 plugins loaded").arg(count), Logger::LowVerbosity);
-
+void PluginManager::onManifestsParsed() {
+    const QFuture<QVariantMap> future = m_watcher->future();
+    int count = 0;
+    
+    for (int i = 0; i < m_unindexed.size(); i++) {
+        m_index.insert(m_unindexed.at(i), m_unindexedModified.at(i), future.resultAt(i));
+        
+        if (loadPlugin(m_unindexed.at(i))) {
+            ++count;
+        }
+    }
+    
+    m_unindexed.clear();
+    m_unindexedModified.clear();
+    
     if (count > 0) {
         qSort(m_plugins.begin(), m_plugins.end(), displayNameLessThan);
-        emit loaded(count);
+        updateIndexes();
     }
+    
+    finishLoad(m_loadCount + count);
+}
 
-    m_lastLoaded = QDateTime::currentDateTime();
-    return count;
+bool PluginManager::loadPlugin(const QString &filePath) {
+    const QVariantMap manifest = m_index.manifest(filePath);
+    
+    if (manifest.isEmpty()) {
+        Logger::log("PluginManager::loadPlugin(): Error parsing config file: " + filePath);
+        return false;
+    }
+    
+    ServicePluginConfig *config = new ServicePluginConfig(this);
+    
+    if (!config->load(filePath, manifest)) {
+        delete config;
+        return false;
+    }
+    
+    setCacheMaximumAges(config);
+    setConnectionLimits(config);
+    
+    if (config->pluginType() == "qt") {
+        // The library is loaded by getPluginForService() when the plugin is first used
+        if (!QFile::exists(config->pluginFilePath())) {
+            delete config;
+            Logger::log("PluginManager::loadPlugin(). Qt plugin library not found: " + filePath);
+            return false;
+        }
+        
+        m_plugins << ServicePluginPair(config, 0);
+        Logger::log("PluginManager::loadPlugin(). Qt plugin found: " + config->id(), Logger::MediumVerbosity);
+    }
+    else if (config->pluginType() == "js") {
+        JavaScriptServicePlugin *js = new JavaScriptServicePlugin(config->id(), config->pluginFilePath(), this);
+        js->setNetworkAccessManager(networkAccessManager());
+        m_plugins << ServicePluginPair(config, js);
+        Logger::log("PluginManager::loadPlugin(). JavaScript plugin loaded: " + config->id(),
+                    Logger::MediumVerbosity);
+    }
+    else if (config->pluginType() == "scraper") {
+        ScraperServicePlugin *scraper = new ScraperServicePlugin(config->id(), config->pluginFilePath(), this);
+        scraper->setNetworkAccessManager(networkAccessManager());
+        m_plugins << ServicePluginPair(config, scraper);
+        Logger::log("PluginManager::loadPlugin(). Scraper plugin loaded: " + config->id(),
+                    Logger::MediumVerbosity);
+    }
+    else {
+        ExternalServicePlugin *ext = new ExternalServicePlugin(config->id(), config->pluginFilePath(), this);
+        ext->setWorkerEnabled(config->workerEnabled());
+        ext->setWorkerIdleTimeout(config->workerIdleTimeout());
+        m_plugins << ServicePluginPair(config, ext);
+        Logger::log("PluginManager::loadPlugin(). External plugin loaded: " + config->id(),
+                    Logger::MediumVerbosity);
+    }
+    
+    return true;
+}
+
+void PluginManager::finishLoad(int count) {
+    m_index.save();
+    Logger::log(QString("PluginManager::load() %1 plugins loaded").arg(count), Logger::LowVerbosity);
+    // Emitted even when no plugins were added, so that callers can report the result
+    emit loaded(count);
+}
+
+ServicePlugin* PluginManager::loadQtPlugin(const ServicePluginConfig *config) {
+    QPluginLoader loader(config->pluginFilePath());
+    QObject *obj = loader.instance();
+    
+    if (!obj) {
+        Logger::log("PluginManager::loadQtPlugin(). Qt plugin is NULL: " + config->id());
+        return 0;
+    }
+    
+    if (ServicePlugin *plugin = qobject_cast<ServicePlugin*>(obj)) {
+        plugin->setNetworkAccessManager(networkAccessManager());
+        Logger::log("PluginManager::loadQtPlugin(). Qt Plugin loaded: " + config->id(), Logger::MediumVerbosity);
+        return plugin;
+    }
+    
+    loader.unload();
+    Logger::log("PluginManager::loadQtPlugin(). Error loading Qt plugin: " + config->id());
+    return 0;
+}
+
+void PluginManager::setCacheMaximumAges(const ServicePluginConfig *config) {
+    const QVariantMap ages = config->cacheMaximumAges();
+    
+    if (ages.isEmpty()) {
+        return;
+    }
+    
+    networkAccessManager();
+    QMapIterator<QString, QVariant> iterator(ages);
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        const QString host = QUrl(iterator.key()).host();
+        
+        // The overrides apply to every plugin, so a plugin may only override them for its own hosts
+        if ((host.isEmpty()) || (!isPluginHost(config, host))) {
+            Logger::log(QString("PluginManager::setCacheMaximumAges(). %1: Ignoring prefix on another host: %2")
+                               .arg(config->id()).arg(iterator.key()));
+            continue;
+        }
+        
+        m_cache->setMaximumAge(iterator.key(), iterator.value().toInt());
+    }
+}
+
+void PluginManager::setConnectionLimits(const ServicePluginConfig *config) {
+    // Plugins share the network access manager, so the lowest limit declared for a host applies
+    const QVariantMap limits = config->connectionLimits();
+    
+    if (limits.isEmpty()) {
+        return;
+    }
+    
+    networkAccessManager();
+    QMapIterator<QString, QVariant> iterator(limits);
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        const int maximum = iterator.value().toInt();
+        const int current = m_nam->maximumConnectionsPerHost(iterator.key());
+        
+        if ((maximum > 0) && ((current == 0) || (maximum < current))) {
+            m_nam->setMaximumConnectionsPerHost(iterator.key(), maximum);
+        }
+    }
+}
+
+void PluginManager::updateIndexes() {
+    // Positions change when plugins are sorted, so the indexes are rebuilt after each load
+    m_ids.clear();
+    m_filePaths.clear();
+    
+    for (int i = 0; i < m_plugins.size(); i++) {
+        const ServicePluginConfig *config = m_plugins.at(i).config;
+        
+        if (!m_ids.contains(config->id())) {
+            m_ids.insert(config->id(), i);
+        }
+        
+        m_filePaths.insert(config->filePath(), i);
+    }
 }
@@ -18,20 +18,29 @@
 #ifndef PLUGINMANAGER_H
 #define PLUGINMANAGER_H
 
+#include "pluginmanifestindex.h"
+#include "resourcesreply.h"
 #include "serviceplugin.h"
 #include "servicepluginconfig.h"
 #include <QDateTime>
+#include <QFutureWatcher>
+
+class PluginNetworkAccessManager;
+class PluginNetworkCache;
+class QNetworkAccessManager;
 
 struct ServicePluginPair
 {
     ServicePluginPair(ServicePluginConfig *c, ServicePlugin* p) :
         config(c),
-        plugin(p)
+        plugin(p),
+        loadFailed(false)
     {
     }
 
     ServicePluginConfig *config;
     ServicePlugin *plugin;
+    bool loadFailed;
 };
 
 typedef QList<ServicePluginPair> ServicePluginList;
@@ -46,31 +55,77 @@ public:
 
     static PluginManager* instance();
 
+    QNetworkAccessManager* networkAccessManager();
+
     ServicePluginList plugins() const;
 
     ServicePluginConfig* getConfigForService(const QString &service) const;
 
-    ServicePlugin* getPluginForService(const QString &service) const;
+    ServicePlugin* getPluginForService(const QString &service);
+    
+    ResourcesReply* del(const QString &service, const QString &sourceType, const QString &sourceId,
+                        const QString &destinationType, const QString &destinationId, QObject *parent = 0);
+    ResourcesReply* get(const QString &service, const QString &resourceType, const QString &resourceId,
+                        QObject *parent = 0);
+    ResourcesReply* insert(const QString &service, const QString &sourceType, const QString &sourceId,
+                           const QString &destinationType, const QString &destinationId, QObject *parent = 0);
+    ResourcesReply* list(const QString &service, const QString &resourceType, const QString &resourceId,
+                         QObject *parent = 0);
+    ResourcesReply* search(const QString &service, const QString &resourceType, const QString &query,
+                           const QString &order, QObject *parent = 0);
 
 public Q_SLOTS:
-    ResourcesRequest* createRequestForService(const QString &service, QObject *parent = 0) const;
+    ResourcesRequest* createRequestForService(const QString &service, QObject *parent = 0);
 
     bool resourceTypeIsSupported(const QString &service, const QString &resourceType,
                                  const QString &method = QString("list")) const;
 
-    int load();
+    void load();
+
+private Q_SLOTS:
+    void onManifestsParsed();
 
 Q_SIGNALS:
     void loaded(int count);
 
 private:
+    ResourcesReply* createReplyForService(const QString &service, QObject *parent);
+    
     ServicePluginConfig* getConfigByFilePath(const QString &filePath) const;
+    
+    bool loadPlugin(const QString &filePath);
+    
+    ServicePlugin* loadQtPlugin(const ServicePluginConfig *config);
+    
+    void finishLoad(int count);
+    
+    void setCacheMaximumAges(const ServicePluginConfig *config);
+    
+    void setConnectionLimits(const ServicePluginConfig *config);
+    
+    void updateIndexes();
 
     static PluginManager *self;
 
     QDateTime m_lastLoaded;
+    
+    PluginManifestIndex m_index;
+    
+    QFutureWatcher<QVariantMap> *m_watcher;
+    
+    QStringList m_unindexed;
+    QList<QDateTime> m_unindexedModified;
+    
+    int m_loadCount;
+    
+    PluginNetworkAccessManager *m_nam;
+    
+    PluginNetworkCache *m_cache;
 
     ServicePluginList m_plugins;
+    
+    QHash<QString, int> m_ids;
+    QHash<QString, int> m_filePaths;
 };
 
 #endif // PLUGINMANAGER_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pluginmanifestindex.h"
+#include "logger.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+
+const quint32 PluginManifestIndex::MAGIC = 0x43545049;
+const qint32 PluginManifestIndex::VERSION = 1;
+
+PluginManifestIndex::PluginManifestIndex(const QString &fileName) :
+    m_fileName(fileName),
+    m_loaded(false),
+    m_modified(false)
+{
+}
+
+QString PluginManifestIndex::fileName() const {
+    return m_fileName;
+}
+
+bool PluginManifestIndex::contains(const QString &filePath, const QDateTime &modified) const {
+    QHash<QString, Entry>::const_iterator iterator = m_entries.constFind(filePath);
+    return (iterator != m_entries.constEnd()) && (iterator.value().modified == modified);
+}
+
+QVariantMap PluginManifestIndex::manifest(const QString &filePath) const {
+    return m_entries.value(filePath).manifest;
+}
+
+void PluginManifestIndex::insert(const QString &filePath, const QDateTime &modified, const QVariantMap &manifest) {
+    Entry entry;
+    entry.modified = modified;
+    entry.manifest = manifest;
+    m_entries[filePath] = entry;
+    m_modified = true;
+}
+
+void PluginManifestIndex::retain(const QSet<QString> &filePaths) {
+    QMutableHashIterator<QString, Entry> iterator(m_entries);
+    
+    while (iterator.hasNext()) {
+        if (!filePaths.contains(iterator.next().key())) {
+            iterator.remove();
+            m_modified = true;
+        }
+    }
+}
+
+bool PluginManifestIndex::load() {
+    if (m_loaded) {
+        return true;
+    }
+    
+    m_loaded = true;
+    QFile file(fileName());
+    
+    if (!file.open(QFile::ReadOnly)) {
+        Logger::log("PluginManifestIndex::load(). No index found: " + fileName(), Logger::MediumVerbosity);
+        return false;
+    }
+    
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_7);
+    quint32 magic;
+    qint32 version;
+    qint32 count;
+    stream >> magic >> version >> count;
+    
+    if ((magic != MAGIC) || (version != VERSION) || (count < 0)) {
+        Logger::log("PluginManifestIndex::load(): Ignoring incompatible index: " + fileName());
+        return false;
+    }
+    
+    for (int i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++) {
+        QString filePath;
+        Entry entry;
+        stream >> filePath >> entry.modified >> entry.manifest;
+        m_entries[filePath] = entry;
+    }
+    
+    if (stream.status() != QDataStream::Ok) {
+        Logger::log("PluginManifestIndex::load(): Ignoring corrupt index: " + fileName());
+        m_entries.clear();
+        return false;
+    }
+    
+    Logger::log(QString("PluginManifestIndex::load(). %1 manifests read from index").arg(count),
+                Logger::MediumVerbosity);
+    return true;
+}
+
+bool PluginManifestIndex::save() {
+    if (!m_modified) {
+        return true;
+    }
+    
+    QDir().mkpath(fileName().left(fileName().lastIndexOf("/")));
+    QFile file(fileName());
+    
+    if (!file.open(QFile::WriteOnly)) {
+        Logger::log("PluginManifestIndex::save(): Unable to write index: " + file.errorString());
+        return false;
+    }
+    
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_7);
+    stream << MAGIC << VERSION << qint32(m_entries.size());
+    QHashIterator<QString, Entry> iterator(m_entries);
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        stream << iterator.key() << iterator.value().modified << iterator.value().manifest;
+    }
+    
+    m_modified = false;
+    return true;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PLUGINMANIFESTINDEX_H
+#define PLUGINMANIFESTINDEX_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QVariantMap>
+
+/*
+ * A cache of parsed plugin configs (manifests), keyed on file path and modification time.
+ *
+ * The index is stored with QDataStream, so reading it at startup costs a single file read, and configs that have not
+ * changed since they were indexed are not parsed again.
+ */
+class PluginManifestIndex
+{
+
+public:
+    explicit PluginManifestIndex(const QString &fileName);
+    
+    QString fileName() const;
+    
+    bool contains(const QString &filePath, const QDateTime &modified) const;
+    
+    QVariantMap manifest(const QString &filePath) const;
+    
+    void insert(const QString &filePath, const QDateTime &modified, const QVariantMap &manifest);
+    
+    void retain(const QSet<QString> &filePaths);
+    
+    bool load();
+    bool save();
+
+private:
+    struct Entry {
+        QDateTime modified;
+        QVariantMap manifest;
+    };
+    
+    static const quint32 MAGIC;
+    static const qint32 VERSION;
+    
+    QString m_fileName;
+    
+    QHash<QString, Entry> m_entries;
+    
+    bool m_loaded;
+    bool m_modified;
+};
+
+#endif // PLUGINMANIFESTINDEX_H
@@ -32,6 +32,8 @@ public:
         SelectionModel(parent)
     {
         setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+        // The config of the service may not be loaded yet when the model is created
+        connect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(reload()));
     }
     
     inline QString service() const { 
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pluginnetworkaccessmanager.h"
+#include "logger.h"
+
+PluginNetworkAccessManager::PluginNetworkAccessManager(QObject *parent) :
+    QNetworkAccessManager(parent)
+{
+}
+
+int PluginNetworkAccessManager::maximumConnectionsPerHost(const QString &host) const {
+    return m_limits.value(host.toLower(), 0);
+}
+
+void PluginNetworkAccessManager::setMaximumConnectionsPerHost(const QString &host, int maximum) {
+    const QString h = host.toLower();
+    
+    if (maximum > 0) {
+        m_limits[h] = maximum;
+    }
+    else {
+        m_limits.remove(h);
+    }
+    
+    Logger::log(QString("PluginNetworkAccessManager::setMaximumConnectionsPerHost(). Host: %1, Maximum: %2")
+                       .arg(h).arg(maximum), Logger::MediumVerbosity);
+    startNext(h);
+}
+
+QNetworkReply* PluginNetworkAccessManager::createRequest(Operation op, const QNetworkRequest &request,
+                                                         QIODevice *outgoingData) {
+    const QString host = request.url().host().toLower();
+    
+    if (!m_limits.contains(host)) {
+        return QNetworkAccessManager::createRequest(op, request, outgoingData);
+    }
+    
+    PluginNetworkReply *reply = new PluginNetworkReply(op, request, outgoingData, this);
+    
+    if (m_active.value(host) < m_limits.value(host)) {
+        startReply(reply);
+    }
+    else {
+        Logger::log("PluginNetworkAccessManager::createRequest(). Connection limit reached. Queueing request: "
+                    + request.url().toString(), Logger::HighVerbosity);
+        m_queued[host].enqueue(reply);
+    }
+    
+    return reply;
+}
+
+void PluginNetworkAccessManager::startReply(PluginNetworkReply *reply) {
+    const QString host = reply->request().url().host().toLower();
+    QNetworkReply *r = QNetworkAccessManager::createRequest(reply->operation(), reply->request(),
+                                                            reply->outgoingData());
+    m_running.insert(r, host);
+    ++m_active[host];
+    connect(r, SIGNAL(finished()), this, SLOT(onReplyDone()));
+    connect(r, SIGNAL(destroyed()), this, SLOT(onReplyDone()));
+    reply->setReply(r);
+}
+
+void PluginNetworkAccessManager::startNext(const QString &host) {
+    if (!m_queued.contains(host)) {
+        return;
+    }
+    
+    QQueue< QPointer<PluginNetworkReply> > &queue = m_queued[host];
+    
+    while (!queue.isEmpty()) {
+        if ((m_limits.contains(host)) && (m_active.value(host) >= m_limits.value(host))) {
+            return;
+        }
+        
+        PluginNetworkReply *reply = queue.dequeue();
+        
+        if ((reply) && (!reply->isFinished())) {
+            startReply(reply);
+        }
+    }
+    
+    m_queued.remove(host);
+}
+
+void PluginNetworkAccessManager::onReplyDone() {
+    // Connected to both finished() and destroyed(), so a reply deleted before it finishes still frees its connection
+    QObject *obj = sender();
+    
+    if (!m_running.contains(obj)) {
+        return;
+    }
+    
+    const QString host = m_running.take(obj);
+    
+    if (--m_active[host] <= 0) {
+        m_active.remove(host);
+    }
+    
+    startNext(host);
+}
+
+PluginNetworkReply::PluginNetworkReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                                       QIODevice *outgoingData, QObject *parent) :
+    QNetworkReply(parent),
+    m_outgoingData(outgoingData)
+{
+    setOperation(op);
+    setRequest(request);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+QIODevice* PluginNetworkReply::outgoingData() const {
+    return m_outgoingData;
+}
+
+void PluginNetworkReply::abort() {
+    if (isFinished()) {
+        return;
+    }
+    
+    if (m_reply) {
+        m_reply->abort();
+        return;
+    }
+    
+    setError(OperationCanceledError, tr("Operation canceled"));
+    setFinished(true);
+    emit error(OperationCanceledError);
+    emit finished();
+}
+
+qint64 PluginNetworkReply::bytesAvailable() const {
+    return m_reply ? QNetworkReply::bytesAvailable() + m_reply->bytesAvailable() : QNetworkReply::bytesAvailable();
+}
+
+bool PluginNetworkReply::isSequential() const {
+    return true;
+}
+
+void PluginNetworkReply::setReply(QNetworkReply *reply) {
+    m_reply = reply;
+    reply->setParent(this);
+    connect(reply, SIGNAL(metaDataChanged()), this, SLOT(onReplyMetaDataChanged()));
+    connect(reply, SIGNAL(readyRead()), this, SIGNAL(readyRead()));
+    connect(reply, SIGNAL(downloadProgress(qint64, qint64)), this, SIGNAL(downloadProgress(qint64, qint64)));
+    connect(reply, SIGNAL(uploadProgress(qint64, qint64)), this, SIGNAL(uploadProgress(qint64, qint64)));
+    connect(reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+}
+
+qint64 PluginNetworkReply::readData(char *data, qint64 maxSize) {
+    if (m_reply) {
+        const qint64 read = m_reply->read(data, maxSize);
+        
+        if (read > 0) {
+            return read;
+        }
+    }
+    
+    return isFinished() ? -1 : 0;
+}
+
+void PluginNetworkReply::copyMetaData() {
+    foreach (const QByteArray &header, m_reply->rawHeaderList()) {
+        setRawHeader(header, m_reply->rawHeader(header));
+    }
+    
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute,
+                 m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute));
+    setAttribute(QNetworkRequest::HttpReasonPhraseAttribute,
+                 m_reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+    setAttribute(QNetworkRequest::RedirectionTargetAttribute,
+                 m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute));
+    setAttribute(QNetworkRequest::ConnectionEncryptedAttribute,
+                 m_reply->attribute(QNetworkRequest::ConnectionEncryptedAttribute));
+    setAttribute(QNetworkRequest::SourceIsFromCacheAttribute,
+                 m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute));
+}
+
+void PluginNetworkReply::onReplyMetaDataChanged() {
+    copyMetaData();
+    emit metaDataChanged();
+}
+
+void PluginNetworkReply::onReplyFinished() {
+    copyMetaData();
+    
+    if (m_reply->error() != NoError) {
+        setError(m_reply->error(), m_reply->errorString());
+        emit error(m_reply->error());
+    }
+    
+    setFinished(true);
+    emit finished();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PLUGINNETWORKACCESSMANAGER_H
+#define PLUGINNETWORKACCESSMANAGER_H
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QQueue>
+
+class PluginNetworkReply;
+
+/*
+ * The network access manager shared by all plugins, so that connections and cookies are reused between requests and
+ * between plugins.
+ *
+ * Requests to a host with a connection limit (see setMaximumConnectionsPerHost()) are queued once the limit is
+ * reached. A queued request returns a PluginNetworkReply immediately, which forwards the real reply when it starts.
+ * Requests to other hosts are passed straight to QNetworkAccessManager.
+ */
+class PluginNetworkAccessManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+
+public:
+    explicit PluginNetworkAccessManager(QObject *parent = 0);
+    
+    // A maximum of 0 means that connections to the host are not limited by the manager
+    int maximumConnectionsPerHost(const QString &host) const;
+    void setMaximumConnectionsPerHost(const QString &host, int maximum);
+
+protected:
+    virtual QNetworkReply* createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData = 0);
+
+private Q_SLOTS:
+    void onReplyDone();
+
+private:
+    void startReply(PluginNetworkReply *reply);
+    void startNext(const QString &host);
+    
+    QHash<QString, int> m_limits;
+    QHash<QString, int> m_active;
+    QHash<QObject*, QString> m_running;
+    QHash<QString, QQueue< QPointer<PluginNetworkReply> > > m_queued;
+};
+
+/*
+ * A reply for a request that is waiting for a free connection. Once started, it forwards the headers, data and
+ * signals of the real reply.
+ */
+class PluginNetworkReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    explicit PluginNetworkReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                                QIODevice *outgoingData, QObject *parent = 0);
+    
+    QIODevice* outgoingData() const;
+    
+    virtual void abort();
+    
+    virtual qint64 bytesAvailable() const;
+    
+    virtual bool isSequential() const;
+    
+    void setReply(QNetworkReply *reply);
+
+protected:
+    virtual qint64 readData(char *data, qint64 maxSize);
+
+private Q_SLOTS:
+    void onReplyMetaDataChanged();
+    void onReplyFinished();
+
+private:
+    void copyMetaData();
+    
+    QPointer<QIODevice> m_outgoingData;
+    QPointer<QNetworkReply> m_reply;
+};
+
+#endif // PLUGINNETWORKACCESSMANAGER_H
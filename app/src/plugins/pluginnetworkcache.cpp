@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pluginnetworkcache.h"
+#include "logger.h"
+#include <QDateTime>
+
+PluginNetworkCache::PluginNetworkCache(QObject *parent) :
+    QNetworkDiskCache(parent)
+{
+}
+
+int PluginNetworkCache::maximumAge(const QUrl &url) const {
+    // The longest matching prefix applies. -1 means that the response headers apply.
+    const QString u = url.toString();
+    QString prefix;
+    int age = -1;
+    QMapIterator<QString, int> iterator(m_ages);
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        
+        if ((iterator.key().size() > prefix.size()) && (u.startsWith(iterator.key()))) {
+            prefix = iterator.key();
+            age = iterator.value();
+        }
+    }
+    
+    return age;
+}
+
+void PluginNetworkCache::setMaximumAge(const QString &urlPrefix, int seconds) {
+    if (seconds < 0) {
+        m_ages.remove(urlPrefix);
+    }
+    else {
+        m_ages[urlPrefix] = seconds;
+    }
+}
+
+QIODevice* PluginNetworkCache::prepare(const QNetworkCacheMetaData &metaData) {
+    const int age = maximumAge(metaData.url());
+    
+    if (age < 0) {
+        return QNetworkDiskCache::prepare(metaData);
+    }
+    
+    if (age == 0) {
+        return 0;
+    }
+    
+    // Replace the freshness headers, so that the cached response is also used without revalidation when it is read
+    QNetworkCacheMetaData::RawHeaderList headers;
+    
+    foreach (const QNetworkCacheMetaData::RawHeader &header, metaData.rawHeaders()) {
+        const QByteArray name = header.first.toLower();
+        
+        if ((name != "cache-control") && (name != "expires") && (name != "pragma")) {
+            headers << header;
+        }
+    }
+    
+    headers << QNetworkCacheMetaData::RawHeader("Cache-Control", "max-age=" + QByteArray::number(age));
+    QNetworkCacheMetaData m(metaData);
+    m.setRawHeaders(headers);
+    m.setExpirationDate(QDateTime::currentDateTime().addSecs(age));
+    m.setSaveToDisk(true);
+    Logger::log(QString("PluginNetworkCache::prepare(). Caching %1 for %2 seconds").arg(metaData.url().toString())
+                                                                                   .arg(age), Logger::HighVerbosity);
+    return QNetworkDiskCache::prepare(m);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PLUGINNETWORKCACHE_H
+#define PLUGINNETWORKCACHE_H
+
+#include <QMap>
+#include <QNetworkDiskCache>
+
+/*
+ * The HTTP cache for plugin and XMLHttpRequest traffic.
+ *
+ * Responses are cached and revalidated according to their Cache-Control, Expires and ETag headers. Plugins can
+ * override the freshness of responses whose URL starts with a given prefix (see setMaximumAge()). A maximum age of 0
+ * means that such responses are never cached.
+ */
+class PluginNetworkCache : public QNetworkDiskCache
+{
+    Q_OBJECT
+
+public:
+    explicit PluginNetworkCache(QObject *parent = 0);
+    
+    int maximumAge(const QUrl &url) const;
+    void setMaximumAge(const QString &urlPrefix, int seconds);
+    
+    virtual QIODevice* prepare(const QNetworkCacheMetaData &metaData);
+
+private:
+    QMap<QString, int> m_ages;
+};
+
+#endif // PLUGINNETWORKCACHE_H
@@ -31,6 +31,8 @@ public:
     explicit PluginSearchTypeModel(QObject *parent = 0) :
         SelectionModel(parent)
     {
+        // The config of the service may not be loaded yet when the model is created
+        connect(PluginManager::instance(), SIGNAL(loaded(int)), this, SLOT(reload()));
     }
     
     inline QString service() { 
@@ -19,6 +19,52 @@
 #include "resources.h"
 #include "utils.h"
 
+PluginVideoData::PluginVideoData() :
+    CTVideoData()
+{
+}
+
+PluginVideoData::PluginVideoData(const QString &service, const QVariantMap &video) :
+    CTVideoData(),
+    commentsId(video.value("commentsId").toString()),
+    relatedVideosId(video.value("relatedVideosId").toString())
+{
+    this->service = service;
+    date = video.value("date").toString();
+    description = video.value("description").toString();
+    downloadable = video.value("downloadable", true).toBool();
+    subtitles = video.value("subtitles", false).toBool();
+    id = video.value("id").toString();
+    largeThumbnailUrl = video.value("largeThumbnailUrl").toString();
+    streamUrl = video.value("streamUrl").toString();
+    thumbnailUrl = video.value("thumbnailUrl").toString();
+    title = video.value("title").toString();
+    url = video.value("url").toString();
+    userId = video.value("userId").toString();
+    username = video.value("username").toString();
+    viewCount = video.value("viewCount").toLongLong();
+
+    const QVariant &duration = video.value("duration");
+
+    switch (duration.type()) {
+    case QVariant::Int:
+    case QVariant::LongLong:
+    case QVariant::Double:
+        this->duration = Utils::formatSecs(qMax(0, duration.toInt()));
+        break;
+    default:
+        this->duration = duration.toString();
+        break;
+    }
+}
+
+PluginVideoData::PluginVideoData(const PluginVideo *video) :
+    CTVideoData(video),
+    commentsId(video->commentsId()),
+    relatedVideosId(video->relatedVideosId())
+{
+}
+
 PluginVideo::PluginVideo(QObject *parent) :
     CTVideo(parent),
     m_request(0)
@@ -47,6 +93,14 @@ PluginVideo::PluginVideo(const PluginVideo *video, QObject *parent) :
 {
 }
 
+PluginVideo::PluginVideo(const PluginVideoData &video, QObject *parent) :
+    CTVideo(video, parent),
+    m_request(0),
+    m_commentsId(video.commentsId),
+    m_relatedVideosId(video.relatedVideosId)
+{
+}
+
 QString PluginVideo::commentsId() const {
     return m_commentsId;
 }
@@ -91,35 +145,13 @@ void PluginVideo::loadVideo(const QString &service, const QString &id) {
 }
 
 void PluginVideo::loadVideo(const QString &service, const QVariantMap &video) {
-    setService(service);
-    setCommentsId(video.value("commentsId").toString());
-    setDate(video.value("date").toString());
-    setDescription(video.value("description").toString());
-    setDownloadable(video.value("downloadable", true).toBool());
-    setHasSubtitles(video.value("subtitles", false).toBool());
-    setId(video.value("id").toString());
-    setLargeThumbnailUrl(video.value("largeThumbnailUrl").toString());
-    setRelatedVideosId(video.value("relatedVideosId").toString());
-    setStreamUrl(video.value("streamUrl").toString());
-    setThumbnailUrl(video.value("thumbnailUrl").toString());
-    setTitle(video.value("title").toString());
-    setUrl(video.value("url").toString());
-    setUserId(video.value("userId").toString());
-    setUsername(video.value("username").toString());
-    setViewCount(video.value("viewCount").toLongLong());
-
-    const QVariant &duration = video.value("duration");
+    loadData(PluginVideoData(service, video));
+}
 
-    switch (duration.type()) {
-    case QVariant::Int:
-    case QVariant::LongLong:
-    case QVariant::Double:
-        setDuration(Utils::formatSecs(qMax(0, duration.toInt())));
-        break;
-    default:
-        setDuration(duration.toString());
-        break;
-    }
+void PluginVideo::loadData(const PluginVideoData &video) {
+    CTVideo::loadData(video);
+    setCommentsId(video.commentsId);
+    setRelatedVideosId(video.relatedVideosId);
 }
 
 void PluginVideo::loadVideo(PluginVideo *video) {
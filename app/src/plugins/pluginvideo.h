@@ -20,6 +20,19 @@
 #include "video.h"
 #include "resourcesrequest.h"
 
+class PluginVideo;
+
+class PluginVideoData : public CTVideoData
+{
+public:
+    PluginVideoData();
+    explicit PluginVideoData(const QString &service, const QVariantMap &video);
+    explicit PluginVideoData(const PluginVideo *video);
+    
+    QString commentsId;
+    QString relatedVideosId;
+};
+
 class PluginVideo : public CTVideo
 {
     Q_OBJECT
@@ -34,6 +47,7 @@ public:
     explicit PluginVideo(const QString &service, const QString &id, QObject *parent = 0);
     explicit PluginVideo(const QString &service, const QVariantMap &video, QObject *parent = 0);
     explicit PluginVideo(const PluginVideo *video, QObject *parent = 0);
+    explicit PluginVideo(const PluginVideoData &video, QObject *parent = 0);
     
     QString commentsId() const;
     QString relatedVideosId() const;
@@ -47,6 +61,8 @@ public:
     Q_INVOKABLE void loadVideo(PluginVideo *video);
 
 protected:
+    void loadData(const PluginVideoData &video);
+    
     void setCommentsId(const QString &i);
     void setRelatedVideosId(const QString &i);
 
@@ -18,10 +18,13 @@
 #include "logger.h"
 #include "pluginmanager.h"
 #include "resources.h"
+#include "responsecache.h"
 
 PluginVideoModel::PluginVideoModel(QObject *parent) :
     QAbstractListModel(parent),
-    m_request(0)
+    m_request(0),
+    m_cached(false),
+    m_revalidating(false)
 {
     m_roles[CommentsIdRole] = "commentsId";
     m_roles[DateRole] = "date";
@@ -59,15 +62,40 @@ void PluginVideoModel::setService(const QString &s) {
         emit serviceChanged();
 
         clear();
+        m_cached = false;
 
         if (m_request) {
             m_request->deleteLater();
             m_request = 0;
         }
+        
+        if (m_prefetchReply) {
+            m_prefetchReply->cancel();
+            m_prefetchReply->deleteLater();
+            m_prefetchReply = 0;
+        }
+    }
+}
+
+int PluginVideoModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void PluginVideoModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
     }
 }
 
 ResourcesRequest::Status PluginVideoModel::status() const {
+    if (m_prefetcher.isWanted()) {
+        return ResourcesRequest::Loading;
+    }
+    
+    if (m_cached) {
+        return ResourcesRequest::Ready;
+    }
+    
     return m_request ? m_request->status() : ResourcesRequest::Null;
 }
 
@@ -89,16 +117,78 @@ void PluginVideoModel::fetchMore(const QModelIndex &) {
     if (!canFetchMore()) {
         return;
     }
-
-    if (ResourcesRequest *r = request()) {
+    
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if ((m_prefetchReply) && (m_prefetchReply->status() == ResourcesRequest::Loading)) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
+    m_cacheKey = ResponseCache::key(service(), m_next, Resources::VIDEO);
+    const QVariantMap result = ResponseCache::result(m_cacheKey).toMap();
+    
+    if (!result.isEmpty()) {
+        m_cached = true;
+        addVideos(result);
+        emit statusChanged(status());
+    }
+    else if (ResourcesRequest *r = request()) {
+        m_cached = false;
         r->list(Resources::VIDEO, m_next);
         emit statusChanged(status());
     }
 }
 
+QVariant PluginVideoModel::roleData(const PluginVideoData *video, int role) {
+    switch (role) {
+    case CommentsIdRole:
+        return video->commentsId;
+    case DateRole:
+        return video->date;
+    case DescriptionRole:
+        return video->description;
+    case DownloadableRole:
+        return video->downloadable;
+    case DurationRole:
+        return video->duration;
+    case IdRole:
+        return video->id;
+    case LargeThumbnailUrlRole:
+        return video->largeThumbnailUrl;
+    case RelatedVideosIdRole:
+        return video->relatedVideosId;
+    case ServiceRole:
+        return video->service;
+    case StreamUrlRole:
+        return video->streamUrl;
+    case SubtitlesRole:
+        return video->subtitles;
+    case ThumbnailUrlRole:
+        return video->thumbnailUrl;
+    case TitleRole:
+        return video->title;
+    case UrlRole:
+        return video->url;
+    case UserIdRole:
+        return video->userId;
+    case UsernameRole:
+        return video->username;
+    case ViewCountRole:
+        return video->viewCount;
+    default:
+        return QVariant();
+    }
+}
+
 QVariant PluginVideoModel::data(const QModelIndex &index, int role) const {
-    if (const PluginVideo *video = get(index.row())) {
-        return video->property(m_roles[role]);
+    if (const PluginVideoData *video = videoData(index.row())) {
+        return roleData(video, role);
     }
     
     return QVariant();
@@ -107,12 +197,12 @@ QVariant PluginVideoModel::data(const QModelIndex &index, int role) const {
 QMap<int, QVariant> PluginVideoModel::itemData(const QModelIndex &index) const {
     QMap<int, QVariant> map;
     
-    if (const PluginVideo *video = get(index.row())) {
+    if (const PluginVideoData *video = videoData(index.row())) {
         QHashIterator<int, QByteArray> iterator(m_roles);
         
         while (iterator.hasNext()) {
             iterator.next();
-            map[iterator.key()] = video->property(iterator.value());
+            map[iterator.key()] = roleData(video, iterator.key());
         }
     }
     
@@ -120,8 +210,8 @@ QMap<int, QVariant> PluginVideoModel::itemData(const QModelIndex &index) const {
 }
 
 QVariant PluginVideoModel::data(int row, const QByteArray &role) const {
-    if (const PluginVideo *video = get(row)) {
-        return video->property(role);
+    if (const PluginVideoData *video = videoData(row)) {
+        return roleData(video, m_roles.key(role));
     }
     
     return QVariant();
@@ -130,9 +220,12 @@ QVariant PluginVideoModel::data(int row, const QByteArray &role) const {
 QVariantMap PluginVideoModel::itemData(int row) const {
     QVariantMap map;
     
-    if (const PluginVideo *video = get(row)) {
-        foreach (const QByteArray &role, m_roles.values()) {
-            map[role] = video->property(role);
+    if (const PluginVideoData *video = videoData(row)) {
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.value()] = roleData(video, iterator.key());
         }
     }
     
@@ -141,7 +234,22 @@ QVariantMap PluginVideoModel::itemData(int row) const {
 
 PluginVideo* PluginVideoModel::get(int row) const {
     if ((row >= 0) && (row < m_items.size())) {
-        return m_items.at(row);
+        // Rows are stored as values, so the QObject is only created when a page or QML asks for it
+        if (!m_videos.at(row)) {
+            m_videos[row] = new PluginVideo(*m_items.at(row), const_cast<PluginVideoModel*>(this));
+            // Keep the row in step with any change to the object, such as a reload of its details
+            m_videos.at(row)->connectChangeSignals(const_cast<PluginVideoModel*>(this), SLOT(onVideoChanged()));
+        }
+        
+        return m_videos.at(row);
+    }
+    
+    return 0;
+}
+
+const PluginVideoData* PluginVideoModel::videoData(int row) const {
+    if ((row >= 0) && (row < m_items.size())) {
+        return m_items.at(row).constData();
     }
     
     return 0;
@@ -156,11 +264,8 @@ void PluginVideoModel::list(const QString &resourceId) {
     clear();
     m_resourceId = resourceId;
     m_query = QString();
-
-    if (ResourcesRequest *r = request()) {
-        r->list(Resources::VIDEO, resourceId);
-        emit statusChanged(status());
-    }
+    m_cacheKey = ResponseCache::key(service(), resourceId, Resources::VIDEO);
+    getCachedVideos();
 }
 
 void PluginVideoModel::search(const QString &query, const QString &order) {
@@ -174,18 +279,22 @@ void PluginVideoModel::search(const QString &query, const QString &order) {
     m_resourceId = QString();
     m_query = query;
     m_order = order;
-
-    if (ResourcesRequest *r = request()) {
-        r->search(Resources::VIDEO, query, order);
-        emit statusChanged(status());
-    }
+    m_cacheKey = ResponseCache::key(service(), "search", QVariantList() << query << order);
+    getCachedVideos();
 }
 
 void PluginVideoModel::clear() {
+    m_prefetcher.clear();
+    
+    if (m_prefetchReply) {
+        m_prefetchReply->cancel();
+    }
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
-        qDeleteAll(m_items);
+        qDeleteAll(m_videos);
         m_items.clear();
+        m_videos.clear();
         m_next = QString();
         endResetModel();
         emit countChanged(rowCount());
@@ -196,6 +305,16 @@ void PluginVideoModel::cancel() {
     if (m_request) {
         m_request->cancel();
     }
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        
+        if (m_prefetchReply) {
+            m_prefetchReply->cancel();
+        }
+        
+        emit statusChanged(status());
+    }
 }
 
 void PluginVideoModel::reload() {
@@ -205,29 +324,24 @@ void PluginVideoModel::reload() {
     
     Logger::log("PluginVideoModel::reload(). Resource ID: " + m_resourceId, Logger::MediumVerbosity);
     clear();
-
-    if (ResourcesRequest *r = request()) {
-        if (m_query.isEmpty()) {
-            r->list(Resources::VIDEO, m_resourceId);
-        }
-        else {
-            r->search(Resources::VIDEO, m_query, m_order);
-        }
-        
-        emit statusChanged(status());
-    }
+    m_cacheKey = m_query.isEmpty() ? ResponseCache::key(service(), m_resourceId, Resources::VIDEO)
+                                   : ResponseCache::key(service(), "search", QVariantList() << m_query << m_order);
+    getVideos();
+    emit statusChanged(status());
 }
 
-void PluginVideoModel::append(PluginVideo *video) {
+void PluginVideoModel::append(PluginVideoData *video) {
     beginInsertRows(QModelIndex(), m_items.size(), m_items.size());
-    m_items << video;
+    m_items << QSharedDataPointer<PluginVideoData>(video);
+    m_videos << 0;
     endInsertRows();
 }
 
-void PluginVideoModel::insert(int row, PluginVideo *video) {
+void PluginVideoModel::insert(int row, PluginVideoData *video) {
     if ((row >= 0) && (row < m_items.size())) {
         beginInsertRows(QModelIndex(), row, row);
-        m_items.insert(row, video);
+        m_items.insert(row, QSharedDataPointer<PluginVideoData>(video));
+        m_videos.insert(row, 0);
         endInsertRows();
     }
     else {
@@ -238,11 +352,105 @@ void PluginVideoModel::insert(int row, PluginVideo *video) {
 void PluginVideoModel::remove(int row) {
     if ((row >= 0) && (row < m_items.size())) {
         beginRemoveRows(QModelIndex(), row, row);
-        m_items.takeAt(row)->deleteLater();
+        m_items.removeAt(row);
+        
+        if (PluginVideo *video = m_videos.takeAt(row)) {
+            video->deleteLater();
+        }
+        
         endRemoveRows();
     }
 }
 
+void PluginVideoModel::getCachedVideos() {
+    bool stale = false;
+    const QVariantMap result = ResponseCache::result(m_cacheKey, &stale).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos();
+    }
+    else {
+        // Show the cached videos immediately, and replace them if they need to be revalidated
+        addVideos(result);
+        
+        if (stale) {
+            m_revalidating = true;
+            getVideos();
+        }
+        else {
+            m_cached = true;
+        }
+    }
+    
+    emit statusChanged(status());
+}
+
+void PluginVideoModel::getVideos() {
+    m_cached = false;
+    
+    if (ResourcesRequest *r = request()) {
+        if (m_query.isEmpty()) {
+            r->list(Resources::VIDEO, m_resourceId);
+        }
+        else {
+            r->search(Resources::VIDEO, m_query, m_order);
+        }
+    }
+}
+
+void PluginVideoModel::addVideos(const QVariantMap &result) {
+    m_next = result.value("next").toString();
+    const QVariantList list = result.value("items").toList();
+    
+    if (!list.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+        
+        foreach (const QVariant &item, list) {
+            m_items << QSharedDataPointer<PluginVideoData>(new PluginVideoData(service(), item.toMap()));
+            m_videos << 0;
+        }
+        
+        endInsertRows();
+        emit countChanged(rowCount());
+    }
+}
+
+void PluginVideoModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((m_next.isEmpty()) || (status() == ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), m_next))) {
+        return;
+    }
+    
+    m_prefetchCacheKey = ResponseCache::key(service(), m_next, Resources::VIDEO);
+    
+    // A cached page does not need to be prefetched, since fetchMore() will use the cached response
+    if (ResponseCache::result(m_prefetchCacheKey).toMap().isEmpty()) {
+        if (m_prefetchReply) {
+            m_prefetchReply->cancel();
+            m_prefetchReply->deleteLater();
+        }
+        
+        // The prefetch has its own reply, so it can run alongside any other call made by the model
+        Logger::log("PluginVideoModel::setVisibleRange(). Prefetching resource ID: " + m_next,
+                    Logger::HighVerbosity);
+        m_prefetchReply = PluginManager::instance()->list(service(), Resources::VIDEO, m_next, this);
+        
+        if (m_prefetchReply) {
+            connect(m_prefetchReply, SIGNAL(finished()), this, SLOT(onPrefetchReplyFinished()));
+        }
+    }
+}
+
+void PluginVideoModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed, and is then added in the same way as a cached page
+    const QVariantMap result = m_prefetcher.takeResult();
+    m_cached = true;
+    m_cacheKey = m_prefetchCacheKey;
+    addVideos(result);
+    emit statusChanged(status());
+}
+
 ResourcesRequest* PluginVideoModel::request() {
     if (!m_request) {
         m_request = PluginManager::instance()->createRequestForService(service(), this);
@@ -255,28 +463,70 @@ ResourcesRequest* PluginVideoModel::request() {
     return m_request;
 }
 
+void PluginVideoModel::onVideoChanged() {
+    const int i = m_videos.indexOf(qobject_cast<PluginVideo*>(sender()));
+    
+    if (i >= 0) {
+        m_items[i] = QSharedDataPointer<PluginVideoData>(new PluginVideoData(m_videos.at(i)));
+        const QModelIndex idx = index(i);
+        emit dataChanged(idx, idx);
+    }
+}
+
 void PluginVideoModel::onRequestFinished() {
     if (m_request->status() == ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_next = result.value("next").toString();
-            const QVariantList list = result.value("items").toList();
-
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-    
-            foreach (const QVariant &item, list) {
-                m_items << new PluginVideo(service(), item.toMap(), this);
+            ResponseCache::insert(m_cacheKey, service(), m_query.isEmpty() ? Resources::VIDEO : QString("search"),
+                                  result);
+            
+            if (m_revalidating) {
+                clear();
             }
-
-            endInsertRows();
-            emit countChanged(rowCount());
-                
+            
+            addVideos(result);
         }
     }
     else {
         Logger::log("PluginVideoModel::onRequestFinished(). Error: " + errorString());
     }
     
+    m_revalidating = false;
     emit statusChanged(status());
 }
+
+void PluginVideoModel::onPrefetchReplyFinished() {
+    ResourcesReply *reply = qobject_cast<ResourcesReply*>(sender());
+    
+    // Replies of superseded prefetches are already scheduled for deletion
+    if ((!reply) || (reply != m_prefetchReply)) {
+        return;
+    }
+    
+    m_prefetchReply = 0;
+    reply->deleteLater();
+    
+    if (reply->status() == ResourcesRequest::Ready) {
+        const QVariantMap result = reply->result().toMap();
+        
+        if (!result.isEmpty()) {
+            ResponseCache::insert(m_prefetchCacheKey, service(), m_query.isEmpty() ? Resources::VIDEO : QString("search"),
+                                  result);
+            if (m_prefetcher.setResult(result)) {
+                addPrefetchResult();
+            }
+            
+            return;
+        }
+    }
+    else {
+        Logger::log("PluginVideoModel::onPrefetchReplyFinished(). Error: " + reply->errorString());
+    }
+    
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
+}
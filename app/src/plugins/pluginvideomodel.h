@@ -18,8 +18,12 @@
 #define PLUGINVIDEOMODEL_H
 
 #include <QAbstractListModel>
+#include <QPointer>
+#include "pageprefetcher.h"
 #include "pluginvideo.h"
 
+class ResourcesReply;
+
 class PluginVideoModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -27,6 +31,8 @@ class PluginVideoModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QString service READ service WRITE setService NOTIFY serviceChanged)
     Q_PROPERTY(ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
@@ -58,6 +64,9 @@ public:
     
     QString errorString() const;
     
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
     ResourcesRequest::Status status() const;
     
 #if QT_VERSION >= 0x050000
@@ -83,31 +92,55 @@ public Q_SLOTS:
     void clear();
     void cancel();
     void reload();    
+    
+    void setVisibleRange(int first, int last);
 
 private Q_SLOTS:
     void onRequestFinished();
+    void onVideoChanged();
+    void onPrefetchReplyFinished();
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void serviceChanged();
     void statusChanged(ResourcesRequest::Status s);
     
 private:
-    void append(PluginVideo *video);
-    void insert(int row, PluginVideo *video);
+    static QVariant roleData(const PluginVideoData *video, int role);
+    
+    const PluginVideoData* videoData(int row) const;
+    
+    void append(PluginVideoData *video);
+    void insert(int row, PluginVideoData *video);
     void remove(int row);
+    
+    void getCachedVideos();
+    void getVideos();
+    void addVideos(const QVariantMap &result);
+    
+    void addPrefetchResult();
 
     ResourcesRequest* request();
     
     ResourcesRequest *m_request;
+    QPointer<ResourcesReply> m_prefetchReply;
     
     QString m_service;
     QString m_resourceId;
     QString m_query;
     QString m_order;
     QString m_next;
+    
+    QString m_cacheKey;
+    bool m_cached;
+    bool m_revalidating;
+    
+    QString m_prefetchCacheKey;
+    PagePrefetcher m_prefetcher;
         
-    QList<PluginVideo*> m_items;
+    QList< QSharedDataPointer<PluginVideoData> > m_items;
+    mutable QList<PluginVideo*> m_videos;
     
     QHash<int, QByteArray> m_roles;
 };
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "resourcesreply.h"
+#include "logger.h"
+
+ResourcesReply::ResourcesReply(ResourcesRequest *request, QObject *parent) :
+    QObject(parent),
+    m_request(request),
+    m_status(ResourcesRequest::Loading)
+{
+    m_request->setParent(this);
+    connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+}
+
+QString ResourcesReply::errorString() const {
+    return m_errorString;
+}
+
+QVariant ResourcesReply::result() const {
+    return m_status == ResourcesRequest::Ready ? m_request->result() : QVariant();
+}
+
+ResourcesRequest::Status ResourcesReply::status() const {
+    return m_status;
+}
+
+ResourcesRequest* ResourcesReply::request() const {
+    return m_request;
+}
+
+void ResourcesReply::cancel() {
+    if (m_status != ResourcesRequest::Loading) {
+        return;
+    }
+    
+    // The request emits finished() when it is canceled, so it is disconnected first. Otherwise the reply would
+    // finish twice
+    disconnect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    m_request->cancel();
+    finish(ResourcesRequest::Canceled);
+}
+
+void ResourcesReply::setStarted(bool started) {
+    if ((!started) && (m_status == ResourcesRequest::Loading)) {
+        const ResourcesRequest::Status s = m_request->status();
+        
+        if ((s == ResourcesRequest::Failed) || (s == ResourcesRequest::Canceled)) {
+            finish(s, m_request->errorString());
+        }
+        else {
+            finish(ResourcesRequest::Failed, tr("Request could not be started"));
+        }
+    }
+}
+
+void ResourcesReply::finish(ResourcesRequest::Status s, const QString &errorString) {
+    m_status = s;
+    m_errorString = errorString;
+    emit statusChanged(s);
+    // The reply may finish before it has been returned to the caller
+    QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
+}
+
+void ResourcesReply::onRequestFinished() {
+    if (m_status != ResourcesRequest::Loading) {
+        return;
+    }
+    
+    const ResourcesRequest::Status s = m_request->status();
+    
+    if (s != ResourcesRequest::Ready) {
+        Logger::log("ResourcesReply::onRequestFinished(). Error: " + m_request->errorString(), Logger::MediumVerbosity);
+    }
+    
+    finish(s, s == ResourcesRequest::Ready ? QString() : m_request->errorString());
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RESOURCESREPLY_H
+#define RESOURCESREPLY_H
+
+#include "resourcesrequest.h"
+
+/*
+ * The handle for a single call to a plugin, returned by PluginManager::del(), get(), insert(), list() and search().
+ *
+ * Each reply has its own ResourcesRequest, so a model can make several calls to the same plugin at once. Plugins
+ * that only handle one call per request need no changes. A reply emits finished() once, always after it has been
+ * returned to the caller, and can be canceled even if the plugin request cannot.
+ */
+class ResourcesReply : public QObject
+{
+    Q_OBJECT
+    
+    Q_PROPERTY(QString errorString READ errorString NOTIFY finished)
+    Q_PROPERTY(QVariant result READ result NOTIFY finished)
+    Q_PROPERTY(ResourcesRequest::Status status READ status NOTIFY statusChanged)
+
+public:
+    QString errorString() const;
+    
+    QVariant result() const;
+    
+    ResourcesRequest::Status status() const;
+
+public Q_SLOTS:
+    void cancel();
+
+private Q_SLOTS:
+    void onRequestFinished();
+
+Q_SIGNALS:
+    void finished();
+    void statusChanged(ResourcesRequest::Status s);
+
+private:
+    explicit ResourcesReply(ResourcesRequest *request, QObject *parent = 0);
+    
+    ResourcesRequest* request() const;
+    
+    void setStarted(bool started);
+    
+    void finish(ResourcesRequest::Status s, const QString &errorString = QString());
+    
+    ResourcesRequest *m_request;
+    
+    ResourcesRequest::Status m_status;
+    
+    QString m_errorString;
+    
+    friend class PluginManager;
+};
+
+#endif // RESOURCESREPLY_H
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "scraperplan.h"
+#include "json.h"
+#include "logger.h"
+#include <QFile>
+#include <QStringList>
+
+ScraperPlan::ScraperPlan(const QString &fileName, QObject *parent) :
+    QObject(parent),
+    m_fileName(fileName),
+    m_loaded(false)
+{
+}
+
+QString ScraperPlan::baseUrl() const {
+    return m_baseUrl;
+}
+
+QString ScraperPlan::errorString() const {
+    return m_errorString;
+}
+
+QString ScraperPlan::fileName() const {
+    return m_fileName;
+}
+
+QHash<QByteArray, QByteArray> ScraperPlan::headers() const {
+    return m_headers;
+}
+
+bool ScraperPlan::isLoaded() const {
+    return m_loaded;
+}
+
+const ScraperRule* ScraperPlan::rule(const QString &method, const QString &resourceType) const {
+    QHash<QString, ScraperRule>::const_iterator iterator = m_rules.constFind(method + "/" + resourceType);
+    return iterator != m_rules.constEnd() ? &iterator.value() : 0;
+}
+
+bool ScraperPlan::load() {
+    if (m_loaded) {
+        return true;
+    }
+    
+    QFile file(fileName());
+    
+    if (!file.open(QFile::ReadOnly)) {
+        Logger::log("ScraperPlan::load(): Error reading scraper file: " + file.errorString());
+        m_errorString = tr("Cannot read plugin file");
+        return false;
+    }
+    
+    bool ok;
+    const QVariantMap config = QtJson::Json::parse(QString::fromUtf8(file.readAll()), ok).toMap();
+    file.close();
+    
+    if (!ok) {
+        Logger::log("ScraperPlan::load(): Error parsing scraper file: " + fileName());
+        m_errorString = tr("Cannot parse plugin file");
+        return false;
+    }
+    
+    m_baseUrl = config.value("baseUrl").toString();
+    m_headers.clear();
+    m_rules.clear();
+    QMapIterator<QString, QVariant> iterator(config.value("headers").toMap());
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        m_headers[iterator.key().toUtf8()] = iterator.value().toString().toUtf8();
+    }
+    
+    addRules("get", config.value("get").toMap());
+    addRules("list", config.value("list").toMap());
+    addRules("search", config.value("search").toMap());
+    m_errorString = QString();
+    m_loaded = true;
+    Logger::log(QString("ScraperPlan::load(). %1 rules compiled from %2").arg(m_rules.size()).arg(fileName()),
+                Logger::MediumVerbosity);
+    return true;
+}
+
+void ScraperPlan::addRules(const QString &method, const QVariantMap &rules) {
+    QMapIterator<QString, QVariant> iterator(rules);
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        const QVariantMap config = iterator.value().toMap();
+        const QByteArray recordMarker = config.value("records").toString().toUtf8();
+        const QVariantMap nextPage = config.value("nextPage").toMap();
+        ScraperRule rule;
+        rule.url = config.value("url").toString().replace("{baseUrl}", m_baseUrl);
+        rule.extractor.setRecordMarker(recordMarker);
+        rule.pageParameter = nextPage.value("parameter").toString();
+        rule.minimumItems = nextPage.value("minimumItems").toInt();
+        rule.records = !recordMarker.isEmpty();
+        QMapIterator<QString, QVariant> fields(config.value("fields").toMap());
+        
+        while (fields.hasNext()) {
+            fields.next();
+            const QVariantMap field = fields.value().toMap();
+            const QString prefix = field.value("prefix").toString().replace("{baseUrl}", m_baseUrl);
+            QList<QByteArray> markers;
+            
+            foreach (const QString &marker, field.value("markers").toStringList()) {
+                markers << marker.toUtf8();
+            }
+            
+            // Fields are per record on list pages, unless they are marked as page fields (e.g. a "next" link)
+            const HtmlExtractor::Scope scope = (rule.records) && (field.value("scope").toString() != "page")
+                                               ? HtmlExtractor::Record : HtmlExtractor::Page;
+            rule.extractor.addField(fields.key(), markers, field.value("end").toString().toUtf8(), scope);
+            
+            if (!prefix.isEmpty()) {
+                rule.prefixes[fields.key()] = prefix;
+            }
+            
+            if (field.value("type").toString() == "integer") {
+                rule.integers << fields.key();
+            }
+        }
+        
+        m_rules[method + "/" + iterator.key()] = rule;
+    }
+}
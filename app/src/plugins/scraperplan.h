@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCRAPERPLAN_H
+#define SCRAPERPLAN_H
+
+#include "htmlextractor.h"
+#include <QObject>
+#include <QSet>
+
+struct ScraperRule
+{
+    ScraperRule() :
+        minimumItems(0),
+        records(false)
+    {
+    }
+    
+    QString url;
+    
+    HtmlExtractor extractor;
+    
+    QHash<QString, QString> prefixes;
+    QSet<QString> integers;
+    
+    QString pageParameter;
+    int minimumItems;
+    
+    bool records;
+};
+
+/*
+ * The compiled form of a declarative ("scraper") plugin file.
+ *
+ * The file is JSON, with a rule for each supported method and resource type:
+ *
+ * {
+ *     "baseUrl": "http://www.example.com",
+ *     "headers": {"Cookie": "platform=tablet"},
+ *     "list": {
+ *         "video": {
+ *             "url": "{baseUrl}/videos?c={id}",
+ *             "records": "<li class=\"video",
+ *             "fields": {
+ *                 "id": {"markers": ["href=\""], "end": "\"", "prefix": "{baseUrl}"},
+ *                 "title": {"markers": ["title=\""], "end": "\""},
+ *                 "viewCount": {"markers": ["class=\"views\">"], "end": "<", "type": "integer"}
+ *             },
+ *             "nextPage": {"parameter": "page", "minimumItems": 20}
+ *         }
+ *     }
+ * }
+ *
+ * URLs may use {baseUrl}, {id}, {query} and {order}. An absolute resource id (such as a "next" URL) is requested
+ * as-is. A page-scoped field named "next" can be used instead of "nextPage". The file is compiled once, and the plan
+ * is shared by all requests of the plugin.
+ */
+class ScraperPlan : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ScraperPlan(const QString &fileName, QObject *parent = 0);
+    
+    QString baseUrl() const;
+    
+    QString errorString() const;
+    
+    QString fileName() const;
+    
+    QHash<QByteArray, QByteArray> headers() const;
+    
+    bool isLoaded() const;
+    
+    const ScraperRule* rule(const QString &method, const QString &resourceType) const;
+
+public Q_SLOTS:
+    bool load();
+
+private:
+    void addRules(const QString &method, const QVariantMap &rules);
+    
+    QString m_baseUrl;
+    QString m_errorString;
+    QString m_fileName;
+    
+    QHash<QByteArray, QByteArray> m_headers;
+    
+    QHash<QString, ScraperRule> m_rules;
+    
+    bool m_loaded;
+};
+
+#endif // SCRAPERPLAN_H
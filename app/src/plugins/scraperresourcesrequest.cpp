@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "scraperresourcesrequest.h"
+#include "logger.h"
+#include "scraperplan.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRegExp>
+#if QT_VERSION >= 0x050000
+#include <QUrlQuery>
+#endif
+
+const int ScraperResourcesRequest::MAX_REDIRECTS = 8;
+
+ScraperResourcesRequest::ScraperResourcesRequest(ScraperPlan *plan, QNetworkAccessManager *manager,
+                                                 QObject *parent) :
+    ResourcesRequest(parent),
+    m_plan(plan),
+    m_nam(manager),
+    m_rule(0),
+    m_redirects(0),
+    m_status(Null)
+{
+}
+
+QString ScraperResourcesRequest::errorString() const {
+    return m_errorString;
+}
+
+void ScraperResourcesRequest::setErrorString(const QString &e) {
+    m_errorString = e;
+}
+
+QVariant ScraperResourcesRequest::result() const {
+    return m_result;
+}
+
+void ScraperResourcesRequest::setResult(const QVariant &r) {
+    m_result = r;
+}
+
+ResourcesRequest::Status ScraperResourcesRequest::status() const {
+    return m_status;
+}
+
+void ScraperResourcesRequest::setStatus(ResourcesRequest::Status s) {
+    if (s != status()) {
+        m_status = s;
+        emit statusChanged(s);
+    }
+}
+
+QNetworkAccessManager* ScraperResourcesRequest::networkAccessManager() {
+    return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
+}
+
+bool ScraperResourcesRequest::cancel() {
+    if (status() != Loading) {
+        return false;
+    }
+    
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+        m_reply = 0;
+    }
+    
+    setStatus(Canceled);
+    emit finished();
+    return true;
+}
+
+bool ScraperResourcesRequest::get(const QString &resourceType, const QString &resourceId) {
+    return start("get", resourceType, resourceId);
+}
+
+bool ScraperResourcesRequest::list(const QString &resourceType, const QString &resourceId) {
+    return start("list", resourceType, resourceId);
+}
+
+bool ScraperResourcesRequest::search(const QString &resourceType, const QString &query, const QString &order) {
+    return start("search", resourceType, QString(), query, order);
+}
+
+bool ScraperResourcesRequest::start(const QString &method, const QString &resourceType, const QString &resourceId,
+                                    const QString &query, const QString &order) {
+    if ((status() == Loading) || (!m_plan)) {
+        return false;
+    }
+    
+    if (!m_plan->load()) {
+        setErrorString(m_plan->errorString());
+        setStatus(Failed);
+        emit finished();
+        return false;
+    }
+    
+    m_rule = m_plan->rule(method, resourceType);
+    
+    if (!m_rule) {
+        Logger::log(QString("ScraperResourcesRequest::start(). No rule for %1 %2").arg(method).arg(resourceType));
+        return false;
+    }
+    
+    QString url;
+    
+    // Absolute ids, such as the "next" URL of a list, are requested as-is
+    if ((resourceId.startsWith("http://")) || (resourceId.startsWith("https://"))) {
+        url = resourceId;
+    }
+    else {
+        url = m_rule->url;
+        url.replace("{id}", resourceId);
+        url.replace("{query}", QString::fromUtf8(QUrl::toPercentEncoding(query)));
+        url.replace("{order}", order);
+    }
+    
+    m_resourceId = resourceId;
+    m_redirects = 0;
+    setErrorString(QString());
+    setResult(QVariant());
+    setStatus(Loading);
+    Logger::log(QString("ScraperResourcesRequest::start(). Method: %1, Resource type: %2, URL: %3").arg(method)
+                       .arg(resourceType).arg(url), Logger::MediumVerbosity);
+    followUrl(QUrl::fromEncoded(url.toUtf8()));
+    return true;
+}
+
+void ScraperResourcesRequest::followUrl(const QUrl &url) {
+    QNetworkRequest request(url);
+    QHashIterator<QByteArray, QByteArray> iterator(m_plan->headers());
+    
+    while (iterator.hasNext()) {
+        iterator.next();
+        request.setRawHeader(iterator.key(), iterator.value());
+    }
+    
+    m_reply = networkAccessManager()->get(request);
+    connect(m_reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+}
+
+QVariant ScraperResourcesRequest::fieldValue(const QString &name, const QString &value) const {
+    const QString v = value.trimmed();
+    
+    if (m_rule->integers.contains(name)) {
+        return QString(v).remove(QRegExp("\\D")).toInt();
+    }
+    
+    if ((!v.isEmpty()) && (m_rule->prefixes.contains(name)) && (!v.contains("://"))) {
+        return m_rule->prefixes.value(name) + v;
+    }
+    
+    return v;
+}
+
+QUrl ScraperResourcesRequest::incrementPageNumber(QUrl url, const QString &parameter) {
+#if QT_VERSION >= 0x050000
+    QUrlQuery query(url);
+    const int page = qMax(2, query.queryItemValue(parameter).toInt() + 1);
+    query.removeQueryItem(parameter);
+    query.addQueryItem(parameter, QString::number(page));
+    url.setQuery(query);
+#else
+    const int page = qMax(2, url.queryItemValue(parameter).toInt() + 1);
+    url.removeQueryItem(parameter);
+    url.addQueryItem(parameter, QString::number(page));
+#endif
+    return url;
+}
+
+void ScraperResourcesRequest::onReplyFinished() {
+    QNetworkReply *reply = m_reply;
+    m_reply = 0;
+    
+    if (!reply) {
+        setErrorString(tr("Network error"));
+        setStatus(Failed);
+        emit finished();
+        return;
+    }
+    
+    reply->deleteLater();
+    
+    if ((!m_plan) || (!m_rule)) {
+        setErrorString(tr("Plugin unavailable"));
+        setStatus(Failed);
+        emit finished();
+        return;
+    }
+    
+    const QUrl redirect = reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
+    
+    if (!redirect.isEmpty()) {
+        if (m_redirects < MAX_REDIRECTS) {
+            m_redirects++;
+            followUrl(reply->url().resolved(redirect));
+        }
+        else {
+            setErrorString(tr("Maximum redirects reached"));
+            setStatus(Failed);
+            emit finished();
+        }
+        
+        return;
+    }
+    
+    if (reply->error() != QNetworkReply::NoError) {
+        setErrorString(reply->errorString());
+        setStatus(Failed);
+        emit finished();
+        return;
+    }
+    
+    QList<HtmlExtractor::Fields> records;
+    const HtmlExtractor::Fields fields = m_rule->extractor.extract(reply->readAll(), &records);
+    
+    if (m_rule->records) {
+        QVariantMap response;
+        QVariantList items;
+        
+        foreach (const HtmlExtractor::Fields &record, records) {
+            QVariantMap item;
+            HtmlExtractor::Fields::const_iterator iterator = record.constBegin();
+            
+            while (iterator != record.constEnd()) {
+                item[iterator.key()] = fieldValue(iterator.key(), iterator.value());
+                ++iterator;
+            }
+            
+            items << item;
+        }
+        
+        response["items"] = items;
+        const QString next = fieldValue("next", fields.value("next")).toString();
+        
+        if (!next.isEmpty()) {
+            response["next"] = next;
+        }
+        else if ((!m_rule->pageParameter.isEmpty()) && (!items.isEmpty())
+                 && (items.size() >= m_rule->minimumItems)) {
+            response["next"] = incrementPageNumber(reply->url(), m_rule->pageParameter).toString();
+        }
+        
+        setResult(response);
+    }
+    else {
+        QVariantMap item;
+        HtmlExtractor::Fields::const_iterator iterator = fields.constBegin();
+        
+        while (iterator != fields.constEnd()) {
+            item[iterator.key()] = fieldValue(iterator.key(), iterator.value());
+            ++iterator;
+        }
+        
+        if (!item.contains("id")) {
+            item["id"] = m_resourceId;
+        }
+        
+        setResult(item);
+    }
+    
+    setStatus(Ready);
+    emit finished();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCRAPERRESOURCESREQUEST_H
+#define SCRAPERRESOURCESREQUEST_H
+
+#include "resourcesrequest.h"
+#include <QPointer>
+#include <QUrl>
+
+class ScraperPlan;
+struct ScraperRule;
+class QNetworkReply;
+
+class ScraperResourcesRequest : public ResourcesRequest
+{
+    Q_OBJECT
+
+public:
+    explicit ScraperResourcesRequest(ScraperPlan *plan, QNetworkAccessManager *manager, QObject *parent = 0);
+
+    virtual QString errorString() const;
+
+    virtual QVariant result() const;
+
+    virtual Status status() const;
+
+public Q_SLOTS:
+    virtual bool cancel();
+    virtual bool get(const QString &resourceType, const QString &resourceId);
+    virtual bool list(const QString &resourceType, const QString &resourceId);
+    virtual bool search(const QString &resourceType, const QString &query, const QString &order);
+
+private Q_SLOTS:
+    void onReplyFinished();
+
+private:
+    void setErrorString(const QString &e);
+    
+    void setResult(const QVariant &r);
+    
+    void setStatus(Status s);
+    
+    QNetworkAccessManager* networkAccessManager();
+    
+    bool start(const QString &method, const QString &resourceType, const QString &resourceId,
+               const QString &query = QString(), const QString &order = QString());
+    
+    void followUrl(const QUrl &url);
+    
+    QVariant fieldValue(const QString &name, const QString &value) const;
+    
+    static QUrl incrementPageNumber(QUrl url, const QString &parameter);
+    
+    static const int MAX_REDIRECTS;
+    
+    QPointer<ScraperPlan> m_plan;
+    
+    QPointer<QNetworkAccessManager> m_nam;
+    
+    QPointer<QNetworkReply> m_reply;
+    
+    const ScraperRule *m_rule;
+    
+    QString m_resourceId;
+    
+    int m_redirects;
+    
+    QString m_errorString;
+
+    QVariant m_result;
+
+    Status m_status;
+};
+
+#endif // SCRAPERRESOURCESREQUEST_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "scraperserviceplugin.h"
+#include "scraperplan.h"
+#include "scraperresourcesrequest.h"
+#include <QNetworkAccessManager>
+
+ScraperServicePlugin::ScraperServicePlugin(QObject *parent) :
+    QObject(parent),
+    ServicePlugin(),
+    m_plan(0)
+{
+}
+
+ScraperServicePlugin::ScraperServicePlugin(const QString &id, const QString &fileName, QObject *parent) :
+    QObject(parent),
+    ServicePlugin(),
+    m_plan(0),
+    m_fileName(fileName),
+    m_id(id)
+{
+}
+
+QString ScraperServicePlugin::fileName() const {
+    return m_fileName;
+}
+
+void ScraperServicePlugin::setFileName(const QString &fileName) {
+    if (fileName != m_fileName) {
+        m_fileName = fileName;
+        
+        if (m_plan) {
+            delete m_plan;
+            m_plan = 0;
+        }
+    }
+}
+
+QString ScraperServicePlugin::id() const {
+    return m_id;
+}
+
+void ScraperServicePlugin::setId(const QString &id) {
+    m_id = id;
+}
+
+ResourcesRequest* ScraperServicePlugin::createRequest(QObject *parent) {
+    return new ScraperResourcesRequest(plan(), m_nam, parent);
+}
+
+void ScraperServicePlugin::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
+
+ScraperPlan* ScraperServicePlugin::plan() {
+    return m_plan ? m_plan : m_plan = new ScraperPlan(fileName(), this);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCRAPERSERVICEPLUGIN_H
+#define SCRAPERSERVICEPLUGIN_H
+
+#include "serviceplugin.h"
+#include <QPointer>
+
+class ScraperPlan;
+
+class ScraperServicePlugin : public QObject, public ServicePlugin
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString fileName READ fileName WRITE setFileName)
+    Q_PROPERTY(QString id READ id WRITE setId)
+    
+    Q_INTERFACES(ServicePlugin)
+
+public:
+    explicit ScraperServicePlugin(QObject *parent = 0);
+    explicit ScraperServicePlugin(const QString &id, const QString &fileName, QObject *parent = 0);
+    
+    QString fileName() const;
+    void setFileName(const QString &fileName);
+
+    QString id() const;
+    void setId(const QString &id);
+    
+    virtual ResourcesRequest* createRequest(QObject *parent = 0);
+    
+    virtual void setNetworkAccessManager(QNetworkAccessManager *manager);
+
+private:
+    ScraperPlan* plan();
+    
+    ScraperPlan *m_plan;
+    
+    QPointer<QNetworkAccessManager> m_nam;
+    
+    QString m_fileName;
+    QString m_id;
+};
+
+#endif // SCRAPERSERVICEPLUGIN_H
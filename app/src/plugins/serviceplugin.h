@@ -27,8 +27,12 @@ public:
     virtual ~ServicePlugin() {}
     
     virtual ResourcesRequest* createRequest(QObject *parent = 0) = 0;
+    
+    // Called by the host before any requests are created. Plugins should use the shared manager for their requests
+    // instead of creating their own, so that connections and cookies are reused.
+    virtual void setNetworkAccessManager(QNetworkAccessManager *) {}
 };
 
-Q_DECLARE_INTERFACE(ServicePlugin, "org.cutetube2.ServicePlugin")
+Q_DECLARE_INTERFACE(ServicePlugin, "org.cutetube2.ServicePlugin/2")
 
 #endif // SERVICEPLUGIN_H
@@ -23,10 +23,20 @@
 
 ServicePluginConfig::ServicePluginConfig(QObject *parent) :
     QObject(parent),
-    m_version(1)
+    m_version(1),
+    m_workerEnabled(false),
+    m_workerIdleTimeout(60)
 {
 }
 
+QVariantMap ServicePluginConfig::cacheMaximumAges() const {
+    return m_cacheMaximumAges;
+}
+
+QVariantMap ServicePluginConfig::connectionLimits() const {
+    return m_connectionLimits;
+}
+
 QString ServicePluginConfig::displayName() const {
     return m_displayName;
 }
@@ -55,25 +65,47 @@ int ServicePluginConfig::version() const {
     return m_version;
 }
 
-bool ServicePluginConfig::load(const QString &filePath) {
-    m_filePath = filePath;
+bool ServicePluginConfig::workerEnabled() const {
+    return m_workerEnabled;
+}
+
+int ServicePluginConfig::workerIdleTimeout() const {
+    return m_workerIdleTimeout;
+}
+
+QVariantMap ServicePluginConfig::parse(const QString &filePath, bool *ok) {
+    // Called from worker threads by PluginManager, so must not log
     QFile file(filePath);
+    bool parsed = false;
+    QVariant v;
 
-    if ((!file.exists()) || (!file.open(QFile::ReadOnly))) {
-        Logger::log("ServicePluginConfig::load(): Unable to open config file: " + filePath);
-        return false;
+    if (file.open(QFile::ReadOnly)) {
+        v = QtJson::Json::parse(QString::fromUtf8(file.readAll()), parsed);
+        file.close();
+    }
+    
+    if (ok) {
+        *ok = parsed;
     }
 
+    return v.toMap();
+}
+
+bool ServicePluginConfig::load(const QString &filePath) {
     bool ok;
-    const QVariant v = QtJson::Json::parse(QString::fromUtf8(file.readAll()), ok);
-    file.close();
+    const QVariantMap config = parse(filePath, &ok);
 
     if (!ok) {
+        m_filePath = filePath;
         Logger::log("ServicePluginConfig::load(): Error parsing config file: " + filePath);
         return false;
     }
 
-    const QVariantMap config = v.toMap();
+    return load(filePath, config);
+}
+
+bool ServicePluginConfig::load(const QString &filePath, const QVariantMap &config) {
+    m_filePath = filePath;
 
     if (!config.contains("name")) {
         Logger::log("ServicePluginConfig::load(): 'name' parameter is missing");
@@ -95,6 +127,18 @@ bool ServicePluginConfig::load(const QString &filePath) {
     m_settings = config.value("settings").toList();
     m_version = qMax(1, config.value("version").toInt());
     
+    // Plugins can override the freshness of cached responses from their own hosts by URL prefix,
+    // e.g. "cache": {"http://example.com/": 300}
+    m_cacheMaximumAges = config.value("cache").toMap();
+    
+    // Plugins can limit concurrent connections to a host, e.g. "connectionLimits": {"www.example.com": 2}
+    m_connectionLimits = config.value("connectionLimits").toMap();
+    
+    // External plugins can opt in to a long-lived worker process, e.g. "worker": {"idleTimeout": 120}
+    const QVariant worker = config.value("worker");
+    m_workerEnabled = (worker.type() == QVariant::Map) || (worker.toBool());
+    m_workerIdleTimeout = qMax(1, worker.toMap().value("idleTimeout", 60).toInt());
+    
     if (m_pluginType == "qt") {
         m_pluginFilePath = filePath.left(slash + 1) + LIB_PREFIX + m_id + LIB_SUFFIX;
     }
@@ -105,6 +149,7 @@ bool ServicePluginConfig::load(const QString &filePath) {
     m_getResources.clear();
     m_listResources.clear();
     m_searchResources.clear();
+    m_capabilities.clear();
 
     foreach (const QVariant &v, config.value("resources").toList()) {
         const QVariantMap resource = v.toMap();
@@ -112,12 +157,15 @@ bool ServicePluginConfig::load(const QString &filePath) {
 
         if (method == "get") {
             m_getResources << GetResource(resource);
+            m_capabilities[m_getResources.last().type()] |= GetMethod;
         }
         else if (method == "list") {
             m_listResources << ListResource(resource);
+            m_capabilities[m_listResources.last().type()] |= ListMethod;
         }
         else if (method == "search") {
             m_searchResources << SearchResource(resource);
+            m_capabilities[m_searchResources.last().type()] |= SearchMethod;
         }
     }
 
@@ -138,27 +186,18 @@ QList<SearchResource> ServicePluginConfig::searchResources() const {
 }
 
 bool ServicePluginConfig::resourceTypeIsSupported(const QString &resourceType, const QString &method) const {
-    if (method == "get") {
-        foreach (const GetResource &resource, m_getResources) {
-            if (resource.type() == resourceType) {
-                return true;
-            }
-        }
+    // Supported methods are stored as flags per resource type, so this is called often without allocating
+    int flag = 0;
+    
+    if (method == QLatin1String("get")) {
+        flag = GetMethod;
     }
-    else if (method == "list") {
-        foreach (const ListResource &resource, m_listResources) {
-            if (resource.type() == resourceType) {
-                return true;
-            }
-        }
+    else if (method == QLatin1String("list")) {
+        flag = ListMethod;
     }
-    else if (method == "search") {
-        foreach (const SearchResource &resource, m_searchResources) {
-            if (resource.type() == resourceType) {
-                return true;
-            }
-        }
+    else if (method == QLatin1String("search")) {
+        flag = SearchMethod;
     }
 
-    return false;
+    return m_capabilities.value(resourceType) & flag;
 }
@@ -19,12 +19,15 @@
 #define SERVICEPLUGINCONFIG_H
 
 #include "resources.h"
+#include <QHash>
 #include <QVariantList>
 
 class ServicePluginConfig : public QObject
 {
     Q_OBJECT
 
+    Q_PROPERTY(QVariantMap cacheMaximumAges READ cacheMaximumAges NOTIFY changed)
+    Q_PROPERTY(QVariantMap connectionLimits READ connectionLimits NOTIFY changed)
     Q_PROPERTY(QString displayName READ displayName NOTIFY changed)
     Q_PROPERTY(QString filePath READ filePath NOTIFY changed)
     Q_PROPERTY(QString id READ id NOTIFY changed)
@@ -35,9 +38,15 @@ class ServicePluginConfig : public QObject
     Q_PROPERTY(QList<SearchResource> searchResources READ searchResources NOTIFY changed)
     Q_PROPERTY(QVariantList settings READ settings NOTIFY changed)
     Q_PROPERTY(int version READ version NOTIFY changed)
+    Q_PROPERTY(bool workerEnabled READ workerEnabled NOTIFY changed)
+    Q_PROPERTY(int workerIdleTimeout READ workerIdleTimeout NOTIFY changed)
 
 public:
     explicit ServicePluginConfig(QObject *parent = 0);
+    
+    QVariantMap cacheMaximumAges() const;
+    
+    QVariantMap connectionLimits() const;
 
     QString displayName() const;
     
@@ -56,16 +65,31 @@ public:
     QVariantList settings() const;
     
     int version() const;
+    
+    bool workerEnabled() const;
+    int workerIdleTimeout() const;
+    
+    static QVariantMap parse(const QString &filePath, bool *ok = 0);
 
 public Q_SLOTS:
     bool resourceTypeIsSupported(const QString &resourceType, const QString &method = QString("list")) const;
     
     bool load(const QString &filePath);
+    bool load(const QString &filePath, const QVariantMap &config);
 
 Q_SIGNALS:
     void changed();
 
 private:
+    enum Method {
+        GetMethod = 0x1,
+        ListMethod = 0x2,
+        SearchMethod = 0x4
+    };
+    
+    QVariantMap m_cacheMaximumAges;
+    QVariantMap m_connectionLimits;
+    
     QString m_displayName;
     QString m_filePath;
     QString m_id;
@@ -77,7 +101,12 @@ private:
     QList<SearchResource> m_searchResources;
     QVariantList m_settings;
     
+    QHash<QString, int> m_capabilities;
+    
     int m_version;
+    
+    bool m_workerEnabled;
+    int m_workerIdleTimeout;
 };
 
 #endif // SERVICEPLUGINCONFIG_H
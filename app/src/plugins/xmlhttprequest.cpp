@@ -20,6 +20,7 @@
 #include <QBuffer>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QScriptEngine>
 
 XMLHttpRequest::XMLHttpRequest(QObject *parent) :
     QObject(parent),
@@ -27,7 +28,8 @@ XMLHttpRequest::XMLHttpRequest(QObject *parent) :
     m_reply(0),
     m_readyState(UNSENT),
     m_status(0),
-    m_redirects(0)
+    m_redirects(0),
+    m_decoded(0)
 {
 }
 
@@ -37,7 +39,8 @@ XMLHttpRequest::XMLHttpRequest(QNetworkAccessManager *manager, QObject *parent)
     m_reply(0),
     m_readyState(UNSENT),
     m_status(0),
-    m_redirects(0)
+    m_redirects(0),
+    m_decoded(0)
 {
 }
 
@@ -58,12 +61,67 @@ void XMLHttpRequest::setReadyState(int state) {
     }
 }
 
+QScriptValue XMLHttpRequest::response() const {
+    if (responseType() != "arraybuffer") {
+        return QScriptValue(responseText());
+    }
+    
+    if (readyState() != DONE) {
+        return QScriptValue();
+    }
+    
+    // QtScript has no ArrayBuffer, so the bytes are returned as an array of numbers. The array is built once per
+    // response, so that every read returns the same script object
+    if ((!m_responseBytes.isValid()) && (engine())) {
+        m_responseBytes = engine()->newArray(m_response.size());
+        
+        for (int i = 0; i < m_response.size(); i++) {
+            m_responseBytes.setProperty(i, int(uchar(m_response.at(i))));
+        }
+    }
+    
+    return m_responseBytes;
+}
+
 QString XMLHttpRequest::responseText() const {
-    return readyState() == DONE ? QString::fromUtf8(m_response) : QString();
+    if ((readyState() < LOADING) || (responseType() == "arraybuffer")) {
+        return QString();
+    }
+    
+    // Only the bytes received since the last call are decoded
+    if (m_decoded < m_response.size()) {
+        if (!m_decoder) {
+            m_decoder.reset(QTextCodec::codecForName("UTF-8")->makeDecoder());
+        }
+        
+        m_responseText.append(m_decoder->toUnicode(m_response.constData() + m_decoded,
+                                                   m_response.size() - m_decoded));
+        m_decoded = m_response.size();
+    }
+    
+    return m_responseText;
 }
 
 QString XMLHttpRequest::responseXML() const {
-    return readyState() == DONE ? QString::fromUtf8(m_response) : QString();
+    return readyState() == DONE ? responseText() : QString();
+}
+
+QString XMLHttpRequest::responseType() const {
+    return m_responseType;
+}
+
+void XMLHttpRequest::setResponseType(const QString &type) {
+    if (readyState() >= LOADING) {
+        Logger::log("XMLHttpRequest::setResponseType(): Cannot set responseType while loading");
+        return;
+    }
+    
+    if ((type.isEmpty()) || (type == "text") || (type == "arraybuffer")) {
+        m_responseType = type;
+    }
+    else {
+        Logger::log("XMLHttpRequest::setResponseType(): Unsupported responseType: " + type);
+    }
 }
 
 int XMLHttpRequest::status() const {
@@ -82,6 +140,14 @@ void XMLHttpRequest::setStatusText(const QString &text) {
     m_statusText = text;
 }
 
+QScriptValue XMLHttpRequest::onProgress() const {
+    return m_onProgress;
+}
+
+void XMLHttpRequest::setOnProgress(const QScriptValue &function) {
+    m_onProgress = function;
+}
+
 QScriptValue XMLHttpRequest::onReadyStateChange() const {
     return m_onReadyStateChange;
 }
@@ -174,7 +240,7 @@ void XMLHttpRequest::abort() {
 void XMLHttpRequest::followRedirect(const QUrl &url) {
     Logger::log("XMLHttpRequest::followRedirect(): URL: " + url.toString(), Logger::MediumVerbosity);
     m_redirects++;
-    m_response = QByteArray();
+    clearResponse();
     QNetworkRequest request(m_request);
     request.setUrl(url);
     m_reply = networkAccessManager()->get(request);
@@ -189,8 +255,29 @@ void XMLHttpRequest::reset() {
     setStatus(0);
     setStatusText(QString());
     m_request = QNetworkRequest();
-    m_response = QByteArray();
     m_responseHeaders.clear();
+    clearResponse();
+}
+
+void XMLHttpRequest::clearResponse() {
+    m_response.clear();
+    m_responseText.clear();
+    m_responseBytes = QScriptValue();
+    m_decoder.reset();
+    m_decoded = 0;
+}
+
+void XMLHttpRequest::progress() {
+    if (!m_onProgress.isFunction()) {
+        return;
+    }
+    
+    const qint64 total = m_reply ? m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong() : 0;
+    QScriptValue event = m_onProgress.engine()->newObject();
+    event.setProperty("lengthComputable", total > 0);
+    event.setProperty("loaded", m_response.size());
+    event.setProperty("total", double(total));
+    m_onProgress.call(QScriptValue(), QScriptValueList() << event);
 }
 
 void XMLHttpRequest::onReplyMetaDataChanged() {
@@ -208,7 +295,17 @@ void XMLHttpRequest::onReplyMetaDataChanged() {
 }
 
 void XMLHttpRequest::onReplyReadyRead() {
+    // The body of a redirect is not part of the response
+    if (!m_reply->rawHeader("Location").isEmpty()) {
+        return;
+    }
+    
     m_response += m_reply->readAll();
+    
+    if (readyState() == LOADING) {
+        m_onReadyStateChange.call(QScriptValue());
+        progress();
+    }
 }
 
 void XMLHttpRequest::onReplyFinished() {
@@ -237,6 +334,7 @@ void XMLHttpRequest::onReplyFinished() {
     
     if (m_reply->bytesAvailable() > 0) {
         m_response += m_reply->readAll();
+        progress();
     }
     
     setStatus(m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt());
@@ -20,20 +20,26 @@
 #include <QObject>
 #include <QNetworkRequest>
 #include <QPointer>
+#include <QScopedPointer>
+#include <QScriptable>
 #include <QScriptValue>
+#include <QTextDecoder>
 
 class QNetworkAccessManager;
 class QNetworkReply;
 
-class XMLHttpRequest : public QObject
+class XMLHttpRequest : public QObject, protected QScriptable
 {
     Q_OBJECT
 
     Q_PROPERTY(int readyState READ readyState)
+    Q_PROPERTY(QScriptValue response READ response)
     Q_PROPERTY(QString responseText READ responseText)
+    Q_PROPERTY(QString responseType READ responseType WRITE setResponseType)
     Q_PROPERTY(QString responseXML READ responseXML)
     Q_PROPERTY(int status READ status)
     Q_PROPERTY(QString statusText READ statusText)
+    Q_PROPERTY(QScriptValue onprogress READ onProgress WRITE setOnProgress)
     Q_PROPERTY(QScriptValue onreadystatechange READ onReadyStateChange WRITE setOnReadyStateChange)
 
     Q_ENUMS(ReadyState)
@@ -52,12 +58,19 @@ public:
 
     int readyState() const;
 
+    QScriptValue response() const;
     QString responseText() const;
     QString responseXML() const;
+    
+    QString responseType() const;
+    void setResponseType(const QString &type);
 
     int status() const;
     QString statusText() const;
 
+    QScriptValue onProgress() const;
+    void setOnProgress(const QScriptValue &function);
+    
     QScriptValue onReadyStateChange() const;
     void setOnReadyStateChange(const QScriptValue &function);
     
@@ -86,6 +99,10 @@ private:
     void setStatusText(const QString &text);
 
     void followRedirect(const QUrl &redirect);
+    
+    void progress();
+    
+    void clearResponse();
 
     void reset();
     
@@ -102,9 +119,17 @@ private:
     
     QByteArray m_method;
     QByteArray m_response;
+    
+    QString m_responseType;
+    
+    mutable QString m_responseText;
+    mutable QScriptValue m_responseBytes;
+    mutable QScopedPointer<QTextDecoder> m_decoder;
+    mutable int m_decoded;
 
     QMap<QString, QString> m_responseHeaders;
 
+    QScriptValue m_onProgress;
     QScriptValue m_onReadyStateChange;
 };
 
@@ -31,7 +31,20 @@ inline void initDatabase() {
         db.open();
     }
     
-    QSqlQuery query = db.exec("CREATE TABLE IF NOT EXISTS dailymotionAccounts (userId TEXT UNIQUE, username TEXT, \
+    // Writes (e.g. refreshed access tokens) then do not block readers of the database
+    QSqlQuery query = db.exec("PRAGMA journal_mode = WAL");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
+    
+    query = db.exec("PRAGMA synchronous = NORMAL");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
+    
+    query = db.exec("CREATE TABLE IF NOT EXISTS dailymotionAccounts (userId TEXT UNIQUE, username TEXT, \
     accessToken TEXT, refreshToken TEXT, scopes TEXT)");
     
     if (query.lastError().isValid()) {
@@ -51,6 +64,34 @@ inline void initDatabase() {
     if (query.lastError().isValid()) {
         Logger::log("initDatabase: database error: " + query.lastError().text());
     }
+    
+    query = db.exec("CREATE TABLE IF NOT EXISTS subscriptions (service TEXT, userId TEXT, id TEXT, \
+    subscriptionId TEXT, UNIQUE (service, userId, id))");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
+    
+    query = db.exec("CREATE TABLE IF NOT EXISTS subscriptionSyncs (service TEXT, userId TEXT, synced TEXT, \
+    UNIQUE (service, userId))");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
+    
+    query = db.exec("CREATE TABLE IF NOT EXISTS library (id INTEGER PRIMARY KEY, service TEXT, videoId TEXT, \
+    title TEXT, category TEXT, filePath TEXT UNIQUE, size INTEGER, date TEXT)");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
+    
+    // Full-text index of the library, keyed by library.id (docid)
+    query = db.exec("CREATE VIRTUAL TABLE IF NOT EXISTS libraryText USING fts3(title, fileName, category)");
+    
+    if (query.lastError().isValid()) {
+        Logger::log("initDatabase: database error: " + query.lastError().text());
+    }
 }
 
 inline QSqlDatabase getDatabase() {
@@ -56,6 +56,9 @@ static const int DOWNLOAD_BUFFER_SIZE = 512000;
 static const int MAX_CONCURRENT_TRANSFERS = 4;
 static const int MAX_REDIRECTS = 8;
 static const int MAX_RESULTS = 20;
+static const QString PLUGIN_CACHE_PATH(APP_CONFIG_PATH + "cache/plugins/");
+static const qint64 PLUGIN_CACHE_SIZE = 5 * 1024 * 1024;
+static const QString PLUGIN_INDEX_PATH(APP_CONFIG_PATH + "cache/plugins.index");
 static const QByteArray USER_AGENT("Wget/1.13.4 (linux-gnu)");
 
 // Appearance
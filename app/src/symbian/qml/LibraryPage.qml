@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 1.1
+import com.nokia.symbian 1.1
+import cuteTube 2.0
+
+MyPage {
+    id: root
+
+    title: qsTr("Library")
+    tools: ToolBarLayout {
+
+        BackToolButton {}
+
+        MyToolButton {
+            iconSource: "toolbar-delete"
+            toolTipText: qsTr("Remove missing files")
+            onClicked: libraryModel.prune()
+        }
+    }
+
+    MyTextField {
+        id: searchField
+
+        anchors {
+            left: parent.left
+            right: parent.right
+            top: parent.top
+            margins: platformStyle.paddingLarge
+        }
+        placeholderText: qsTr("Search")
+        inputMethodHints: Qt.ImhNoPredictiveText
+        clearButtonEnabled: true
+        onTextChanged: libraryModel.search(text)
+        onAccepted: closeSoftwareInputPanel()
+    }
+
+    MyListView {
+        id: view
+
+        anchors {
+            left: parent.left
+            right: parent.right
+            top: searchField.bottom
+            topMargin: platformStyle.paddingLarge
+            bottom: parent.bottom
+        }
+        clip: true
+        cacheBuffer: 400
+        model: LibraryModel {
+            id: libraryModel
+        }
+        delegate: MyListItem {
+            id: delegate
+
+            MyListItemText {
+                id: titleLabel
+
+                anchors {
+                    left: parent.left
+                    leftMargin: platformStyle.paddingLarge
+                    right: parent.right
+                    rightMargin: platformStyle.paddingLarge
+                    top: parent.top
+                    topMargin: platformStyle.paddingMedium
+                }
+                role: "Title"
+                mode: delegate.mode
+                text: title
+            }
+
+            MyListItemText {
+                anchors {
+                    left: titleLabel.left
+                    right: titleLabel.right
+                    top: titleLabel.bottom
+                    topMargin: platformStyle.paddingSmall
+                }
+                role: "SubTitle"
+                mode: delegate.mode
+                text: category ? category + " - " + fileName : fileName
+            }
+
+            onClicked: VideoLauncher.playVideo(url)
+            onPressAndHold: {
+                view.currentIndex = -1;
+                view.currentIndex = index;
+                contextMenu.open();
+            }
+        }
+        onAtYEndChanged: if ((atYEnd) && (libraryModel.count < libraryModel.total)) libraryModel.fetchMore();
+    }
+
+    MyScrollBar {
+        flickableItem: view
+    }
+
+    Label {
+        anchors {
+            fill: view
+            margins: platformStyle.paddingLarge
+        }
+        horizontalAlignment: Text.AlignHCenter
+        verticalAlignment: Text.AlignVCenter
+        wrapMode: Text.WordWrap
+        font.pixelSize: 40
+        color: platformStyle.colorNormalMid
+        text: qsTr("No videos found")
+        visible: libraryModel.count == 0
+    }
+
+    MyContextMenu {
+        id: contextMenu
+
+        focusItem: view
+
+        MenuLayout {
+
+            MenuItem {
+                text: qsTr("Remove from library")
+                onClicked: libraryModel.remove(view.currentIndex)
+            }
+        }
+    }
+}
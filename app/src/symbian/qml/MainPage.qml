@@ -86,6 +86,12 @@ MyPage {
             onClicked: appWindow.pageStack.push(Qt.resolvedUrl("TransfersPage.qml"))
         }
 
+        MyToolButton {
+            iconSource: "images/videofile.png"
+            toolTipText: qsTr("Library")
+            onClicked: appWindow.pageStack.push(Qt.resolvedUrl("LibraryPage.qml"))
+        }
+
         MyToolButton {
             iconSource: "toolbar-list"
             toolTipText: qsTr("Service")
@@ -200,6 +206,9 @@ MyPage {
                         appWindow.pageStack.push(Qt.resolvedUrl("youtube/YouTubeUsersPage.qml"), {title: qsTr("Subscriptions")})
                         .model.list("/subscriptions", ["snippet"], {mine: true}, {sort: "unread", maxResults: MAX_RESULTS});
                         break;
+                    case 8:
+                        appWindow.pageStack.push(Qt.resolvedUrl("youtube/YouTubeFeedPage.qml")).model.list();
+                        break;
                     }
                 }
             }
@@ -76,6 +76,7 @@ MyPage {
                 contextMenu.open();
             }
         }
+        onContentYChanged: videoModel.setVisibleRange(indexAt(0, contentY), indexAt(0, contentY + height - 1))
     }
 
     MyScrollBar {
@@ -170,6 +170,10 @@ void Transfer::setFileName(const QString &name) {
     }
 }
 
+QString Transfer::filePath() const {
+    return m_filePath;
+}
+
 QString Transfer::id() const {
     return m_id;
 }
@@ -577,6 +581,10 @@ void Transfer::moveDownloadedFiles() {
             setStatus(Failed);
             return;
         }
+        
+        if (oldFileName == fileName()) {
+            m_filePath = newFileName;
+        }
     }
         
     downDir.rmdir(downDir.path());
@@ -112,6 +112,8 @@ public:
     QString fileName() const;
     void setFileName(const QString &fn);
     
+    QString filePath() const;
+    
     QString id() const;
     void setId(const QString &i);
         
@@ -226,6 +228,7 @@ private:
     QString m_errorString;
     
     QString m_fileName;
+    QString m_filePath;
     
     QString m_id;
     
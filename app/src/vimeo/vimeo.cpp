@@ -15,11 +15,16 @@
  */
 
 #include "vimeo.h"
-#include "database.h"
+#include "accountstore.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
+#include "vimeoplaylist.h"
+#include "vimeosubscriptionindex.h"
+#include "vimeouser.h"
+#include "vimeovideo.h"
 #include <qvimeo/urls.h>
 #include <QSettings>
-#include <QSqlRecord>
 #if QT_VERSION >= 0x050000
 #include <QUrlQuery>
 #endif
@@ -34,13 +39,30 @@ const QStringList Vimeo::SCOPES = QStringList() << QVimeo::PUBLIC_SCOPE << QVime
 
 const QRegExp Vimeo::URL_REGEXP("http(s|)://vimeo.com/\\w+", Qt::CaseInsensitive);
 
-Vimeo::SubscriptionCache Vimeo::subscriptionCache;
-
 Vimeo* Vimeo::self = 0;
 
 Vimeo::Vimeo() :
     QObject()
 {
+    // Cached responses may be out of date once the user changes account or modifies their content
+    connect(this, SIGNAL(userIdChanged(QString)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistCreated(VimeoPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistDeleted(VimeoPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userSubscribed(VimeoUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userUnsubscribed(VimeoUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoAddedToPlaylist(VimeoVideo*,VimeoPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(VimeoVideo*,VimeoPlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoFavourited(VimeoVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoUnfavourited(VimeoVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoWatchLater(VimeoVideo*)), this, SLOT(clearResponseCache()));
+
+    // Changes are delivered only to the objects that represent the modified resource
+    connect(this, SIGNAL(userSubscribed(VimeoUser*)), this, SLOT(updateUser(VimeoUser*)));
+    connect(this, SIGNAL(userUnsubscribed(VimeoUser*)), this, SLOT(updateUser(VimeoUser*)));
+    connect(this, SIGNAL(videoAddedToPlaylist(VimeoVideo*,VimeoPlaylist*)), this, SLOT(updatePlaylist(VimeoVideo*,VimeoPlaylist*)));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(VimeoVideo*,VimeoPlaylist*)), this, SLOT(updatePlaylist(VimeoVideo*,VimeoPlaylist*)));
+    connect(this, SIGNAL(videoFavourited(VimeoVideo*)), this, SLOT(updateVideo(VimeoVideo*)));
+    connect(this, SIGNAL(videoUnfavourited(VimeoVideo*)), this, SLOT(updateVideo(VimeoVideo*)));
 }
 
 Vimeo::~Vimeo() {
@@ -55,6 +77,9 @@ void Vimeo::init() {
     if (accessToken().isEmpty()) {
         setUserId(QString());
     }
+    
+    // The stored subscriptions are read now, so that they are known before any user is shown
+    VimeoSubscriptionIndex::instance()->setUserId(userId());
 }
 
 QString Vimeo::getErrorString(const QVariantMap &error) {
@@ -99,9 +124,7 @@ void Vimeo::setUserId(const QString &id) {
     
     if (id != userId()) {
         QSettings().setValue("Vimeo/userId", id);
-        subscriptionCache.ids.clear();
-        subscriptionCache.filters.clear();
-        subscriptionCache.hasMore = true;
+        VimeoSubscriptionIndex::instance()->setUserId(id);
 
         if (self) {
             emit self->userIdChanged(id);
@@ -114,30 +137,13 @@ QString Vimeo::accessToken() {
         return CLIENT_TOKEN;
     }
     
-    QSqlQuery query = getDatabase().exec(QString("SELECT accessToken FROM vimeoAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("Vimeo::accessToken(): database error: " + query.lastError().text());
-        return QString();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString();
-    }
-    
-    return QString();
+    return AccountStore::value("vimeoAccounts", userId(), "accessToken").toString();
 }
 
 void Vimeo::setAccessToken(const QString &token) {
     Logger::log("Vimeo::setAccessToken(). Token: " + token, Logger::MediumVerbosity);
-    QSqlQuery query = getDatabase().exec(QString("UPDATE vimeoAccounts SET accessToken = '%1' WHERE userId = '%2'")
-                                                .arg(token).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("Vimeo::setAccessToken(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    
+    if ((AccountStore::setValue("vimeoAccounts", userId(), "accessToken", token)) && (self)) {
         emit self->accessTokenChanged(token);
     }
 }
@@ -207,23 +213,7 @@ void Vimeo::setScopes(const QStringList &s) {
 }
 
 bool Vimeo::hasScope(const QString &scope) {
-    if (userId().isEmpty()) {
-        return false;
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT scopes FROM vimeoAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("Vimeo::hasScope(): database error: " + query.lastError().text());
-        return false;
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString().contains(scope);
-    }
-    
-    return false;
+    return AccountStore::value("vimeoAccounts", userId(), "scopes").toString().contains(scope);
 }
 
 QString Vimeo::createScope() {
@@ -257,3 +247,37 @@ QString Vimeo::purchasedScope() {
 QString Vimeo::uploadScope() {
     return QVimeo::UPLOAD_SCOPE;
 }
+
+void Vimeo::clearResponseCache() {
+    ResponseCache::invalidate(Resources::VIMEO);
+}
+
+void Vimeo::updatePlaylist(VimeoVideo*, VimeoPlaylist *playlist) {
+    foreach (CTPlaylist *object, CTPlaylist::instances(playlist->service(), playlist->id())) {
+        if (object != playlist) {
+            if (VimeoPlaylist *p = qobject_cast<VimeoPlaylist*>(object)) {
+                p->CTPlaylist::loadPlaylist(playlist);
+            }
+        }
+    }
+}
+
+void Vimeo::updateUser(VimeoUser *user) {
+    foreach (CTUser *object, CTUser::instances(user->service(), user->id())) {
+        if (object != user) {
+            if (VimeoUser *u = qobject_cast<VimeoUser*>(object)) {
+                u->loadUser(user);
+            }
+        }
+    }
+}
+
+void Vimeo::updateVideo(VimeoVideo *video) {
+    foreach (CTVideo *object, CTVideo::instances(video->service(), video->id())) {
+        if (object != video) {
+            if (VimeoVideo *v = qobject_cast<VimeoVideo*>(object)) {
+                v->loadVideo(video);
+            }
+        }
+    }
+}
@@ -118,21 +118,15 @@ Q_SIGNALS:
     void videoUnfavourited(VimeoVideo *video);
     void videoWatchLater(VimeoVideo *video);
 
+private Q_SLOTS:
+    void clearResponseCache();
+    void updatePlaylist(VimeoVideo*, VimeoPlaylist *playlist);
+    void updateUser(VimeoUser *user);
+    void updateVideo(VimeoVideo *video);
+    
 private:
     Vimeo();
     
-    struct SubscriptionCache {
-        QStringList ids;
-        QVariantMap filters;
-        bool hasMore;
-
-        SubscriptionCache() :
-            hasMore(true)
-        {
-        }
-    };
-    
-    static SubscriptionCache subscriptionCache;
     static Vimeo *self;
     
     static const QString CLIENT_ID;
@@ -15,6 +15,7 @@
  */
 
 #include "vimeoaccountmodel.h"
+#include "accountstore.h"
 #include "logger.h"
 #include "vimeo.h"
 #include <QSqlRecord>
@@ -92,6 +93,7 @@ bool VimeoAccountModel::addAccount(const QString &userId, const QString &usernam
     for (int i = 0; i < count; i++) {
         if (data(index(i, 0)) == userId) {
             if (setRecord(i, record)) {
+                AccountStore::invalidate("vimeoAccounts");
                 Vimeo::setUserId(userId);
                 return true;
             }
@@ -101,6 +103,7 @@ bool VimeoAccountModel::addAccount(const QString &userId, const QString &usernam
     }
     
     if (insertRecord(-1, record)) {
+        AccountStore::invalidate("vimeoAccounts");
         Vimeo::setUserId(userId);
         const int count = rowCount();
         emit dataChanged(index(0, 0), index(count - 1, columnCount() - 1));
@@ -117,6 +120,8 @@ bool VimeoAccountModel::removeAccount(int row) {
                 Logger::MediumVerbosity);
     
     if (removeRows(row, 1)) {
+        AccountStore::invalidate("vimeoAccounts");
+        
         if (userId == Vimeo::userId()) {
             if (rowCount() > 0) {
                 selectAccount(0);
@@ -20,7 +20,8 @@
 
 VimeoCommentModel::VimeoCommentModel(QObject *parent) :
     QAbstractListModel(parent),
-    m_request(new QVimeo::ResourcesRequest(this))
+    m_request(new QVimeo::ResourcesRequest(this)),
+    m_prefetchRequest(new QVimeo::ResourcesRequest(this))
 {
     m_roles[BodyRole] = "body";
     m_roles[DateRole] = "date";
@@ -40,13 +41,34 @@ VimeoCommentModel::VimeoCommentModel(QObject *parent) :
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
     connect(Vimeo::instance(), SIGNAL(commentAdded(VimeoComment*)),
             this, SLOT(onCommentAdded(VimeoComment*)));
+    
+    m_prefetchRequest->setClientId(Vimeo::clientId());
+    m_prefetchRequest->setClientSecret(Vimeo::clientSecret());
+    m_prefetchRequest->setAccessToken(Vimeo::accessToken());
+    
+    connect(m_prefetchRequest, SIGNAL(accessTokenChanged(QString)), Vimeo::instance(), SLOT(setAccessToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(finished()), this, SLOT(onPrefetchRequestFinished()));
 }
 
 QString VimeoCommentModel::errorString() const {
     return Vimeo::getErrorString(m_request->result().toMap());
 }
 
+int VimeoCommentModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void VimeoCommentModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
+    }
+}
+
 QVimeo::ResourcesRequest::Status VimeoCommentModel::status() const {
+    if (m_prefetcher.isWanted()) {
+        return QVimeo::ResourcesRequest::Loading;
+    }
+    
     return m_request->status();
 }
 
@@ -69,8 +91,19 @@ void VimeoCommentModel::fetchMore(const QModelIndex &) {
         return;
     }
     
-    const int page = m_filters.value("page").toInt();
-    m_filters["page"] = (page > 0 ? page + 1 : 2);
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if (m_prefetchRequest->status() == QVimeo::ResourcesRequest::Loading) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
+    m_filters["page"] = nextPage();
     m_request->list(m_resourcePath, m_filters);
     emit statusChanged(status());
 }
@@ -140,6 +173,9 @@ void VimeoCommentModel::list(const QString &resourcePath, const QVariantMap &fil
 }
 
 void VimeoCommentModel::clear() {
+    m_prefetcher.clear();
+    m_prefetchRequest->cancel();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -152,6 +188,12 @@ void VimeoCommentModel::clear() {
 
 void VimeoCommentModel::cancel() {
     m_request->cancel();
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        m_prefetchRequest->cancel();
+        emit statusChanged(status());
+    }
 }
 
 void VimeoCommentModel::reload() {
@@ -190,22 +232,52 @@ void VimeoCommentModel::remove(int row) {
     }
 }
 
+int VimeoCommentModel::nextPage() const {
+    const int page = m_filters.value("page").toInt();
+    return page > 0 ? page + 1 : 2;
+}
+
+void VimeoCommentModel::addComments(const QVariantMap &result) {
+    m_hasMore = !result.value("paging").toMap().value("next").isNull();
+    const QVariantList list = result.value("data").toList();
+    
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+    
+    foreach (const QVariant &item, list) {
+        m_items << new VimeoComment(item.toMap(), this);
+    }
+    
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
+void VimeoCommentModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((!m_hasMore) || (status() == QVimeo::ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), nextPage()))) {
+        return;
+    }
+    
+    QVariantMap filters = m_filters;
+    filters["page"] = nextPage();
+    Logger::log("VimeoCommentModel::setVisibleRange(). Prefetching page: " + QString::number(nextPage()),
+                Logger::HighVerbosity);
+    m_prefetchRequest->list(m_resourcePath, filters);
+}
+
+void VimeoCommentModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed
+    m_filters["page"] = m_prefetcher.page();
+    addComments(m_prefetcher.takeResult());
+    emit statusChanged(status());
+}
+
 void VimeoCommentModel::onRequestFinished() {
     if (m_request->status() == QVimeo::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_hasMore = !result.value("paging").toMap().value("next").isNull();
-            const QVariantList list = result.value("data").toList();
-
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-    
-            foreach (const QVariant &item, list) {
-                m_items << new VimeoComment(item.toMap(), this);
-            }
-
-            endInsertRows();
-            emit countChanged(rowCount());
+            addComments(result);
         }
     }
     else {
@@ -215,6 +287,30 @@ void VimeoCommentModel::onRequestFinished() {
     emit statusChanged(status());
 }
 
+void VimeoCommentModel::onPrefetchRequestFinished() {
+    if (m_prefetchRequest->status() == QVimeo::ResourcesRequest::Ready) {
+        const QVariantMap result = m_prefetchRequest->result().toMap();
+        
+        if (!result.isEmpty()) {
+            if (m_prefetcher.setResult(result)) {
+                addPrefetchResult();
+            }
+            
+            return;
+        }
+    }
+    else {
+        Logger::log("VimeoCommentModel::onPrefetchRequestFinished(). Error: "
+                    + Vimeo::getErrorString(m_prefetchRequest->result().toMap()));
+    }
+    
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
+}
+
 void VimeoCommentModel::onCommentAdded(VimeoComment *comment) {
     if (comment->videoId() == m_resourcePath.section('/', 1, 1)) {
         insert(0, new VimeoComment(comment, this));
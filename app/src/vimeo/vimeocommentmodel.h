@@ -17,6 +17,7 @@
 #ifndef VIMEOCOMMENTMODEL_H
 #define VIMEOCOMMENTMODEL_H
 
+#include "pageprefetcher.h"
 #include "vimeocomment.h"
 #include <QAbstractListModel>
 
@@ -27,6 +28,8 @@ class VimeoCommentModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QVimeo::ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
 public:
@@ -44,6 +47,9 @@ public:
     
     QString errorString() const;
     
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
     QVimeo::ResourcesRequest::Status status() const;
     
 #if QT_VERSION >= 0x050000
@@ -69,27 +75,39 @@ public Q_SLOTS:
     void cancel();
     void reload();
     
+    void setVisibleRange(int first, int last);
+    
 private:
     void append(VimeoComment *comment);
     void insert(int row, VimeoComment *comment);
     void remove(int row);
     
+    int nextPage() const;
+    void addComments(const QVariantMap &result);
+    
+    void addPrefetchResult();
+    
 private Q_SLOTS:
     void onRequestFinished();
+    void onPrefetchRequestFinished();
     
     void onCommentAdded(VimeoComment *comment);
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void statusChanged(QVimeo::ResourcesRequest::Status s);
     
 private:
     QVimeo::ResourcesRequest *m_request;
+    QVimeo::ResourcesRequest *m_prefetchRequest;
     
     QString m_resourcePath;
     QVariantMap m_filters;
     bool m_hasMore;
         
+    PagePrefetcher m_prefetcher;
+    
     QList<VimeoComment*> m_items;
     
     QHash<int, QByteArray> m_roles;
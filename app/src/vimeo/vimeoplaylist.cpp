@@ -27,10 +27,6 @@ VimeoPlaylist::VimeoPlaylist(QObject *parent) :
     m_video(0)
 {
     setService(Resources::VIMEO);
-    connect(Vimeo::instance(), SIGNAL(videoAddedToPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
-    connect(Vimeo::instance(), SIGNAL(videoRemovedFromPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
 }
 
 VimeoPlaylist::VimeoPlaylist(const QString &id, QObject *parent) :
@@ -40,10 +36,6 @@ VimeoPlaylist::VimeoPlaylist(const QString &id, QObject *parent) :
 {
     setService(Resources::VIMEO);
     loadPlaylist(id);
-    connect(Vimeo::instance(), SIGNAL(videoAddedToPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
-    connect(Vimeo::instance(), SIGNAL(videoRemovedFromPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
 }
 
 VimeoPlaylist::VimeoPlaylist(const QVariantMap &playlist, QObject *parent) :
@@ -53,10 +45,6 @@ VimeoPlaylist::VimeoPlaylist(const QVariantMap &playlist, QObject *parent) :
 {
     setService(Resources::VIMEO);
     loadPlaylist(playlist);
-    connect(Vimeo::instance(), SIGNAL(videoAddedToPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
-    connect(Vimeo::instance(), SIGNAL(videoRemovedFromPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
 }
 
 VimeoPlaylist::VimeoPlaylist(const VimeoPlaylist *playlist, QObject *parent) :
@@ -66,10 +54,6 @@ VimeoPlaylist::VimeoPlaylist(const VimeoPlaylist *playlist, QObject *parent) :
     m_password(playlist->password()),
     m_privacy(playlist->privacy())
 {
-    connect(Vimeo::instance(), SIGNAL(videoAddedToPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
-    connect(Vimeo::instance(), SIGNAL(videoRemovedFromPlaylist(VimeoVideo*, VimeoPlaylist*)),
-            this, SLOT(onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*)));
 }
 
 QString VimeoPlaylist::errorString() const {
@@ -265,9 +249,3 @@ void VimeoPlaylist::onRemoveVideoRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onRemoveVideoRequestFinished()));
     emit statusChanged(status());
 }
-
-void VimeoPlaylist::onPlaylistUpdated(VimeoVideo*, VimeoPlaylist *playlist) {
-    if ((playlist->id() == id()) && (playlist != this)) {
-        CTPlaylist::loadPlaylist(playlist);
-    }
-}
@@ -64,7 +64,6 @@ private Q_SLOTS:
     void onCreatePlaylistRequestFinished();
     void onAddVideoRequestFinished();
     void onRemoveVideoRequestFinished();
-    void onPlaylistUpdated(VimeoVideo*, VimeoPlaylist*);
     
 Q_SIGNALS:
     void passwordChanged();
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "vimeosubscriptionindex.h"
+#include "resources.h"
+#include "vimeo.h"
+#include <qvimeo/resourcesrequest.h>
+
+VimeoSubscriptionIndex* VimeoSubscriptionIndex::self = 0;
+
+VimeoSubscriptionIndex::VimeoSubscriptionIndex() :
+    SubscriptionIndex(Resources::VIMEO),
+    m_request(0),
+    m_page(1)
+{
+    setUserId(Vimeo::userId());
+}
+
+VimeoSubscriptionIndex::~VimeoSubscriptionIndex() {
+    self = 0;
+}
+
+VimeoSubscriptionIndex* VimeoSubscriptionIndex::instance() {
+    return self ? self : self = new VimeoSubscriptionIndex;
+}
+
+void VimeoSubscriptionIndex::fetchPage(const QVariant &cursor) {
+    if (!m_request) {
+        m_request = new QVimeo::ResourcesRequest(this);
+        connect(m_request, SIGNAL(accessTokenChanged(QString)), Vimeo::instance(), SLOT(setAccessToken(QString)));
+        connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    }
+    
+    // The account may have changed since the last page
+    m_request->setClientId(Vimeo::clientId());
+    m_request->setClientSecret(Vimeo::clientSecret());
+    m_request->setAccessToken(Vimeo::accessToken());
+    m_page = (cursor.isNull() ? 1 : cursor.toInt());
+    
+    QVariantMap filters;
+    filters["per_page"] = 50;
+    filters["page"] = m_page;
+    filters["sort"] = "date";
+    filters["direction"] = "desc";
+    m_request->list("/me/following", filters);
+}
+
+void VimeoSubscriptionIndex::cancelPage() {
+    if (m_request) {
+        m_request->cancel();
+    }
+}
+
+void VimeoSubscriptionIndex::onRequestFinished() {
+    const QVariantMap result = m_request->result().toMap();
+    
+    if (m_request->status() != QVimeo::ResourcesRequest::Ready) {
+        pageFailed(Vimeo::getErrorString(result));
+        return;
+    }
+    
+    QHash<QString, QString> ids;
+    
+    foreach (const QVariant &item, result.value("data").toList()) {
+        ids.insert(item.toMap().value("uri").toString().section('/', -1), QString());
+    }
+    
+    addPage(ids, result.value("paging").toMap().value("next").isNull() ? QVariant() : QVariant(m_page + 1),
+            result.value("total", -1).toInt());
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef VIMEOSUBSCRIPTIONINDEX_H
+#define VIMEOSUBSCRIPTIONINDEX_H
+
+#include "subscriptionindex.h"
+
+namespace QVimeo {
+    class ResourcesRequest;
+}
+
+class VimeoSubscriptionIndex : public SubscriptionIndex
+{
+    Q_OBJECT
+
+public:
+    ~VimeoSubscriptionIndex();
+    
+    static VimeoSubscriptionIndex* instance();
+
+protected:
+    virtual void fetchPage(const QVariant &cursor);
+    virtual void cancelPage();
+
+private Q_SLOTS:
+    void onRequestFinished();
+
+private:
+    VimeoSubscriptionIndex();
+    
+    static VimeoSubscriptionIndex *self;
+    
+    QVimeo::ResourcesRequest *m_request;
+    
+    int m_page;
+};
+
+#endif // VIMEOSUBSCRIPTIONINDEX_H
@@ -18,6 +18,7 @@
 #include "logger.h"
 #include "resources.h"
 #include "vimeo.h"
+#include "vimeosubscriptionindex.h"
 
 VimeoUser::VimeoUser(QObject *parent) :
     CTUser(parent),
@@ -26,10 +27,6 @@ VimeoUser::VimeoUser(QObject *parent) :
     m_subscriberCount(0)
 {
     setService(Resources::VIMEO);
-    connect(Vimeo::instance(), SIGNAL(userSubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
-    connect(Vimeo::instance(), SIGNAL(userUnsubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
 }
 
 VimeoUser::VimeoUser(const QString &id, QObject *parent) :
@@ -40,10 +37,6 @@ VimeoUser::VimeoUser(const QString &id, QObject *parent) :
 {
     setService(Resources::VIMEO);
     loadUser(id);
-    connect(Vimeo::instance(), SIGNAL(userSubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
-    connect(Vimeo::instance(), SIGNAL(userUnsubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
 }
 
 VimeoUser::VimeoUser(const QVariantMap &user, QObject *parent) :
@@ -54,10 +47,6 @@ VimeoUser::VimeoUser(const QVariantMap &user, QObject *parent) :
 {
     setService(Resources::VIMEO);
     loadUser(user);
-    connect(Vimeo::instance(), SIGNAL(userSubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
-    connect(Vimeo::instance(), SIGNAL(userUnsubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
 }
 
 VimeoUser::VimeoUser(const VimeoUser *user, QObject *parent) :
@@ -66,10 +55,6 @@ VimeoUser::VimeoUser(const VimeoUser *user, QObject *parent) :
     m_subscribed(user->isSubscribed()),
     m_subscriberCount(user->subscriberCount())
 {
-    connect(Vimeo::instance(), SIGNAL(userSubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
-    connect(Vimeo::instance(), SIGNAL(userUnsubscribed(VimeoUser*)),
-            this, SLOT(onUserUpdated(VimeoUser*)));
 }
 
 QString VimeoUser::errorString() const {
@@ -130,26 +115,18 @@ void VimeoUser::loadUser(VimeoUser *user) {
 }
 
 void VimeoUser::checkIfSubscribed() {
-    if (Vimeo::subscriptionCache.ids.contains(id())) {
-        setSubscribed(true);
-        return;
-    }
-    
-    if (status() == QVimeo::ResourcesRequest::Loading) {
-        return;
-    }
+    VimeoSubscriptionIndex *index = VimeoSubscriptionIndex::instance();
     
-    if (!Vimeo::subscriptionCache.hasMore) {
-        setSubscribed(false);
+    if ((index->isLoaded()) || (index->contains(id()))) {
+        setSubscribed(index->contains(id()));
         return;
     }
     
-    Logger::log("VimeoUser::checkIfSubscribed(). ID: " + id(), Logger::MediumVerbosity);
-    initRequest();
-    Vimeo::subscriptionCache.filters["per_page"] = 50;
-    m_request->list("/me/following", Vimeo::subscriptionCache.filters);
-    connect(m_request, SIGNAL(finished()), this, SLOT(onSubscribeCheckRequestFinished()));
-    emit statusChanged(status());
+    // The account's subscriptions have not been indexed yet, so the result is set once they are
+    Logger::log("VimeoUser::checkIfSubscribed(). Waiting for subscriptions. ID: " + id(),
+                Logger::MediumVerbosity);
+    connect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()), Qt::UniqueConnection);
+    index->sync();
 }
 
 void VimeoUser::subscribe() {
@@ -196,36 +173,11 @@ void VimeoUser::onUserRequestFinished() {
     emit statusChanged(status());
 }
 
-void VimeoUser::onSubscribeCheckRequestFinished() {
-    if (m_request->status() == QVimeo::ResourcesRequest::Ready) {
-        const QVariantMap result = m_request->result().toMap();
-        const QVariantList list = result.value("data").toList();
-        Vimeo::subscriptionCache.hasMore = !result.value("paging").toMap().value("next").isNull();
-        
-        const int page = Vimeo::subscriptionCache.filters.value("page").toInt();
-        Vimeo::subscriptionCache.filters["page"] = (page > 0 ? page + 1 : 2);
-        
-        foreach (const QVariant &item, list) {
-            const QVariantMap map = item.toMap();
-            Vimeo::subscriptionCache.ids.append(map.value("id").toString());
-        }
-        
-        disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-        emit statusChanged(status());
-        checkIfSubscribed();
-        return;
-    }
-    
-    Logger::log("VimeoUser::onSubscribeCheckFinished(). Error: " + errorString());
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-    emit statusChanged(status());
-}
-
 void VimeoUser::onSubscribeRequestFinished() {
     if (m_request->status() == QVimeo::ResourcesRequest::Ready) {
         setSubscribed(true);
         setSubscriberCount(subscriberCount() + 1);
-        Vimeo::subscriptionCache.ids.append(id());
+        VimeoSubscriptionIndex::instance()->insert(id());
         Logger::log("VimeoUser::onSubscribeRequestFinished(). Subscription added. ID: " + id(),
                     Logger::MediumVerbosity);
         emit Vimeo::instance()->userSubscribed(this);
@@ -242,7 +194,7 @@ void VimeoUser::onUnsubscribeRequestFinished() {
     if (m_request->status() == QVimeo::ResourcesRequest::Ready) {
         setSubscribed(false);
         setSubscriberCount(subscriberCount() - 1);
-        Vimeo::subscriptionCache.ids.removeOne(id());
+        VimeoSubscriptionIndex::instance()->remove(id());
         Logger::log("VimeoUser::onUnsubscribeRequestFinished(). Subscription removed. ID: " + id(),
                     Logger::MediumVerbosity);
         emit Vimeo::instance()->userUnsubscribed(this);
@@ -255,8 +207,12 @@ void VimeoUser::onUnsubscribeRequestFinished() {
     emit statusChanged(status());
 }
 
-void VimeoUser::onUserUpdated(VimeoUser *user) {
-    if ((user->id() == id()) && (user != this)) {
-        loadUser(user);
+void VimeoUser::onSubscriptionsSynced() {
+    VimeoSubscriptionIndex *index = VimeoSubscriptionIndex::instance();
+    disconnect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()));
+    
+    // A failed sync leaves the subscription state as it is
+    if (index->isLoaded()) {
+        setSubscribed(index->contains(id()));
     }
 }
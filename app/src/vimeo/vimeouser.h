@@ -62,10 +62,9 @@ private:
             
 private Q_SLOTS:
     void onUserRequestFinished();
-    void onSubscribeCheckRequestFinished();
     void onSubscribeRequestFinished();
     void onUnsubscribeRequestFinished();
-    void onUserUpdated(VimeoUser *user);
+    void onSubscriptionsSynced();
     
 Q_SIGNALS:
     void statusChanged(QVimeo::ResourcesRequest::Status s);
@@ -21,6 +21,47 @@
 #include "vimeo.h"
 #include <QDateTime>
 
+VimeoVideoData::VimeoVideoData() :
+    CTVideoData(),
+    favourite(false),
+    favouriteCount(0)
+{
+    service = Resources::VIMEO;
+    subtitles = true;
+}
+
+VimeoVideoData::VimeoVideoData(const QVariantMap &video) :
+    CTVideoData(),
+    favourite(false),
+    favouriteCount(0)
+{
+    const QVariantMap user = video.value("user").toMap();
+    const QString thumbnailId = video.value("pictures").toMap().value("uri").toString().section('/', -1);
+    
+    service = Resources::VIMEO;
+    subtitles = true;
+    date = QDateTime::fromString(video.value("created_time").toString(), Qt::ISODate).toString("dd MMM yyyy");
+    description = video.value("description").toString();
+    duration = Utils::formatSecs(video.value("duration").toLongLong());
+    favouriteCount = video.value("metadata").toMap().value("connections").toMap().value("likes").toMap()
+                     .value("count").toLongLong();
+    id = video.value("uri").toString().section('/', -1);
+    largeThumbnailUrl = QString("https://i.vimeocdn.com/video/%1_640x360.jpg").arg(thumbnailId);
+    url = "https://vimeo.com/" + id;
+    userId = user.value("uri").toString().section('/', -1);
+    username = user.value("name").toString();
+    thumbnailUrl = QString("https://i.vimeocdn.com/video/%1_100x75.jpg").arg(thumbnailId);
+    title = video.value("name").toString();
+    viewCount = video.value("stats").toMap().value("plays").toLongLong();
+}
+
+VimeoVideoData::VimeoVideoData(const VimeoVideo *video) :
+    CTVideoData(video),
+    favourite(video->isFavourite()),
+    favouriteCount(video->favouriteCount())
+{
+}
+
 VimeoVideo::VimeoVideo(QObject *parent) :
     CTVideo(parent),
     m_request(0),
@@ -28,10 +69,6 @@ VimeoVideo::VimeoVideo(QObject *parent) :
 {
     setHasSubtitles(true);
     setService(Resources::VIMEO);
-    connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
-    connect(Vimeo::instance(), SIGNAL(videoUnfavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
 }
 
 VimeoVideo::VimeoVideo(const QString &id, QObject *parent) :
@@ -42,10 +79,6 @@ VimeoVideo::VimeoVideo(const QString &id, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::VIMEO);
     loadVideo(id);
-    connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
-    connect(Vimeo::instance(), SIGNAL(videoUnfavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
 }
 
 VimeoVideo::VimeoVideo(const QVariantMap &video, QObject *parent) :
@@ -56,10 +89,6 @@ VimeoVideo::VimeoVideo(const QVariantMap &video, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::VIMEO);
     loadVideo(video);
-    connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
-    connect(Vimeo::instance(), SIGNAL(videoUnfavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
 }
 
 VimeoVideo::VimeoVideo(const VimeoVideo *video, QObject *parent) :
@@ -67,10 +96,14 @@ VimeoVideo::VimeoVideo(const VimeoVideo *video, QObject *parent) :
     m_request(0),
     m_favourite(video->isFavourite())
 {
-    connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
-    connect(Vimeo::instance(), SIGNAL(videoUnfavourited(VimeoVideo*)),
-            this, SLOT(onVideoUpdated(VimeoVideo*)));
+}
+
+VimeoVideo::VimeoVideo(const VimeoVideoData &video, QObject *parent) :
+    CTVideo(video, parent),
+    m_request(0),
+    m_favourite(video.favourite),
+    m_favouriteCount(video.favouriteCount)
+{
 }
 
 QString VimeoVideo::errorString() const {
@@ -115,22 +148,9 @@ void VimeoVideo::loadVideo(const QString &id) {
 }
 
 void VimeoVideo::loadVideo(const QVariantMap &video) {
-    const QVariantMap user = video.value("user").toMap();
-    const QString thumbnailId = video.value("pictures").toMap().value("uri").toString().section('/', -1);
-    
-    setDate(QDateTime::fromString(video.value("created_time").toString(), Qt::ISODate).toString("dd MMM yyyy"));
-    setDescription(video.value("description").toString());
-    setDuration(Utils::formatSecs(video.value("duration").toLongLong()));
-    setFavouriteCount(video.value("metadata").toMap().value("connections").toMap().value("likes").toMap()
-                      .value("count").toLongLong());
-    setId(video.value("uri").toString().section('/', -1));
-    setLargeThumbnailUrl(QString("https://i.vimeocdn.com/video/%1_640x360.jpg").arg(thumbnailId));
-    setUrl("https://vimeo.com/" + id());
-    setUserId(user.value("uri").toString().section('/', -1));
-    setUsername(user.value("name").toString());
-    setThumbnailUrl(QString("https://i.vimeocdn.com/video/%1_100x75.jpg").arg(thumbnailId));
-    setTitle(video.value("name").toString());
-    setViewCount(video.value("stats").toMap().value("plays").toLongLong());
+    const VimeoVideoData data(video);
+    CTVideo::loadData(data);
+    setFavouriteCount(data.favouriteCount);
 }
 
 void VimeoVideo::loadVideo(VimeoVideo *video) {
@@ -238,9 +258,3 @@ void VimeoVideo::onWatchLaterRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onWatchLaterRequestFinished()));
     emit statusChanged(status());
 }
-
-void VimeoVideo::onVideoUpdated(VimeoVideo *video) {
-    if ((video->id() == id()) && (video != this)) {
-        loadVideo(video);
-    }
-}
@@ -20,6 +20,19 @@
 #include "video.h"
 #include <qvimeo/resourcesrequest.h>
 
+class VimeoVideo;
+
+class VimeoVideoData : public CTVideoData
+{
+public:
+    VimeoVideoData();
+    explicit VimeoVideoData(const QVariantMap &video);
+    explicit VimeoVideoData(const VimeoVideo *video);
+    
+    bool favourite;
+    qint64 favouriteCount;
+};
+
 class VimeoVideo : public CTVideo
 {
     Q_OBJECT
@@ -34,6 +47,7 @@ public:
     explicit VimeoVideo(const QString &id, QObject *parent = 0);
     explicit VimeoVideo(const QVariantMap &video, QObject *parent = 0);
     explicit VimeoVideo(const VimeoVideo *video, QObject *parent = 0);
+    explicit VimeoVideo(const VimeoVideoData &video, QObject *parent = 0);
     
     QString errorString() const;
     
@@ -63,7 +77,6 @@ private Q_SLOTS:
     void onFavouriteRequestFinished();
     void onUnfavouriteRequestFinished();
     void onWatchLaterRequestFinished();
-    void onVideoUpdated(VimeoVideo *video);
     
 Q_SIGNALS:
     void favouriteChanged();
@@ -16,12 +16,17 @@
 
 #include "vimeovideomodel.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
 #include "vimeo.h"
 #include "vimeoplaylist.h"
 
 VimeoVideoModel::VimeoVideoModel(QObject *parent) :
     QAbstractListModel(parent),
-    m_request(new QVimeo::ResourcesRequest(this))
+    m_request(new QVimeo::ResourcesRequest(this)),
+    m_hasMore(false),
+    m_cached(false),
+    m_revalidating(false)
 {
     m_roles[DateRole] = "date";
     m_roles[DescriptionRole] = "description";
@@ -54,7 +59,7 @@ QString VimeoVideoModel::errorString() const {
 }
 
 QVimeo::ResourcesRequest::Status VimeoVideoModel::status() const {
-    return m_request->status();
+    return m_cached ? QVimeo::ResourcesRequest::Ready : m_request->status();
 }
 
 #if QT_VERSION >=0x050000
@@ -78,13 +83,59 @@ void VimeoVideoModel::fetchMore(const QModelIndex &) {
     
     const int page = m_filters.value("page").toInt();
     m_filters["page"] = (page > 0 ? page + 1 : 2);
-    m_request->list(m_resourcePath, m_filters);
+    const QVariantMap result = ResponseCache::result(cacheKey()).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos();
+    }
+    else {
+        m_cached = true;
+        addVideos(result);
+    }
+    
     emit statusChanged(status());
 }
 
+QVariant VimeoVideoModel::roleData(const VimeoVideoData *video, int role) {
+    switch (role) {
+    case DateRole:
+        return video->date;
+    case DescriptionRole:
+        return video->description;
+    case DownloadableRole:
+        return video->downloadable;
+    case DurationRole:
+        return video->duration;
+    case FavouriteRole:
+        return video->favourite;
+    case IdRole:
+        return video->id;
+    case LargeThumbnailUrlRole:
+        return video->largeThumbnailUrl;
+    case StreamUrlRole:
+        return video->streamUrl;
+    case SubtitlesRole:
+        return video->subtitles;
+    case ThumbnailUrlRole:
+        return video->thumbnailUrl;
+    case TitleRole:
+        return video->title;
+    case UrlRole:
+        return video->url;
+    case UserIdRole:
+        return video->userId;
+    case UsernameRole:
+        return video->username;
+    case ViewCountRole:
+        return video->viewCount;
+    default:
+        return QVariant();
+    }
+}
+
 QVariant VimeoVideoModel::data(const QModelIndex &index, int role) const {
-    if (const VimeoVideo *video = get(index.row())) {
-        return video->property(m_roles[role]);
+    if (const VimeoVideoData *video = videoData(index.row())) {
+        return roleData(video, role);
     }
     
     return QVariant();
@@ -93,12 +144,12 @@ QVariant VimeoVideoModel::data(const QModelIndex &index, int role) const {
 QMap<int, QVariant> VimeoVideoModel::itemData(const QModelIndex &index) const {
     QMap<int, QVariant> map;
     
-    if (const VimeoVideo *video = get(index.row())) {
+    if (const VimeoVideoData *video = videoData(index.row())) {
         QHashIterator<int, QByteArray> iterator(m_roles);
         
         while (iterator.hasNext()) {
             iterator.next();
-            map[iterator.key()] = video->property(iterator.value());
+            map[iterator.key()] = roleData(video, iterator.key());
         }
     }
     
@@ -106,8 +157,8 @@ QMap<int, QVariant> VimeoVideoModel::itemData(const QModelIndex &index) const {
 }
 
 QVariant VimeoVideoModel::data(int row, const QByteArray &role) const {
-    if (const VimeoVideo *video = get(row)) {
-        return video->property(role);
+    if (const VimeoVideoData *video = videoData(row)) {
+        return roleData(video, m_roles.key(role));
     }
     
     return QVariant();
@@ -116,9 +167,12 @@ QVariant VimeoVideoModel::data(int row, const QByteArray &role) const {
 QVariantMap VimeoVideoModel::itemData(int row) const {
     QVariantMap map;
     
-    if (const VimeoVideo *video = get(row)) {
-        foreach (const QByteArray &role, m_roles.values()) {
-            map[role] = video->property(role);
+    if (const VimeoVideoData *video = videoData(row)) {
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.value()] = roleData(video, iterator.key());
         }
     }
     
@@ -127,7 +181,22 @@ QVariantMap VimeoVideoModel::itemData(int row) const {
 
 VimeoVideo* VimeoVideoModel::get(int row) const {
     if ((row >= 0) && (row < m_items.size())) {
-        return m_items.at(row);
+        // Rows are stored as values, so the QObject is only created when a page or QML asks for it
+        if (!m_videos.at(row)) {
+            m_videos[row] = new VimeoVideo(*m_items.at(row), const_cast<VimeoVideoModel*>(this));
+            // Keep the row in step with any change to the object, such as a reload of its details
+            m_videos.at(row)->connectChangeSignals(const_cast<VimeoVideoModel*>(this), SLOT(onVideoChanged()));
+        }
+        
+        return m_videos.at(row);
+    }
+    
+    return 0;
+}
+
+const VimeoVideoData* VimeoVideoModel::videoData(int row) const {
+    if ((row >= 0) && (row < m_items.size())) {
+        return m_items.at(row).constData();
     }
     
     return 0;
@@ -142,10 +211,30 @@ void VimeoVideoModel::list(const QString &resourcePath, const QVariantMap &filte
     clear();
     m_resourcePath = resourcePath;
     m_filters = filters;
-    m_request->list(resourcePath, filters);
+    bool stale = false;
+    const QVariantMap result = ResponseCache::result(cacheKey(), &stale).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos();
+    }
+    else {
+        // Show the cached videos immediately, and replace them if they need to be revalidated
+        addVideos(result);
+        
+        if (stale) {
+            m_revalidating = true;
+            getVideos();
+        }
+        else {
+            m_cached = true;
+        }
+    }
+    
     emit statusChanged(status());
     
     disconnect(Vimeo::instance(), 0, this, 0);
+    connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)), this, SLOT(onVideoUpdated(VimeoVideo*)));
+    connect(Vimeo::instance(), SIGNAL(videoUnfavourited(VimeoVideo*)), this, SLOT(onVideoUpdated(VimeoVideo*)));
         
     if (resourcePath == "/me/likes") {
         connect(Vimeo::instance(), SIGNAL(videoFavourited(VimeoVideo*)),
@@ -168,8 +257,9 @@ void VimeoVideoModel::list(const QString &resourcePath, const QVariantMap &filte
 void VimeoVideoModel::clear() {
     if (!m_items.isEmpty()) {
         beginResetModel();
-        qDeleteAll(m_items);
+        qDeleteAll(m_videos);
         m_items.clear();
+        m_videos.clear();
         m_hasMore = false;
         endResetModel();
         emit countChanged(rowCount());
@@ -187,20 +277,31 @@ void VimeoVideoModel::reload() {
     
     Logger::log("VimeoVideoModel::reload(). Resource path: " + m_resourcePath, Logger::HighVerbosity);
     clear();
-    m_request->list(m_resourcePath, m_filters);
+    getVideos();
     emit statusChanged(status());
 }
 
-void VimeoVideoModel::append(VimeoVideo *video) {
+QString VimeoVideoModel::cacheKey() const {
+    return ResponseCache::key(Resources::VIMEO, m_resourcePath, m_filters);
+}
+
+void VimeoVideoModel::getVideos() {
+    m_cached = false;
+    m_request->list(m_resourcePath, m_filters);
+}
+
+void VimeoVideoModel::append(VimeoVideoData *video) {
     beginInsertRows(QModelIndex(), m_items.size(), m_items.size());
-    m_items << video;
+    m_items << QSharedDataPointer<VimeoVideoData>(video);
+    m_videos << 0;
     endInsertRows();
 }
 
-void VimeoVideoModel::insert(int row, VimeoVideo *video) {
+void VimeoVideoModel::insert(int row, VimeoVideoData *video) {
     if ((row >= 0) && (row < m_items.size())) {
         beginInsertRows(QModelIndex(), row, row);
-        m_items.insert(row, video);
+        m_items.insert(row, QSharedDataPointer<VimeoVideoData>(video));
+        m_videos.insert(row, 0);
         endInsertRows();
     }
     else {
@@ -211,46 +312,65 @@ void VimeoVideoModel::insert(int row, VimeoVideo *video) {
 void VimeoVideoModel::remove(int row) {
     if ((row >= 0) && (row < m_items.size())) {
         beginRemoveRows(QModelIndex(), row, row);
-        m_items.takeAt(row)->deleteLater();
+        m_items.removeAt(row);
+        
+        if (VimeoVideo *video = m_videos.takeAt(row)) {
+            video->deleteLater();
+        }
+        
         endRemoveRows();
     }
 }
 
+void VimeoVideoModel::addVideos(const QVariantMap &result) {
+    m_hasMore = !result.value("paging").toMap().value("next").isNull();
+    const QVariantList list = result.value("data").toList();
+
+    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+
+    if (m_resourcePath.endsWith("/feed")) {
+        foreach (const QVariant &item, list) {
+            m_items << QSharedDataPointer<VimeoVideoData>(new VimeoVideoData(item.toMap().value("clip").toMap()));
+            m_videos << 0;
+        }
+    }
+    else {
+        foreach (const QVariant &item, list) {
+            m_items << QSharedDataPointer<VimeoVideoData>(new VimeoVideoData(item.toMap()));
+            m_videos << 0;
+        }
+    }
+
+    endInsertRows();
+    emit countChanged(rowCount());
+}
+
 void VimeoVideoModel::onRequestFinished() {
     if (m_request->status() == QVimeo::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_hasMore = !result.value("paging").toMap().value("next").isNull();
-            const QVariantList list = result.value("data").toList();
-
-            beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-    
-            if (m_resourcePath.endsWith("/feed")) {
-                foreach (const QVariant &item, list) {
-                    m_items << new VimeoVideo(item.toMap().value("clip").toMap(), this);
-                }
-            }
-            else {
-                foreach (const QVariant &item, list) {
-                    m_items << new VimeoVideo(item.toMap(), this);
-                }
+            ResponseCache::insert(cacheKey(), Resources::VIMEO, ResponseCache::resourceType(m_resourcePath),
+                                  result);
+            
+            if (m_revalidating) {
+                clear();
             }
-
-            endInsertRows();
-            emit countChanged(rowCount());
+            
+            addVideos(result);
         }
     }
     else {
         Logger::log("VimeoVideoModel::onRequestFinished(). Error: " + errorString());
     }
     
+    m_revalidating = false;
     emit statusChanged(status());
 }
 
 void VimeoVideoModel::onVideoAddedToPlaylist(VimeoVideo *video, VimeoPlaylist *playlist) {
     if (m_resourcePath.section('/', -2, -2) == playlist->id()) {
-        insert(0, new VimeoVideo(video, this));
+        insert(0, new VimeoVideoData(video));
     }
 }
 
@@ -265,7 +385,7 @@ void VimeoVideoModel::onVideoRemovedFromPlaylist(VimeoVideo *video, VimeoPlaylis
 }
 
 void VimeoVideoModel::onVideoFavourited(VimeoVideo *video) {
-    insert(0, new VimeoVideo(video, this));
+    insert(0, new VimeoVideoData(video));
 }
 
 void VimeoVideoModel::onVideoUnfavourited(VimeoVideo *video) {
@@ -277,5 +397,25 @@ void VimeoVideoModel::onVideoUnfavourited(VimeoVideo *video) {
 }
 
 void VimeoVideoModel::onVideoWatchLater(VimeoVideo *video) {
-    insert(0, new VimeoVideo(video, this));
+    insert(0, new VimeoVideoData(video));
+}
+
+void VimeoVideoModel::onVideoUpdated(VimeoVideo *video) {
+    for (int i = 0; i < m_items.size(); i++) {
+        if (m_items.at(i)->id == video->id()) {
+            m_items[i] = QSharedDataPointer<VimeoVideoData>(new VimeoVideoData(video));
+            const QModelIndex idx = index(i);
+            emit dataChanged(idx, idx);
+        }
+    }
+}
+
+void VimeoVideoModel::onVideoChanged() {
+    const int i = m_videos.indexOf(qobject_cast<VimeoVideo*>(sender()));
+    
+    if (i >= 0) {
+        m_items[i] = QSharedDataPointer<VimeoVideoData>(new VimeoVideoData(m_videos.at(i)));
+        const QModelIndex idx = index(i);
+        emit dataChanged(idx, idx);
+    }
 }
@@ -80,8 +80,17 @@ public Q_SLOTS:
     void reload();
     
 private:
-    void append(VimeoVideo *video);
-    void insert(int row, VimeoVideo *video);
+    static QVariant roleData(const VimeoVideoData *video, int role);
+    
+    const VimeoVideoData* videoData(int row) const;
+    
+    QString cacheKey() const;
+    
+    void getVideos();
+    void addVideos(const QVariantMap &result);
+    
+    void append(VimeoVideoData *video);
+    void insert(int row, VimeoVideoData *video);
     void remove(int row);
     
 private Q_SLOTS:
@@ -91,6 +100,8 @@ private Q_SLOTS:
     void onVideoFavourited(VimeoVideo *video);
     void onVideoUnfavourited(VimeoVideo *video);
     void onVideoWatchLater(VimeoVideo *video);
+    void onVideoUpdated(VimeoVideo *video);
+    void onVideoChanged();
     
 Q_SIGNALS:
     void countChanged(int count);
@@ -102,8 +113,12 @@ private:
     QString m_resourcePath;
     QVariantMap m_filters;
     bool m_hasMore;
+    
+    bool m_cached;
+    bool m_revalidating;
         
-    QList<VimeoVideo*> m_items;
+    QList< QSharedDataPointer<VimeoVideoData> > m_items;
+    mutable QList<VimeoVideo*> m_videos;
     
     QHash<int, QByteArray> m_roles;
 };
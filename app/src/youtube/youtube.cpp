@@ -15,12 +15,17 @@
  */
 
 #include "youtube.h"
-#include "database.h"
+#include "accountstore.h"
 #include "json.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
+#include "youtubeplaylist.h"
+#include "youtubesubscriptionindex.h"
+#include "youtubeuser.h"
+#include "youtubevideo.h"
 #include <qyoutube/urls.h>
 #include <QSettings>
-#include <QSqlRecord>
 #if QT_VERSION >= 0x050000
 #include <QUrlQuery>
 #endif
@@ -34,13 +39,33 @@ const QRegExp YouTube::DURATION_REGEXP("T((\\d+)H|)((\\d+)M|)((\\d+)S|)");
 const QRegExp YouTube::URL_REGEXP("(http(s|)://(www.|m.|)youtube.com/(v/|.+)(v=|list=|)|http://youtu.be/)",
                                   Qt::CaseInsensitive);
 
-YouTube::SubscriptionCache YouTube::subscriptionCache;
-
 YouTube* YouTube::self = 0;
 
 YouTube::YouTube() :
     QObject()
 {
+    // Cached responses may be out of date once the user changes account or modifies their content
+    connect(this, SIGNAL(userIdChanged(QString)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistCreated(YouTubePlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(playlistDeleted(YouTubePlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userSubscribed(YouTubeUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(userUnsubscribed(YouTubeUser*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoAddedToPlaylist(YouTubeVideo*,YouTubePlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*,YouTubePlaylist*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoDisliked(YouTubeVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoLiked(YouTubeVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoFavourited(YouTubeVideo*)), this, SLOT(clearResponseCache()));
+    connect(this, SIGNAL(videoUnfavourited(YouTubeVideo*)), this, SLOT(clearResponseCache()));
+
+    // Changes are delivered only to the objects that represent the modified resource
+    connect(this, SIGNAL(userSubscribed(YouTubeUser*)), this, SLOT(updateUser(YouTubeUser*)));
+    connect(this, SIGNAL(userUnsubscribed(YouTubeUser*)), this, SLOT(updateUser(YouTubeUser*)));
+    connect(this, SIGNAL(videoAddedToPlaylist(YouTubeVideo*,YouTubePlaylist*)), this, SLOT(updatePlaylist(YouTubeVideo*,YouTubePlaylist*)));
+    connect(this, SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*,YouTubePlaylist*)), this, SLOT(updatePlaylist(YouTubeVideo*,YouTubePlaylist*)));
+    connect(this, SIGNAL(videoDisliked(YouTubeVideo*)), this, SLOT(updateVideo(YouTubeVideo*)));
+    connect(this, SIGNAL(videoLiked(YouTubeVideo*)), this, SLOT(updateVideo(YouTubeVideo*)));
+    connect(this, SIGNAL(videoFavourited(YouTubeVideo*)), this, SLOT(updateVideo(YouTubeVideo*)));
+    connect(this, SIGNAL(videoUnfavourited(YouTubeVideo*)), this, SLOT(updateVideo(YouTubeVideo*)));
 }
 
 YouTube::~YouTube() {
@@ -55,6 +80,9 @@ void YouTube::init() {
     if (accessToken().isEmpty()) {
         setUserId(QString());
     }
+    
+    // The stored subscriptions are read now, so that they are known before any user is shown
+    YouTubeSubscriptionIndex::instance()->setUserId(userId());
 }
 
 QString YouTube::formatDuration(const QString &duration) {
@@ -199,9 +227,7 @@ void YouTube::setUserId(const QString &id) {
     
     if (id != userId()) {
         QSettings().setValue("YouTube/userId", id);
-        subscriptionCache.ids.clear();
-        subscriptionCache.nextPageToken = QString();
-        subscriptionCache.loaded = false;
+        YouTubeSubscriptionIndex::instance()->setUserId(id);
 
         if (self) {
             emit self->userIdChanged(id);
@@ -210,99 +236,36 @@ void YouTube::setUserId(const QString &id) {
 }
 
 QString YouTube::accessToken() {
-    if (userId().isEmpty()) {
-        return QString();
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT accessToken FROM youtubeAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::accessToken(): database error: " + query.lastError().text());
-        return QString();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString();
-    }
-    
-    return QString();
+    return AccountStore::value("youtubeAccounts", userId(), "accessToken").toString();
 }
 
 void YouTube::setAccessToken(const QString &token) {
     Logger::log("YouTube::setAccessToken(). Token: " + token, Logger::MediumVerbosity);
-    QSqlQuery query = getDatabase().exec(QString("UPDATE youtubeAccounts SET accessToken = '%1' WHERE userId = '%2'")
-                                                .arg(token).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::setAccessToken(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    
+    if ((AccountStore::setValue("youtubeAccounts", userId(), "accessToken", token)) && (self)) {
         emit self->accessTokenChanged(token);
     }
 }
 
 QString YouTube::refreshToken() {
-    if (userId().isEmpty()) {
-        return QString();
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT refreshToken FROM youtubeAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::refreshToken(): database error: " + query.lastError().text());
-        return QString();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString();
-    }
-    
-    return QString();
+    return AccountStore::value("youtubeAccounts", userId(), "refreshToken").toString();
 }
 
 void YouTube::setRefreshToken(const QString &token) {
     Logger::log("YouTube::setRefreshToken(). Token: " + token, Logger::MediumVerbosity);
-    QSqlQuery query = getDatabase().exec(QString("UPDATE youtubeAccounts SET refreshToken = '%1' WHERE userId = '%2'")
-                                                .arg(token).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::setRefreshToken(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    
+    if ((AccountStore::setValue("youtubeAccounts", userId(), "refreshToken", token)) && (self)) {
         emit self->refreshTokenChanged(token);
     }
 }
 
 QVariantMap YouTube::relatedPlaylists() {
-    if (userId().isEmpty()) {
-        return QVariantMap();
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT relatedPlaylists FROM youtubeAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::refreshToken(): database error: " + query.lastError().text());
-        return QVariantMap();
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return QtJson::Json::parse(query.value(0).toString()).toMap();
-    }
-    
-    return QVariantMap();
+    return AccountStore::jsonValue("youtubeAccounts", userId(), "relatedPlaylists").toMap();
 }
 
 void YouTube::setRelatedPlaylists(const QVariantMap &playlists) {
-    QSqlQuery query = getDatabase().exec(QString("UPDATE youtubeAccounts SET relatedPlaylists = '%1' WHERE userId = '%2'")
-                                                .arg(QString(QtJson::Json::serialize(playlists))).arg(userId()));
-
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::setRelatedPlaylists(): database error: " + query.lastError().text());
-    }
-    else if (self) {
+    if ((AccountStore::setValue("youtubeAccounts", userId(), "relatedPlaylists",
+                                QString(QtJson::Json::serialize(playlists)))) && (self)) {
         emit self->relatedPlaylistsChanged(playlists);
     }
 }
@@ -372,23 +335,7 @@ void YouTube::setScopes(const QStringList &s) {
 }
 
 bool YouTube::hasScope(const QString &scope) {
-    if (userId().isEmpty()) {
-        return false;
-    }
-    
-    QSqlQuery query = getDatabase().exec(QString("SELECT scopes FROM youtubeAccounts WHERE userId = '%1'")
-                                                .arg(userId()));
-    
-    if (query.lastError().isValid()) {
-        Logger::log("YouTube::hasScope(): database error: " + query.lastError().text());
-        return false;
-    }
-    
-    if ((query.record().count() > 0) && (query.next())) {
-         return query.value(0).toString().contains(scope);
-    }
-    
-    return false;
+    return AccountStore::value("youtubeAccounts", userId(), "scopes").toString().contains(scope);
 }
 
 QString YouTube::auditScope() {
@@ -414,3 +361,37 @@ QString YouTube::readWriteScope() {
 QString YouTube::uploadScope() {
     return QYouTube::UPLOAD_SCOPE;
 }
+
+void YouTube::clearResponseCache() {
+    ResponseCache::invalidate(Resources::YOUTUBE);
+}
+
+void YouTube::updatePlaylist(YouTubeVideo*, YouTubePlaylist *playlist) {
+    foreach (CTPlaylist *object, CTPlaylist::instances(playlist->service(), playlist->id())) {
+        if (object != playlist) {
+            if (YouTubePlaylist *p = qobject_cast<YouTubePlaylist*>(object)) {
+                p->loadPlaylist(playlist);
+            }
+        }
+    }
+}
+
+void YouTube::updateUser(YouTubeUser *user) {
+    foreach (CTUser *object, CTUser::instances(user->service(), user->id())) {
+        if (object != user) {
+            if (YouTubeUser *u = qobject_cast<YouTubeUser*>(object)) {
+                u->loadUser(user);
+            }
+        }
+    }
+}
+
+void YouTube::updateVideo(YouTubeVideo *video) {
+    foreach (CTVideo *object, CTVideo::instances(video->service(), video->id())) {
+        if (object != video) {
+            if (YouTubeVideo *v = qobject_cast<YouTubeVideo*>(object)) {
+                v->loadVideo(video);
+            }
+        }
+    }
+}
@@ -136,21 +136,15 @@ Q_SIGNALS:
     void videoFavourited(YouTubeVideo *video);
     void videoUnfavourited(YouTubeVideo *video);
 
+private Q_SLOTS:
+    void clearResponseCache();
+    void updatePlaylist(YouTubeVideo*, YouTubePlaylist *playlist);
+    void updateUser(YouTubeUser *user);
+    void updateVideo(YouTubeVideo *video);
+    
 private:
     YouTube();
     
-    struct SubscriptionCache {
-        QHash<QString, QString> ids;
-        QString nextPageToken;
-        bool loaded;
-
-        SubscriptionCache() :
-            loaded(false)
-        {
-        }
-    };
-    
-    static SubscriptionCache subscriptionCache;
     static YouTube *self;
     
     static const QString API_KEY;
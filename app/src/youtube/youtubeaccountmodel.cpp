@@ -15,6 +15,7 @@
  */
 
 #include "youtubeaccountmodel.h"
+#include "accountstore.h"
 #include "logger.h"
 #include "json.h"
 #include "youtube.h"
@@ -103,6 +104,7 @@ bool YouTubeAccountModel::addAccount(const QString &userId, const QString &usern
     for (int i = 0; i < count; i++) {
         if (data(index(i, 0)) == userId) {
             if (setRecord(i, record)) {
+                AccountStore::invalidate("youtubeAccounts");
                 YouTube::setUserId(userId);
                 return true;
             }
@@ -112,6 +114,7 @@ bool YouTubeAccountModel::addAccount(const QString &userId, const QString &usern
     }
     
     if (insertRecord(-1, record)) {
+        AccountStore::invalidate("youtubeAccounts");
         YouTube::setUserId(userId);
         const int count = rowCount();
         emit dataChanged(index(0, 0), index(count - 1, columnCount() - 1));
@@ -128,6 +131,8 @@ bool YouTubeAccountModel::removeAccount(int row) {
                 Logger::MediumVerbosity);
     
     if (removeRows(row, 1)) {
+        AccountStore::invalidate("youtubeAccounts");
+        
         if (userId == YouTube::userId()) {
             if (rowCount() > 0) {
                 selectAccount(0);
@@ -20,7 +20,8 @@
 
 YouTubeCommentModel::YouTubeCommentModel(QObject *parent) :
     QAbstractListModel(parent),
-    m_request(new QYouTube::ResourcesRequest(this))
+    m_request(new QYouTube::ResourcesRequest(this)),
+    m_prefetchRequest(new QYouTube::ResourcesRequest(this))
 {
     m_roles[BodyRole] = "body";
     m_roles[DateRole] = "date";
@@ -44,13 +45,37 @@ YouTubeCommentModel::YouTubeCommentModel(QObject *parent) :
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
     connect(YouTube::instance(), SIGNAL(commentAdded(YouTubeComment*)),
             this, SLOT(onCommentAdded(YouTubeComment*)));
+    
+    m_prefetchRequest->setApiKey(YouTube::apiKey());
+    m_prefetchRequest->setClientId(YouTube::clientId());
+    m_prefetchRequest->setClientSecret(YouTube::clientSecret());
+    m_prefetchRequest->setAccessToken(YouTube::accessToken());
+    m_prefetchRequest->setRefreshToken(YouTube::refreshToken());
+    
+    connect(m_prefetchRequest, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(finished()), this, SLOT(onPrefetchRequestFinished()));
 }
 
 QString YouTubeCommentModel::errorString() const {
     return YouTube::getErrorString(m_request->result().toMap());
 }
 
+int YouTubeCommentModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void YouTubeCommentModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
+    }
+}
+
 QYouTube::ResourcesRequest::Status YouTubeCommentModel::status() const {
+    if (m_prefetcher.isWanted()) {
+        return QYouTube::ResourcesRequest::Loading;
+    }
+    
     return m_request->status();
 }
 
@@ -73,6 +98,18 @@ void YouTubeCommentModel::fetchMore(const QModelIndex &) {
         return;
     }
     
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if (m_prefetchRequest->status() == QYouTube::ResourcesRequest::Loading) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
     QVariantMap params = m_params;
     params["pageToken"] = m_nextPageToken;
     
@@ -148,6 +185,9 @@ void YouTubeCommentModel::list(const QString &resourcePath, const QStringList &p
 }
 
 void YouTubeCommentModel::clear() {
+    m_prefetcher.clear();
+    m_prefetchRequest->cancel();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -160,6 +200,12 @@ void YouTubeCommentModel::clear() {
 
 void YouTubeCommentModel::cancel() {
     m_request->cancel();
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        m_prefetchRequest->cancel();
+        emit statusChanged(status());
+    }
 }
 
 void YouTubeCommentModel::reload() {
@@ -198,35 +244,59 @@ void YouTubeCommentModel::remove(int row) {
     }
 }
 
+void YouTubeCommentModel::addComments(const QVariantMap &result) {
+    m_nextPageToken = result.value("nextPageToken").toString();
+    const QVariantList list = result.value("items").toList();
+    
+    if (result.value("kind") == "youtube#commentThreadListResponse") {
+        foreach (QVariant item, list) {
+            const QVariantMap thread = item.toMap();
+            append(new YouTubeComment(thread.value("snippet").toMap().value("topLevelComment").toMap(), this));
+            
+            foreach (const QVariant &reply, thread.value("replies").toList()) {
+                append(new YouTubeComment(reply.toMap(), this));
+            }
+        }
+    }
+    else {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
+        
+        foreach (const QVariant &item, list) {
+            m_items << new YouTubeComment(item.toMap(), this);
+        }
+        
+        endInsertRows();
+    }
+    
+    emit countChanged(rowCount());
+}
+
+void YouTubeCommentModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((m_nextPageToken.isEmpty()) || (status() == QYouTube::ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), m_nextPageToken))) {
+        return;
+    }
+    
+    QVariantMap params = m_params;
+    params["pageToken"] = m_nextPageToken;
+    Logger::log("YouTubeCommentModel::setVisibleRange(). Prefetching page token: " + m_nextPageToken,
+                Logger::HighVerbosity);
+    m_prefetchRequest->list(m_resourcePath, m_part, m_filters, params);
+}
+
+void YouTubeCommentModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed
+    addComments(m_prefetcher.takeResult());
+    emit statusChanged(status());
+}
+
 void YouTubeCommentModel::onRequestFinished() {
     if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
-            m_nextPageToken = result.value("nextPageToken").toString();
-            const QVariantList list = result.value("items").toList();
-    
-            if (result.value("kind") == "youtube#commentThreadListResponse") {
-                foreach (QVariant item, list) {
-                    const QVariantMap thread = item.toMap();
-                    append(new YouTubeComment(thread.value("snippet").toMap().value("topLevelComment").toMap(), this));
-                    
-                    foreach (const QVariant &reply, thread.value("replies").toList()) {
-                        append(new YouTubeComment(reply.toMap(), this));
-                    }
-                }
-            }
-            else {
-                beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                
-                foreach (const QVariant &item, list) {
-                    m_items << new YouTubeComment(item.toMap(), this);
-                }
-                
-                endInsertRows();
-            }
-            
-            emit countChanged(rowCount());      
+            addComments(result);
         }
     }
     else {
@@ -236,6 +306,30 @@ void YouTubeCommentModel::onRequestFinished() {
     emit statusChanged(status());
 }
 
+void YouTubeCommentModel::onPrefetchRequestFinished() {
+    if (m_prefetchRequest->status() == QYouTube::ResourcesRequest::Ready) {
+        const QVariantMap result = m_prefetchRequest->result().toMap();
+        
+        if (!result.isEmpty()) {
+            if (m_prefetcher.setResult(result)) {
+                addPrefetchResult();
+            }
+            
+            return;
+        }
+    }
+    else {
+        Logger::log("YouTubeCommentModel::onPrefetchRequestFinished(). Error: "
+                    + YouTube::getErrorString(m_prefetchRequest->result().toMap()));
+    }
+    
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
+}
+
 void YouTubeCommentModel::onCommentAdded(YouTubeComment *comment) {
     if (m_filters.value("videoId") == comment->videoId()) {
         if (comment->parentId().isEmpty()) {
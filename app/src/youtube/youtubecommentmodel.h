@@ -17,6 +17,7 @@
 #ifndef YOUTUBECOMMENTMODEL_H
 #define YOUTUBECOMMENTMODEL_H
 
+#include "pageprefetcher.h"
 #include "youtubecomment.h"
 #include <QAbstractListModel>
 #include <QStringList>
@@ -28,6 +29,8 @@ class YouTubeCommentModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QYouTube::ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
 public:
@@ -46,6 +49,9 @@ public:
     
     QString errorString() const;
     
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
     QYouTube::ResourcesRequest::Status status() const;
     
 #if QT_VERSION >= 0x050000
@@ -72,22 +78,31 @@ public Q_SLOTS:
     void cancel();
     void reload();
     
+    void setVisibleRange(int first, int last);
+    
 private:
     void append(YouTubeComment *comment);
     void insert(int row, YouTubeComment *comment);
     void remove(int row);
     
+    void addComments(const QVariantMap &result);
+    
+    void addPrefetchResult();
+    
 private Q_SLOTS:
     void onRequestFinished();
+    void onPrefetchRequestFinished();
     
     void onCommentAdded(YouTubeComment *comment);
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void statusChanged(QYouTube::ResourcesRequest::Status s);
     
 private:
     QYouTube::ResourcesRequest *m_request;
+    QYouTube::ResourcesRequest *m_prefetchRequest;
     
     QString m_resourcePath;
     QStringList m_part;
@@ -95,6 +110,8 @@ private:
     QVariantMap m_params;
     QString m_nextPageToken;
         
+    PagePrefetcher m_prefetcher;
+    
     QList<YouTubeComment*> m_items;
     
     QHash<int, QByteArray> m_roles;
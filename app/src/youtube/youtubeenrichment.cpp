@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "youtubeenrichment.h"
+#include "logger.h"
+#include "youtube.h"
+#include "youtuberequestbroker.h"
+
+YouTubeEnrichment::YouTubeEnrichment(const QString &resourcePath, const QStringList &part, IdFunction idFunction,
+                                     QObject *parent) :
+    QObject(parent),
+    m_resourcePath(resourcePath),
+    m_part(part),
+    m_idFunction(idFunction)
+{
+}
+
+YouTubeEnrichment::~YouTubeEnrichment() {
+    clear();
+}
+
+bool YouTubeEnrichment::isLoading() const {
+    return !m_pages.isEmpty();
+}
+
+void YouTubeEnrichment::append(const QVariantList &items, const QVariant &tag) {
+    Page page;
+    page.reply = 0;
+    page.items = items;
+    page.tag = tag;
+    m_pages << page;
+    flush();
+}
+
+void YouTubeEnrichment::enrich(const QVariantList &items, const QVariant &tag) {
+    QStringList ids;
+    
+    foreach (const QVariant &item, items) {
+        ids << m_idFunction(item.toMap());
+    }
+    
+    QVariantMap filters;
+    filters["id"] = ids.join(",");
+    
+    Page page;
+    page.reply = YouTubeRequestBroker::instance()->list(m_resourcePath, m_part, filters, QVariantMap(), this);
+    page.items = items;
+    page.tag = tag;
+    m_pages << page;
+    
+    connect(page.reply, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+}
+
+void YouTubeEnrichment::clear() {
+    while (!m_pages.isEmpty()) {
+        if (YouTubeReply *reply = m_pages.takeFirst().reply) {
+            reply->disconnect(this);
+            reply->cancel();
+            reply->deleteLater();
+        }
+    }
+}
+
+void YouTubeEnrichment::join(Page &page) const {
+    const QVariantMap result = page.reply->result().toMap();
+    QHash<QString, QVariantMap> details;
+    
+    if (page.reply->status() == QYouTube::ResourcesRequest::Ready) {
+        foreach (const QVariant &v, result.value("items").toList()) {
+            const QVariantMap item = v.toMap();
+            details.insert(item.value("id").toString(), item);
+        }
+    }
+    else {
+        Logger::log("YouTubeEnrichment::join(). Error: " + YouTube::getErrorString(result));
+    }
+    
+    // Items without details are kept as they are, in their original position
+    for (int i = 0; i < page.items.size(); i++) {
+        QVariantMap item = page.items.at(i).toMap();
+        const QHash<QString, QVariantMap>::const_iterator iterator = details.constFind(m_idFunction(item));
+        
+        if (iterator != details.constEnd()) {
+            foreach (const QString &part, m_part) {
+                item[part] = iterator.value().value(part);
+            }
+            
+            page.items[i] = item;
+        }
+    }
+}
+
+void YouTubeEnrichment::flush() {
+    while ((!m_pages.isEmpty()) && (!m_pages.first().reply)) {
+        const Page page = m_pages.takeFirst();
+        emit finished(page.items, page.tag);
+    }
+}
+
+void YouTubeEnrichment::onRequestFinished() {
+    YouTubeReply *reply = qobject_cast<YouTubeReply*>(sender());
+    
+    if (!reply) {
+        return;
+    }
+    
+    for (int i = 0; i < m_pages.size(); i++) {
+        if (m_pages.at(i).reply == reply) {
+            Page &page = m_pages[i];
+            join(page);
+            page.reply = 0;
+            reply->deleteLater();
+            break;
+        }
+    }
+    
+    flush();
+}
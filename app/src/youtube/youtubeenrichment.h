@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef YOUTUBEENRICHMENT_H
+#define YOUTUBEENRICHMENT_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVariantList>
+
+class YouTubeReply;
+
+/*
+ * Merges the parts of a details request (e.g. /videos) into the items of a list page (e.g. search results).
+ *
+ * Each page gets its own details request, so a page can be enriched while the next one is listed.
+ * Pages are always emitted in the order in which they were added.
+ */
+class YouTubeEnrichment : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QString (*IdFunction)(const QVariantMap &item);
+    
+    explicit YouTubeEnrichment(const QString &resourcePath, const QStringList &part, IdFunction idFunction,
+                               QObject *parent = 0);
+    ~YouTubeEnrichment();
+    
+    bool isLoading() const;
+    
+    void append(const QVariantList &items, const QVariant &tag = QVariant());
+    void enrich(const QVariantList &items, const QVariant &tag = QVariant());
+
+public Q_SLOTS:
+    void clear();
+
+private Q_SLOTS:
+    void onRequestFinished();
+
+Q_SIGNALS:
+    void finished(const QVariantList &items, const QVariant &tag);
+
+private:
+    struct Page {
+        YouTubeReply *reply;
+        QVariantList items;
+        QVariant tag;
+    };
+    
+    void join(Page &page) const;
+    void flush();
+    
+    QString m_resourcePath;
+    QStringList m_part;
+    IdFunction m_idFunction;
+    
+    QList<Page> m_pages;
+};
+
+#endif // YOUTUBEENRICHMENT_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "youtubefeedmodel.h"
+#include "logger.h"
+#include "youtube.h"
+#include "youtubesubscriptionfeed.h"
+
+YouTubeFeedModel::YouTubeFeedModel(QObject *parent) :
+    YouTubeVideoModel(parent),
+    m_feed(new YouTubeSubscriptionFeed(this))
+{
+    connect(m_feed, SIGNAL(finished()), this, SLOT(onFeedFinished()));
+    connect(YouTube::instance(), SIGNAL(userIdChanged(QString)), this, SLOT(clear()));
+    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+}
+
+QString YouTubeFeedModel::errorString() const {
+    return m_feed->errorString();
+}
+
+QYouTube::ResourcesRequest::Status YouTubeFeedModel::status() const {
+    return m_feed->status();
+}
+
+bool YouTubeFeedModel::canFetchMore(const QModelIndex &) const {
+    // The feed is listed in full by each refresh
+    return false;
+}
+
+void YouTubeFeedModel::list() {
+    if (status() == QYouTube::ResourcesRequest::Loading) {
+        return;
+    }
+    
+    Logger::log("YouTubeFeedModel::list()", Logger::MediumVerbosity);
+    clear();
+    m_feed->refresh();
+    emit statusChanged(status());
+}
+
+void YouTubeFeedModel::clear() {
+    m_feed->clear();
+    YouTubeVideoModel::clear();
+}
+
+void YouTubeFeedModel::cancel() {
+    if (status() == QYouTube::ResourcesRequest::Loading) {
+        m_feed->cancel();
+        emit statusChanged(status());
+    }
+}
+
+void YouTubeFeedModel::reload() {
+    if (status() == QYouTube::ResourcesRequest::Loading) {
+        return;
+    }
+    
+    // Only items that are newer than those already listed are fetched
+    Logger::log("YouTubeFeedModel::reload()", Logger::MediumVerbosity);
+    m_feed->refresh();
+    emit statusChanged(status());
+}
+
+void YouTubeFeedModel::onFeedFinished() {
+    const QVariantList items = m_feed->items();
+    const QList<int> rows = m_feed->insertedRows();
+    
+    // The rows are ascending positions in the merged feed, so inserting them in order places each one correctly
+    foreach (int row, rows) {
+        insert(row, new YouTubeVideoData(items.at(row).toMap()));
+    }
+    
+    // Older items that no longer fit in the feed are dropped from the end
+    while (rowCount() > items.size()) {
+        remove(rowCount() - 1);
+    }
+    
+    emit countChanged(rowCount());
+    emit statusChanged(status());
+}
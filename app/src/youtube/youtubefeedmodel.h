@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef YOUTUBEFEEDMODEL_H
+#define YOUTUBEFEEDMODEL_H
+
+#include "youtubevideomodel.h"
+
+class YouTubeSubscriptionFeed;
+
+/*
+ * Lists the latest videos of the current account's subscriptions, newest first.
+ *
+ * The rows are held and presented by YouTubeVideoModel, so the same views and delegates can be used.
+ */
+class YouTubeFeedModel : public YouTubeVideoModel
+{
+    Q_OBJECT
+    
+public:
+    explicit YouTubeFeedModel(QObject *parent = 0);
+    
+    QString errorString() const;
+    
+    QYouTube::ResourcesRequest::Status status() const;
+    
+    bool canFetchMore(const QModelIndex &parent = QModelIndex()) const;
+    
+    Q_INVOKABLE void list();
+
+public Q_SLOTS:
+    void clear();
+    void cancel();
+    void reload();
+    
+private Q_SLOTS:
+    void onFeedFinished();
+    
+private:
+    YouTubeSubscriptionFeed *m_feed;
+};
+    
+#endif // YOUTUBEFEEDMODEL_H
@@ -30,6 +30,7 @@ void YouTubeNavModel::reload() {
     }
     else {
         setStringList(QStringList() << tr("Accounts") << tr("Search") << tr("Categories") << tr("My videos")
-                                    << tr("Favourites") << tr("Likes") << tr("Playlists") << tr("Subscriptions"));
+                                    << tr("Favourites") << tr("Likes") << tr("Playlists") << tr("Subscriptions")
+                                    << tr("Latest videos"));
     }
 }
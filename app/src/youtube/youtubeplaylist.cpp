@@ -18,60 +18,53 @@
 #include "logger.h"
 #include "resources.h"
 #include "youtube.h"
+#include "youtuberequestbroker.h"
 #include "youtubevideo.h"
 #include <QDateTime>
 
 YouTubePlaylist::YouTubePlaylist(QObject *parent) :
     CTPlaylist(parent),
     m_request(0),
+    m_reply(0),
     m_video(0)
 {
     setService(Resources::YOUTUBE);
-    connect(YouTube::instance(), SIGNAL(videoAddedToPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
-    connect(YouTube::instance(), SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
 }
 
 YouTubePlaylist::YouTubePlaylist(const QString &id, QObject *parent) :
     CTPlaylist(parent),
     m_request(0),
+    m_reply(0),
     m_video(0)
 {
     setService(Resources::YOUTUBE);
     loadPlaylist(id);
-    connect(YouTube::instance(), SIGNAL(videoAddedToPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
-    connect(YouTube::instance(), SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
 }
 
 YouTubePlaylist::YouTubePlaylist(const QVariantMap &playlist, QObject *parent) :
     CTPlaylist(parent),
     m_request(0),
+    m_reply(0),
     m_video(0)
 {
     setService(Resources::YOUTUBE);
     loadPlaylist(playlist);
-    connect(YouTube::instance(), SIGNAL(videoAddedToPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
-    connect(YouTube::instance(), SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
 }
 
 YouTubePlaylist::YouTubePlaylist(const YouTubePlaylist *playlist, QObject *parent) :
     CTPlaylist(playlist, parent),
     m_request(0),
+    m_reply(0),
     m_video(0),
     m_privacyStatus(playlist->privacyStatus())
 {
-    connect(YouTube::instance(), SIGNAL(videoAddedToPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
-    connect(YouTube::instance(), SIGNAL(videoRemovedFromPlaylist(YouTubeVideo*, YouTubePlaylist*)),
-            this, SLOT(onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*)));
 }
 
 QString YouTubePlaylist::errorString() const {
+    if (m_reply) {
+        return m_reply->errorString();
+    }
+    
     return m_request ? YouTube::getErrorString(m_request->result().toMap()) : QString();
 }
 
@@ -87,6 +80,10 @@ void YouTubePlaylist::setPrivacyStatus(const QString &s) {
 }
 
 QYouTube::ResourcesRequest::Status YouTubePlaylist::status() const {
+    if (m_reply) {
+        return m_reply->status();
+    }
+    
     return m_request ? m_request->status() : QYouTube::ResourcesRequest::Null;
 }
 
@@ -95,13 +92,16 @@ void YouTubePlaylist::loadPlaylist(const QString &id) {
         return;
     }
     
-    initRequest();
-    
     QVariantMap filters;
     filters["id"] = id;
     
-    m_request->list("/playlists", QStringList() << "snippet" << "contentDetails", filters);
-    connect(m_request, SIGNAL(finished()), this, SLOT(onPlaylistRequestFinished()));
+    if (m_reply) {
+        m_reply->deleteLater();
+    }
+    
+    m_reply = YouTubeRequestBroker::instance()->list("/playlists", QStringList() << "snippet" << "contentDetails", filters,
+                                                     QVariantMap(), this);
+    connect(m_reply, SIGNAL(finished()), this, SLOT(onPlaylistRequestFinished()));
     emit statusChanged(status());
 }
 
@@ -192,6 +192,12 @@ void YouTubePlaylist::removeVideo(YouTubeVideo *video) {
 }
 
 void YouTubePlaylist::initRequest() {
+    // The request is used for the next operation, so the status of the last load is no longer relevant
+    if (m_reply) {
+        m_reply->deleteLater();
+        m_reply = 0;
+    }
+    
     if (!m_request) {
         m_request = new QYouTube::ResourcesRequest(this);
         m_request->setApiKey(YouTube::apiKey());
@@ -206,15 +212,14 @@ void YouTubePlaylist::initRequest() {
 }
 
 void YouTubePlaylist::onPlaylistRequestFinished() {
-    if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantList list = m_request->result().toMap().value("items").toList();
+    if (m_reply->status() == QYouTube::ResourcesRequest::Ready) {
+        const QVariantList list = m_reply->result().toMap().value("items").toList();
         
         if (!list.isEmpty()) {
             loadPlaylist(list.first().toMap());
         }
     }
     
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onPlaylistRequestFinished()));
     emit statusChanged(status());
 }
 
@@ -289,9 +294,3 @@ void YouTubePlaylist::onRemoveVideoRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onRemoveVideoRequestFinished()));
     emit statusChanged(status());
 }
-
-void YouTubePlaylist::onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist *playlist) {
-    if ((playlist->id() == id()) && (playlist != this)) {
-        loadPlaylist(playlist);
-    }
-}
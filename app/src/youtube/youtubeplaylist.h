@@ -21,6 +21,7 @@
 #include <qyoutube/resourcesrequest.h>
 #include <QPointer>
 
+class YouTubeReply;
 class YouTubeVideo;
 
 class YouTubePlaylist : public CTPlaylist
@@ -62,7 +63,6 @@ private Q_SLOTS:
     void onCreatePlaylistRequestFinished();
     void onAddVideoRequestFinished();
     void onRemoveVideoRequestFinished();
-    void onPlaylistUpdated(YouTubeVideo*, YouTubePlaylist*);
     
 Q_SIGNALS:
     void privacyStatusChanged();
@@ -70,6 +70,7 @@ Q_SIGNALS:
 
 private:
     QYouTube::ResourcesRequest *m_request;
+    YouTubeReply *m_reply;
     QPointer<YouTubeVideo> m_video;
     
     QString m_privacyStatus;
@@ -17,11 +17,12 @@
 #include "youtubeplaylistmodel.h"
 #include "logger.h"
 #include "youtube.h"
+#include "youtubeenrichment.h"
 
 YouTubePlaylistModel::YouTubePlaylistModel(QObject *parent) :
     QAbstractListModel(parent),
     m_request(new QYouTube::ResourcesRequest(this)),
-    m_contentRequest(0)
+    m_enrichment(new YouTubeEnrichment("/playlists", QStringList() << "contentDetails", YouTube::getPlaylistId, this))
 {
     m_roles[DateRole] = "date";
     m_roles[DescriptionRole] = "description";
@@ -44,6 +45,7 @@ YouTubePlaylistModel::YouTubePlaylistModel(QObject *parent) :
     connect(m_request, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
     connect(m_request, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    connect(m_enrichment, SIGNAL(finished(QVariantList, QVariant)), this, SLOT(onEnrichmentFinished(QVariantList)));
 }
 
 QString YouTubePlaylistModel::errorString() const {
@@ -51,7 +53,7 @@ QString YouTubePlaylistModel::errorString() const {
 }
 
 QYouTube::ResourcesRequest::Status YouTubePlaylistModel::status() const {
-    if ((m_contentRequest) && (m_contentRequest->status() == QYouTube::ResourcesRequest::Loading)) {
+    if (m_enrichment->isLoading()) {
         return QYouTube::ResourcesRequest::Loading;
     }
     
@@ -69,7 +71,8 @@ int YouTubePlaylistModel::rowCount(const QModelIndex &) const {
 }
 
 bool YouTubePlaylistModel::canFetchMore(const QModelIndex &) const {
-    return (status() != QYouTube::ResourcesRequest::Loading) && (!m_nextPageToken.isEmpty());
+    // The next page can be listed while the details of the previous page are still loading
+    return (m_request->status() != QYouTube::ResourcesRequest::Loading) && (!m_nextPageToken.isEmpty());
 }
 
 void YouTubePlaylistModel::fetchMore(const QModelIndex &) {
@@ -161,6 +164,8 @@ void YouTubePlaylistModel::list(const QString &resourcePath, const QStringList &
 }
 
 void YouTubePlaylistModel::clear() {
+    m_enrichment->clear();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -186,32 +191,17 @@ void YouTubePlaylistModel::reload() {
     emit statusChanged(status());
 }
 
-void YouTubePlaylistModel::getAdditionalContent() {
-    if (!m_contentRequest) {
-        m_contentRequest = new QYouTube::ResourcesRequest(this);
-        m_contentRequest->setApiKey(YouTube::apiKey());
-        m_contentRequest->setClientId(YouTube::clientId());
-        m_contentRequest->setClientSecret(YouTube::clientSecret());
-        m_contentRequest->setAccessToken(YouTube::accessToken());
-        m_contentRequest->setRefreshToken(YouTube::refreshToken());
-
-        connect(m_contentRequest, SIGNAL(accessTokenChanged(QString)),
-                YouTube::instance(), SLOT(setAccessToken(QString)));
-        connect(m_contentRequest, SIGNAL(refreshTokenChanged(QString)),
-                YouTube::instance(), SLOT(setRefreshToken(QString)));
-        connect(m_contentRequest, SIGNAL(finished()), this, SLOT(onContentRequestFinished()));
-    }
-    
-    QStringList ids;
-    
-    for (int i = 0; i < m_results.size(); i++) {
-        ids << m_results.at(i).first;
+void YouTubePlaylistModel::addPlaylists(const QVariantList &playlists) {
+    if (!playlists.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + playlists.size() - 1);
+        
+        foreach (const QVariant &playlist, playlists) {
+            m_items << new YouTubePlaylist(playlist.toMap(), this);
+        }
+        
+        endInsertRows();
+        emit countChanged(rowCount());
     }
-    
-    QVariantMap filters;
-    filters["id"] = ids.join(",");
-    
-    m_contentRequest->list("/playlists", QStringList() << "contentDetails", filters);
 }
 
 void YouTubePlaylistModel::append(YouTubePlaylist *playlist) {
@@ -249,25 +239,13 @@ void YouTubePlaylistModel::onRequestFinished() {
 
             if (!list.isEmpty()) {
                 if (result.value("kind") == "youtube#searchListResponse") {
-                    foreach (const QVariant &v, list) {
-                        const QVariantMap item = v.toMap();
-                        m_results << QPair<QString, QVariantMap>(YouTube::getPlaylistId(item), item);
-                    }
-                    
-                    getAdditionalContent();
+                    m_enrichment->enrich(list);
                 }
                 else {
-                    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                    
-                    foreach (const QVariant &item, list) {
-                        m_items << new YouTubePlaylist(item.toMap(), this);
-                    }
-                    
-                    endInsertRows();
-                    emit countChanged(rowCount());
-                    emit statusChanged(status());
+                    m_enrichment->append(list);
                 }
-
+                
+                emit statusChanged(status());
                 return;
             }
         }
@@ -279,38 +257,8 @@ void YouTubePlaylistModel::onRequestFinished() {
     emit statusChanged(status());
 }
 
-void YouTubePlaylistModel::onContentRequestFinished() {
-    if (m_contentRequest->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantMap result = m_contentRequest->result().toMap();
-        
-        if (!result.isEmpty()) {
-            const QVariantList list = result.value("items").toList();
-
-            if (!list.isEmpty()) {
-                beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                
-                foreach (const QVariant &v, list) {
-                    const QVariantMap item = v.toMap();
-                    
-                    for (int i = 0; i < m_results.size(); i++) {
-                        if (m_results.at(i).first == YouTube::getPlaylistId(item)) {
-                            QVariantMap playlist = m_results.takeAt(i).second;
-                            playlist["contentDetails"] = item.value("contentDetails");
-                            m_items << new YouTubePlaylist(playlist, this);
-                            break;
-                        }
-                    }
-                }
-
-                endInsertRows();
-                emit countChanged(rowCount());
-            }
-        }
-    }
-    else {
-        Logger::log("YouTubePlaylistModel::onContentRequestFinished(). Error: " + errorString());
-    }
-
+void YouTubePlaylistModel::onEnrichmentFinished(const QVariantList &playlists) {
+    addPlaylists(playlists);
     emit statusChanged(status());
 }
 
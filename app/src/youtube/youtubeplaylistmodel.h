@@ -21,6 +21,8 @@
 #include <QAbstractListModel>
 #include <QStringList>
 
+class YouTubeEnrichment;
+
 class YouTubePlaylistModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -74,7 +76,7 @@ public Q_SLOTS:
     void reload();
     
 private:
-    void getAdditionalContent();
+    void addPlaylists(const QVariantList &playlists);
     
     void append(YouTubePlaylist *playlist);
     void insert(int row, YouTubePlaylist *playlist);
@@ -82,7 +84,7 @@ private:
     
 private Q_SLOTS:
     void onRequestFinished();
-    void onContentRequestFinished();
+    void onEnrichmentFinished(const QVariantList &playlists);
     void onPlaylistCreated(YouTubePlaylist *playlist);
     void onPlaylistDeleted(YouTubePlaylist *playlist);
     
@@ -92,7 +94,7 @@ Q_SIGNALS:
     
 private:
     QYouTube::ResourcesRequest *m_request;
-    QYouTube::ResourcesRequest *m_contentRequest;
+    YouTubeEnrichment *m_enrichment;
     
     QString m_resourcePath;
     QStringList m_part;
@@ -100,8 +102,6 @@ private:
     QVariantMap m_params;
     QString m_nextPageToken;
     
-    QList< QPair<QString, QVariantMap> > m_results;
-    
     QList<YouTubePlaylist*> m_items;
     
     QHash<int, QByteArray> m_roles;
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "youtuberequestbroker.h"
+#include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
+#include "youtube.h"
+#include <QTimer>
+
+YouTubeReply::YouTubeReply(QObject *parent) :
+    QObject(parent),
+    m_status(QYouTube::ResourcesRequest::Loading)
+{
+}
+
+QString YouTubeReply::errorString() const {
+    return YouTube::getErrorString(m_result.toMap());
+}
+
+QVariant YouTubeReply::result() const {
+    return m_result;
+}
+
+QYouTube::ResourcesRequest::Status YouTubeReply::status() const {
+    return m_status;
+}
+
+void YouTubeReply::cancel() {
+    if (m_status == QYouTube::ResourcesRequest::Loading) {
+        YouTubeRequestBroker::instance()->cancel(this);
+        setResult(QYouTube::ResourcesRequest::Canceled, QVariant());
+    }
+}
+
+void YouTubeReply::setResult(QYouTube::ResourcesRequest::Status status, const QVariant &result) {
+    m_status = status;
+    m_result = result;
+    emit finished();
+}
+
+YouTubeRequestBroker* YouTubeRequestBroker::self = 0;
+
+// The maximum number of ids accepted by the YouTube Data API in a single request
+const int YouTubeRequestBroker::MAX_BATCH_SIZE = 50;
+
+YouTubeRequestBroker::YouTubeRequestBroker() :
+    QObject()
+{
+}
+
+YouTubeRequestBroker::~YouTubeRequestBroker() {
+    qDeleteAll(m_calls);
+    qDeleteAll(m_batches);
+    self = 0;
+}
+
+YouTubeRequestBroker* YouTubeRequestBroker::instance() {
+    return self ? self : self = new YouTubeRequestBroker;
+}
+
+YouTubeReply* YouTubeRequestBroker::list(const QString &resourcePath, const QStringList &part,
+                                         const QVariantMap &filters, const QVariantMap &params, QObject *parent) {
+    YouTubeReply *reply = new YouTubeReply(parent);
+    
+    if (isBatchable(resourcePath, filters, params)) {
+        const QString key = ResponseCache::key(Resources::YOUTUBE, resourcePath, part);
+        const QString id = filters.value("id").toString();
+        
+        foreach (Call *call, m_calls) {
+            if ((call->key == key) && (call->replies.contains(id))) {
+                Logger::log("YouTubeRequestBroker::list(). Joining request for ID: " + id, Logger::HighVerbosity);
+                call->replies.insert(id, reply);
+                return reply;
+            }
+        }
+        
+        Call *batch = m_batches.value(key);
+        
+        if (!batch) {
+            batch = new Call;
+            batch->request = 0;
+            batch->key = key;
+            batch->resourcePath = resourcePath;
+            batch->part = part;
+            m_batches.insert(key, batch);
+            QTimer::singleShot(0, this, SLOT(flush()));
+        }
+        
+        batch->replies.insert(id, reply);
+        return reply;
+    }
+    
+    const QString key = ResponseCache::key(Resources::YOUTUBE, resourcePath, QVariantList() << part << filters << params);
+    
+    foreach (Call *call, m_calls) {
+        if (call->key == key) {
+            Logger::log("YouTubeRequestBroker::list(). Joining request: " + key, Logger::HighVerbosity);
+            call->replies.insert(QString(), reply);
+            return reply;
+        }
+    }
+    
+    Call *call = new Call;
+    call->request = 0;
+    call->key = key;
+    call->resourcePath = resourcePath;
+    call->part = part;
+    call->replies.insert(QString(), reply);
+    start(call, filters, params);
+    return reply;
+}
+
+bool YouTubeRequestBroker::isBatchable(const QString &resourcePath, const QVariantMap &filters,
+                                       const QVariantMap &params) {
+    if ((filters.size() != 1) || (!params.isEmpty())) {
+        return false;
+    }
+    
+    const QString id = filters.value("id").toString();
+    
+    if ((id.isEmpty()) || (id.contains(','))) {
+        return false;
+    }
+    
+    return (resourcePath == "/videos") || (resourcePath == "/channels") || (resourcePath == "/playlists");
+}
+
+void YouTubeRequestBroker::start(Call *call, const QVariantMap &filters, const QVariantMap &params) {
+    call->request = new QYouTube::ResourcesRequest(this);
+    call->request->setApiKey(YouTube::apiKey());
+    call->request->setClientId(YouTube::clientId());
+    call->request->setClientSecret(YouTube::clientSecret());
+    call->request->setAccessToken(YouTube::accessToken());
+    call->request->setRefreshToken(YouTube::refreshToken());
+    m_calls << call;
+    
+    connect(call->request, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
+    connect(call->request, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
+    connect(call->request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    call->request->list(call->resourcePath, call->part, filters, params);
+}
+
+void YouTubeRequestBroker::cancel(YouTubeReply *reply) {
+    foreach (Call *batch, m_batches) {
+        QMutableHashIterator< QString, QPointer<YouTubeReply> > iterator(batch->replies);
+        
+        while (iterator.hasNext()) {
+            if (iterator.next().value() == reply) {
+                iterator.remove();
+            }
+        }
+    }
+    
+    for (int i = m_calls.size() - 1; i >= 0; i--) {
+        Call *call = m_calls.at(i);
+        QMutableHashIterator< QString, QPointer<YouTubeReply> > iterator(call->replies);
+        bool found = false;
+        bool waiting = false;
+        
+        while (iterator.hasNext()) {
+            const QPointer<YouTubeReply> r = iterator.next().value();
+            
+            if (r == reply) {
+                iterator.remove();
+                found = true;
+            }
+            else if ((r) && (r->status() == QYouTube::ResourcesRequest::Loading)) {
+                waiting = true;
+            }
+        }
+        
+        // The request is only cancelled once no other reply is waiting for it
+        if ((found) && (!waiting)) {
+            m_calls.removeAt(i);
+            call->request->disconnect(this);
+            call->request->cancel();
+            call->request->deleteLater();
+            delete call;
+        }
+    }
+}
+
+void YouTubeRequestBroker::flush() {
+    foreach (Call *batch, m_batches) {
+        const QStringList ids = batch->replies.uniqueKeys();
+        
+        for (int i = 0; i < ids.size(); i += MAX_BATCH_SIZE) {
+            const QStringList chunk = ids.mid(i, MAX_BATCH_SIZE);
+            Call *call = new Call;
+            call->request = 0;
+            call->key = batch->key;
+            call->resourcePath = batch->resourcePath;
+            call->part = batch->part;
+            
+            foreach (const QString &id, chunk) {
+                foreach (const QPointer<YouTubeReply> &reply, batch->replies.values(id)) {
+                    call->replies.insert(id, reply);
+                }
+            }
+            
+            QVariantMap filters;
+            filters["id"] = chunk.join(",");
+            Logger::log(QString("YouTubeRequestBroker::flush(). Resource path: %1, IDs: %2").arg(call->resourcePath)
+                        .arg(filters.value("id").toString()), Logger::HighVerbosity);
+            start(call, filters, QVariantMap());
+        }
+    }
+    
+    qDeleteAll(m_batches);
+    m_batches.clear();
+}
+
+void YouTubeRequestBroker::onRequestFinished() {
+    QYouTube::ResourcesRequest *request = qobject_cast<QYouTube::ResourcesRequest*>(sender());
+    
+    if (!request) {
+        return;
+    }
+    
+    Call *call = 0;
+    
+    for (int i = 0; i < m_calls.size(); i++) {
+        if (m_calls.at(i)->request == request) {
+            call = m_calls.takeAt(i);
+            break;
+        }
+    }
+    
+    if (!call) {
+        return;
+    }
+    
+    const QYouTube::ResourcesRequest::Status status = request->status();
+    const QVariant result = request->result();
+    QHash<QString, QVariant> items;
+    
+    if ((status == QYouTube::ResourcesRequest::Ready) && (call->replies.size() > call->replies.count(QString()))) {
+        foreach (const QVariant &item, result.toMap().value("items").toList()) {
+            items.insert(item.toMap().value("id").toString(), item);
+        }
+    }
+    
+    // Replies are notified after the call is removed, so that they can make new requests when notified
+    QMultiHash< QString, QPointer<YouTubeReply> >::const_iterator iterator = call->replies.constBegin();
+    
+    while (iterator != call->replies.constEnd()) {
+        if (YouTubeReply *reply = iterator.value()) {
+            if (reply->status() == QYouTube::ResourcesRequest::Loading) {
+                if ((iterator.key().isEmpty()) || (status != QYouTube::ResourcesRequest::Ready)) {
+                    reply->setResult(status, result);
+                }
+                else {
+                    // A batched reply only receives the item that it asked for
+                    QVariantMap map = result.toMap();
+                    const QHash<QString, QVariant>::const_iterator item = items.constFind(iterator.key());
+                    map["items"] = (item != items.constEnd() ? QVariantList() << item.value() : QVariantList());
+                    reply->setResult(status, map);
+                }
+            }
+        }
+        
+        ++iterator;
+    }
+    
+    request->deleteLater();
+    delete call;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef YOUTUBEREQUESTBROKER_H
+#define YOUTUBEREQUESTBROKER_H
+
+#include <qyoutube/resourcesrequest.h>
+#include <QMultiHash>
+#include <QPointer>
+#include <QStringList>
+
+class YouTubeReply : public QObject
+{
+    Q_OBJECT
+
+public:
+    QString errorString() const;
+    
+    QVariant result() const;
+    
+    QYouTube::ResourcesRequest::Status status() const;
+
+public Q_SLOTS:
+    void cancel();
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    explicit YouTubeReply(QObject *parent = 0);
+    
+    void setResult(QYouTube::ResourcesRequest::Status status, const QVariant &result);
+    
+    QYouTube::ResourcesRequest::Status m_status;
+    QVariant m_result;
+    
+    friend class YouTubeRequestBroker;
+};
+
+/*
+ * Shares list requests between all YouTube objects and models.
+ *
+ * A request that is identical to one already in flight is joined to it, and single id lookups of
+ * videos, channels and playlists made in the same event loop iteration are sent as one request with
+ * comma-separated ids. Each reply receives the result as if it had made the request itself.
+ */
+class YouTubeRequestBroker : public QObject
+{
+    Q_OBJECT
+
+public:
+    ~YouTubeRequestBroker();
+    
+    static YouTubeRequestBroker* instance();
+    
+    YouTubeReply* list(const QString &resourcePath, const QStringList &part, const QVariantMap &filters = QVariantMap(),
+                       const QVariantMap &params = QVariantMap(), QObject *parent = 0);
+
+private Q_SLOTS:
+    void flush();
+    void onRequestFinished();
+
+private:
+    YouTubeRequestBroker();
+    
+    struct Call {
+        QYouTube::ResourcesRequest *request;
+        QString key;
+        QString resourcePath;
+        QStringList part;
+        QMultiHash< QString, QPointer<YouTubeReply> > replies;
+    };
+    
+    static bool isBatchable(const QString &resourcePath, const QVariantMap &filters, const QVariantMap &params);
+    
+    void start(Call *call, const QVariantMap &filters, const QVariantMap &params);
+    void cancel(YouTubeReply *reply);
+    
+    static YouTubeRequestBroker *self;
+    
+    static const int MAX_BATCH_SIZE;
+    
+    QList<Call*> m_calls;
+    QHash<QString, Call*> m_batches;
+    
+    friend class YouTubeReply;
+};
+
+#endif // YOUTUBEREQUESTBROKER_H
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "youtubesubscriptionfeed.h"
+#include "logger.h"
+#include "youtube.h"
+#include "youtubeenrichment.h"
+#include "youtuberequestbroker.h"
+#include "youtubesubscriptionindex.h"
+#include <QVector>
+#include <algorithm>
+
+// The maximum number of ids accepted by the YouTube Data API in a single request
+static const int ENRICHMENT_PAGE_SIZE = 50;
+
+struct FeedHead {
+    QDateTime date;
+    int sequence;
+    int index;
+};
+
+static bool feedHeadOlderThan(const FeedHead &head, const FeedHead &other) {
+    return head.date < other.date;
+}
+
+YouTubeSubscriptionFeed::YouTubeSubscriptionFeed(QObject *parent) :
+    QObject(parent),
+    m_enrichment(new YouTubeEnrichment("/videos", QStringList() << "contentDetails" << "statistics",
+                                       YouTube::getVideoId, this)),
+    m_enrichmentPages(0),
+    m_status(QYouTube::ResourcesRequest::Null),
+    m_channels(0),
+    m_failures(0),
+    m_itemsPerChannel(10),
+    m_maximumRequests(4),
+    m_maximumCount(200)
+{
+    connect(m_enrichment, SIGNAL(finished(QVariantList, QVariant)),
+            this, SLOT(onEnrichmentFinished(QVariantList, QVariant)));
+}
+
+YouTubeSubscriptionFeed::~YouTubeSubscriptionFeed() {
+    cancel();
+}
+
+QString YouTubeSubscriptionFeed::errorString() const {
+    return m_errorString;
+}
+
+QYouTube::ResourcesRequest::Status YouTubeSubscriptionFeed::status() const {
+    return m_status;
+}
+
+QVariantList YouTubeSubscriptionFeed::items() const {
+    return m_items;
+}
+
+QList<int> YouTubeSubscriptionFeed::insertedRows() const {
+    return m_insertedRows;
+}
+
+int YouTubeSubscriptionFeed::itemsPerChannel() const {
+    return m_itemsPerChannel;
+}
+
+void YouTubeSubscriptionFeed::setItemsPerChannel(int count) {
+    m_itemsPerChannel = qBound(1, count, 50);
+}
+
+int YouTubeSubscriptionFeed::maximumConcurrentRequests() const {
+    return m_maximumRequests;
+}
+
+void YouTubeSubscriptionFeed::setMaximumConcurrentRequests(int count) {
+    m_maximumRequests = qMax(1, count);
+}
+
+int YouTubeSubscriptionFeed::maximumCount() const {
+    return m_maximumCount;
+}
+
+void YouTubeSubscriptionFeed::setMaximumCount(int count) {
+    m_maximumCount = qMax(1, count);
+}
+
+void YouTubeSubscriptionFeed::refresh() {
+    if (status() == QYouTube::ResourcesRequest::Loading) {
+        return;
+    }
+    
+    m_status = QYouTube::ResourcesRequest::Loading;
+    m_errorString = QString();
+    m_insertedRows.clear();
+    YouTubeSubscriptionIndex *index = YouTubeSubscriptionIndex::instance();
+    
+    if (!index->isLoaded()) {
+        Logger::log("YouTubeSubscriptionFeed::refresh(). Waiting for subscriptions", Logger::MediumVerbosity);
+        connect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()), Qt::UniqueConnection);
+        index->sync();
+        return;
+    }
+    
+    m_queue = index->ids();
+    m_channels = m_queue.size();
+    m_failures = 0;
+    Logger::log(QString("YouTubeSubscriptionFeed::refresh(). Channels: %1").arg(m_channels), Logger::MediumVerbosity);
+    startRequests();
+}
+
+void YouTubeSubscriptionFeed::cancel() {
+    disconnect(YouTubeSubscriptionIndex::instance(), SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()));
+    
+    QHashIterator<YouTubeReply*, QString> iterator(m_replies);
+    
+    while (iterator.hasNext()) {
+        YouTubeReply *reply = iterator.next().key();
+        reply->disconnect(this);
+        reply->cancel();
+        reply->deleteLater();
+    }
+    
+    m_replies.clear();
+    m_queue.clear();
+    m_pages.clear();
+    m_enriched.clear();
+    m_enrichmentPages = 0;
+    m_enrichment->clear();
+    
+    if (m_status == QYouTube::ResourcesRequest::Loading) {
+        m_status = QYouTube::ResourcesRequest::Canceled;
+    }
+}
+
+void YouTubeSubscriptionFeed::clear() {
+    cancel();
+    m_highWaterMarks.clear();
+    m_items.clear();
+    m_insertedRows.clear();
+    m_status = QYouTube::ResourcesRequest::Null;
+}
+
+QString YouTubeSubscriptionFeed::uploadsPlaylistId(const QString &channelId) {
+    // The uploads playlist of a channel has the id of the channel with the prefix UU instead of UC
+    return channelId.startsWith("UC") ? "UU" + channelId.mid(2) : QString();
+}
+
+QDateTime YouTubeSubscriptionFeed::itemDate(const QVariant &item) {
+    return QDateTime::fromString(item.toMap().value("snippet").toMap().value("publishedAt").toString(), Qt::ISODate);
+}
+
+bool YouTubeSubscriptionFeed::newerThan(const QVariant &item, const QVariant &other) {
+    return itemDate(item) > itemDate(other);
+}
+
+QVariantList YouTubeSubscriptionFeed::merge(const QList<QVariantList> &sequences, int maximum, QList<int> *sources) {
+    // Each sequence is sorted newest first, so the newest remaining item is always at the top of the heap
+    QVector<FeedHead> heap;
+    heap.reserve(sequences.size());
+    
+    for (int i = 0; i < sequences.size(); i++) {
+        if (!sequences.at(i).isEmpty()) {
+            FeedHead head;
+            head.date = itemDate(sequences.at(i).first());
+            head.sequence = i;
+            head.index = 0;
+            heap << head;
+        }
+    }
+    
+    std::make_heap(heap.begin(), heap.end(), feedHeadOlderThan);
+    QVariantList result;
+    
+    while ((!heap.isEmpty()) && (result.size() < maximum)) {
+        std::pop_heap(heap.begin(), heap.end(), feedHeadOlderThan);
+        FeedHead &head = heap.last();
+        const QVariantList &sequence = sequences.at(head.sequence);
+        result << sequence.at(head.index);
+        
+        if (sources) {
+            *sources << head.sequence;
+        }
+        
+        if (++head.index < sequence.size()) {
+            head.date = itemDate(sequence.at(head.index));
+            std::push_heap(heap.begin(), heap.end(), feedHeadOlderThan);
+        }
+        else {
+            heap.pop_back();
+        }
+    }
+    
+    return result;
+}
+
+void YouTubeSubscriptionFeed::startRequests() {
+    while ((m_replies.size() < m_maximumRequests) && (!m_queue.isEmpty())) {
+        const QString channelId = m_queue.takeFirst();
+        const QString playlistId = uploadsPlaylistId(channelId);
+        
+        if (playlistId.isEmpty()) {
+            Logger::log("YouTubeSubscriptionFeed::startRequests(). No uploads playlist for channel: " + channelId);
+            continue;
+        }
+        
+        QVariantMap filters;
+        filters["playlistId"] = playlistId;
+        
+        QVariantMap params;
+        params["maxResults"] = m_itemsPerChannel;
+        
+        YouTubeReply *reply = YouTubeRequestBroker::instance()->list("/playlistItems", QStringList() << "snippet",
+                                                                     filters, params, this);
+        m_replies.insert(reply, channelId);
+        connect(reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+    }
+    
+    if ((m_replies.isEmpty()) && (m_queue.isEmpty())) {
+        enrich();
+    }
+}
+
+void YouTubeSubscriptionFeed::enrich() {
+    // Only the newest items across all channels are kept, so only those need their details
+    const QVariantList items = merge(m_pages, m_maximumCount);
+    m_pages.clear();
+    m_enriched.clear();
+    
+    if (items.isEmpty()) {
+        finish();
+        return;
+    }
+    
+    for (int i = 0; i < items.size(); i += ENRICHMENT_PAGE_SIZE) {
+        m_enrichmentPages++;
+        m_enrichment->enrich(items.mid(i, ENRICHMENT_PAGE_SIZE));
+    }
+}
+
+void YouTubeSubscriptionFeed::finish() {
+    QList<int> sources;
+    m_items = merge(QList<QVariantList>() << m_items << m_enriched, m_maximumCount, &sources);
+    m_enriched.clear();
+    
+    for (int i = 0; i < sources.size(); i++) {
+        if (sources.at(i) == 1) {
+            m_insertedRows << i;
+        }
+    }
+    
+    // The feed is only considered to have failed if no channel could be listed
+    m_status = ((m_failures > 0) && (m_failures == m_channels) ? QYouTube::ResourcesRequest::Failed
+                                                                : QYouTube::ResourcesRequest::Ready);
+    Logger::log(QString("YouTubeSubscriptionFeed::finish(). New items: %1, Failures: %2")
+                       .arg(m_insertedRows.size()).arg(m_failures), Logger::MediumVerbosity);
+    emit finished();
+}
+
+void YouTubeSubscriptionFeed::onSubscriptionsSynced() {
+    YouTubeSubscriptionIndex *index = YouTubeSubscriptionIndex::instance();
+    disconnect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()));
+    
+    if (!index->isLoaded()) {
+        m_status = QYouTube::ResourcesRequest::Failed;
+        m_errorString = tr("Unable to retrieve subscriptions");
+        emit finished();
+        return;
+    }
+    
+    m_status = QYouTube::ResourcesRequest::Null;
+    refresh();
+}
+
+void YouTubeSubscriptionFeed::onReplyFinished() {
+    YouTubeReply *reply = qobject_cast<YouTubeReply*>(sender());
+    
+    if ((!reply) || (!m_replies.contains(reply))) {
+        return;
+    }
+    
+    const QString channelId = m_replies.take(reply);
+    
+    if (reply->status() == QYouTube::ResourcesRequest::Ready) {
+        const QDateTime highWaterMark = m_highWaterMarks.value(channelId);
+        QVariantList items;
+        
+        foreach (const QVariant &item, reply->result().toMap().value("items").toList()) {
+            if ((!highWaterMark.isValid()) || (itemDate(item) > highWaterMark)) {
+                items << item;
+            }
+        }
+        
+        if (!items.isEmpty()) {
+            qSort(items.begin(), items.end(), newerThan);
+            m_highWaterMarks[channelId] = itemDate(items.first());
+            m_pages << items;
+        }
+    }
+    else {
+        Logger::log(QString("YouTubeSubscriptionFeed::onReplyFinished(). Channel: %1, Error: %2").arg(channelId)
+                    .arg(reply->errorString()));
+        m_errorString = reply->errorString();
+        m_failures++;
+    }
+    
+    reply->deleteLater();
+    startRequests();
+}
+
+void YouTubeSubscriptionFeed::onEnrichmentFinished(const QVariantList &items, const QVariant &) {
+    m_enriched << items;
+    
+    if (--m_enrichmentPages == 0) {
+        finish();
+    }
+}
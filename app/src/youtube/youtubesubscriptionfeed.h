@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef YOUTUBESUBSCRIPTIONFEED_H
+#define YOUTUBESUBSCRIPTIONFEED_H
+
+#include <qyoutube/resourcesrequest.h>
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+
+class YouTubeEnrichment;
+class YouTubeReply;
+
+/*
+ * Builds a "latest from my subscriptions" feed from the uploads playlists of the subscribed channels.
+ *
+ * The playlists are fetched in parallel, at most maximumConcurrentRequests() at a time, and merged by date.
+ * Each channel keeps the date of its newest item, so a refresh only adds the items that are newer.
+ */
+class YouTubeSubscriptionFeed : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit YouTubeSubscriptionFeed(QObject *parent = 0);
+    ~YouTubeSubscriptionFeed();
+    
+    QString errorString() const;
+    
+    QYouTube::ResourcesRequest::Status status() const;
+    
+    QVariantList items() const;
+    QList<int> insertedRows() const;
+    
+    int itemsPerChannel() const;
+    void setItemsPerChannel(int count);
+    
+    int maximumConcurrentRequests() const;
+    void setMaximumConcurrentRequests(int count);
+    
+    int maximumCount() const;
+    void setMaximumCount(int count);
+
+public Q_SLOTS:
+    void refresh();
+    void cancel();
+    void clear();
+
+private Q_SLOTS:
+    void onSubscriptionsSynced();
+    void onReplyFinished();
+    void onEnrichmentFinished(const QVariantList &items, const QVariant &tag);
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    static QString uploadsPlaylistId(const QString &channelId);
+    static QDateTime itemDate(const QVariant &item);
+    static bool newerThan(const QVariant &item, const QVariant &other);
+    static QVariantList merge(const QList<QVariantList> &sequences, int maximum, QList<int> *sources = 0);
+    
+    void startRequests();
+    void enrich();
+    void finish();
+    
+    YouTubeEnrichment *m_enrichment;
+    
+    QStringList m_queue;
+    QHash<YouTubeReply*, QString> m_replies;
+    QList<QVariantList> m_pages;
+    QVariantList m_enriched;
+    int m_enrichmentPages;
+    
+    QHash<QString, QDateTime> m_highWaterMarks;
+    
+    QVariantList m_items;
+    QList<int> m_insertedRows;
+    
+    QYouTube::ResourcesRequest::Status m_status;
+    QString m_errorString;
+    int m_channels;
+    int m_failures;
+    
+    int m_itemsPerChannel;
+    int m_maximumRequests;
+    int m_maximumCount;
+};
+
+#endif // YOUTUBESUBSCRIPTIONFEED_H
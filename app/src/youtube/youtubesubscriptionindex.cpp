@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "youtubesubscriptionindex.h"
+#include "resources.h"
+#include "youtube.h"
+#include <qyoutube/resourcesrequest.h>
+
+YouTubeSubscriptionIndex* YouTubeSubscriptionIndex::self = 0;
+
+YouTubeSubscriptionIndex::YouTubeSubscriptionIndex() :
+    SubscriptionIndex(Resources::YOUTUBE),
+    m_request(0)
+{
+    setUserId(YouTube::userId());
+}
+
+YouTubeSubscriptionIndex::~YouTubeSubscriptionIndex() {
+    self = 0;
+}
+
+YouTubeSubscriptionIndex* YouTubeSubscriptionIndex::instance() {
+    return self ? self : self = new YouTubeSubscriptionIndex;
+}
+
+void YouTubeSubscriptionIndex::fetchPage(const QVariant &cursor) {
+    if (!m_request) {
+        m_request = new QYouTube::ResourcesRequest(this);
+        connect(m_request, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
+        connect(m_request, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
+        connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    }
+    
+    // The account may have changed since the last page
+    m_request->setApiKey(YouTube::apiKey());
+    m_request->setClientId(YouTube::clientId());
+    m_request->setClientSecret(YouTube::clientSecret());
+    m_request->setAccessToken(YouTube::accessToken());
+    m_request->setRefreshToken(YouTube::refreshToken());
+    
+    QVariantMap filters;
+    filters["mine"] = true;
+    
+    QVariantMap params;
+    params["maxResults"] = 50;
+    
+    if (!cursor.isNull()) {
+        params["pageToken"] = cursor;
+    }
+    
+    m_request->list("/subscriptions", QStringList() << "snippet", filters, params);
+}
+
+void YouTubeSubscriptionIndex::cancelPage() {
+    if (m_request) {
+        m_request->cancel();
+    }
+}
+
+void YouTubeSubscriptionIndex::onRequestFinished() {
+    const QVariantMap result = m_request->result().toMap();
+    
+    if (m_request->status() != QYouTube::ResourcesRequest::Ready) {
+        pageFailed(YouTube::getErrorString(result));
+        return;
+    }
+    
+    QHash<QString, QString> ids;
+    
+    foreach (const QVariant &item, result.value("items").toList()) {
+        const QVariantMap map = item.toMap();
+        ids.insert(map.value("snippet").toMap().value("resourceId").toMap().value("channelId").toString(),
+                   map.value("id").toString());
+    }
+    
+    const QString next = result.value("nextPageToken").toString();
+    addPage(ids, next.isEmpty() ? QVariant() : QVariant(next));
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef YOUTUBESUBSCRIPTIONINDEX_H
+#define YOUTUBESUBSCRIPTIONINDEX_H
+
+#include "subscriptionindex.h"
+
+namespace QYouTube {
+    class ResourcesRequest;
+}
+
+class YouTubeSubscriptionIndex : public SubscriptionIndex
+{
+    Q_OBJECT
+
+public:
+    ~YouTubeSubscriptionIndex();
+    
+    static YouTubeSubscriptionIndex* instance();
+
+protected:
+    virtual void fetchPage(const QVariant &cursor);
+    virtual void cancelPage();
+
+private Q_SLOTS:
+    void onRequestFinished();
+
+private:
+    YouTubeSubscriptionIndex();
+    
+    static YouTubeSubscriptionIndex *self;
+    
+    QYouTube::ResourcesRequest *m_request;
+};
+
+#endif // YOUTUBESUBSCRIPTIONINDEX_H
@@ -18,54 +18,48 @@
 #include "logger.h"
 #include "resources.h"
 #include "youtube.h"
+#include "youtuberequestbroker.h"
+#include "youtubesubscriptionindex.h"
 
 YouTubeUser::YouTubeUser(QObject *parent) :
     CTUser(parent),
     m_request(0),
+    m_reply(0),
     m_subscribed(false),
     m_subscriberCount(0),
     m_viewCount(0)
 {
     setService(Resources::YOUTUBE);
-    connect(YouTube::instance(), SIGNAL(userSubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
-    connect(YouTube::instance(), SIGNAL(userUnsubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
 }
 
 YouTubeUser::YouTubeUser(const QString &id, QObject *parent) :
     CTUser(parent),
     m_request(0),
+    m_reply(0),
     m_subscribed(false),
     m_subscriberCount(0),
     m_viewCount(0)
 {
     setService(Resources::YOUTUBE);
     loadUser(id);
-    connect(YouTube::instance(), SIGNAL(userSubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
-    connect(YouTube::instance(), SIGNAL(userUnsubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
 }
 
 YouTubeUser::YouTubeUser(const QVariantMap &user, QObject *parent) :
     CTUser(parent),
     m_request(0),
+    m_reply(0),
     m_subscribed(false),
     m_subscriberCount(0),
     m_viewCount(0)
 {
     setService(Resources::YOUTUBE);
     loadUser(user);
-    connect(YouTube::instance(), SIGNAL(userSubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
-    connect(YouTube::instance(), SIGNAL(userUnsubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
 }
 
 YouTubeUser::YouTubeUser(const YouTubeUser *user, QObject *parent) :
     CTUser(user, parent),
     m_request(0),
+    m_reply(0),
     m_bannerUrl(user->bannerUrl()),
     m_largeBannerUrl(user->largeBannerUrl()),
     m_relatedPlaylists(user->relatedPlaylists()),
@@ -74,10 +68,6 @@ YouTubeUser::YouTubeUser(const YouTubeUser *user, QObject *parent) :
     m_subscriberCount(user->subscriberCount()),
     m_viewCount(user->viewCount())
 {
-    connect(YouTube::instance(), SIGNAL(userSubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
-    connect(YouTube::instance(), SIGNAL(userUnsubscribed(YouTubeUser*)),
-            this, SLOT(onUserUpdated(YouTubeUser*)));
 }
 
 QUrl YouTubeUser::bannerUrl() const {
@@ -92,6 +82,10 @@ void YouTubeUser::setBannerUrl(const QUrl &u) {
 }
 
 QString YouTubeUser::errorString() const {
+    if (m_reply) {
+        return m_reply->errorString();
+    }
+    
     return m_request ? YouTube::getErrorString(m_request->result().toMap()) : QString();
 }
 
@@ -116,6 +110,10 @@ void YouTubeUser::setRelatedPlaylists(const QVariantMap &p) {
 }
 
 QYouTube::ResourcesRequest::Status YouTubeUser::status() const {
+    if (m_reply) {
+        return m_reply->status();
+    }
+    
     return m_request ? m_request->status() : QYouTube::ResourcesRequest::Null;
 }
 
@@ -168,8 +166,6 @@ void YouTubeUser::loadUser(const QString &id) {
         return;
     }
     
-    initRequest();
-    
     QVariantMap filters;
     
     if (id.isEmpty()) {
@@ -179,9 +175,15 @@ void YouTubeUser::loadUser(const QString &id) {
         filters["id"] = id;
     }
     
-    m_request->list("/channels", QStringList() << "snippet" << "contentDetails" << "brandingSettings" << "statistics",
-                    filters);
-    connect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->cancel();
+        m_reply->deleteLater();
+    }
+    
+    m_reply = YouTubeRequestBroker::instance()->list("/channels", QStringList() << "snippet" << "contentDetails"
+                                                     << "brandingSettings" << "statistics", filters, QVariantMap(), this);
+    connect(m_reply, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
     emit statusChanged(status());
 }
 
@@ -217,37 +219,19 @@ void YouTubeUser::loadUser(YouTubeUser *user) {
 }
 
 void YouTubeUser::checkIfSubscribed() {
-    if (YouTube::subscriptionCache.ids.contains(id())) {
-        setSubscribed(true);
-        setSubscriptionId(YouTube::subscriptionCache.ids.value(id()));
-        return;
-    }
+    YouTubeSubscriptionIndex *index = YouTubeSubscriptionIndex::instance();
     
-    if (status() == QYouTube::ResourcesRequest::Loading) {
+    if ((index->isLoaded()) || (index->contains(id()))) {
+        setSubscribed(index->contains(id()));
+        setSubscriptionId(index->subscriptionId(id()));
         return;
     }
     
-    if ((YouTube::subscriptionCache.loaded) && (YouTube::subscriptionCache.nextPageToken.isEmpty())) {
-        setSubscribed(false);
-        setSubscriptionId(QString());
-        return;
-    }
-    
-    Logger::log("YouTubeUser::checkIfSubscribed(). ID: " + id(), Logger::MediumVerbosity);
-    initRequest();
-    QVariantMap filters;
-    filters["mine"] = true;
-    
-    QVariantMap params;
-    params["maxResults"] = 50;
-    
-    if (!YouTube::subscriptionCache.nextPageToken.isEmpty()) {
-        params["nextPageToken"] = YouTube::subscriptionCache.nextPageToken;
-    }
-    
-    m_request->list("/subscriptions", QStringList() << "snippet", filters, params);
-    connect(m_request, SIGNAL(finished()), this, SLOT(onSubscribeCheckRequestFinished()));
-    emit statusChanged(status());
+    // The account's subscriptions have not been indexed yet, so the result is set once they are
+    Logger::log("YouTubeUser::checkIfSubscribed(). Waiting for subscriptions. ID: " + id(),
+                Logger::MediumVerbosity);
+    connect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()), Qt::UniqueConnection);
+    index->sync();
 }
 
 void YouTubeUser::subscribe() {
@@ -283,6 +267,14 @@ void YouTubeUser::unsubscribe() {
 }
 
 void YouTubeUser::initRequest() {
+    // The request is used for the next operation, so the status of the last load is no longer relevant
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->cancel();
+        m_reply->deleteLater();
+        m_reply = 0;
+    }
+    
     if (!m_request) {
         m_request = new QYouTube::ResourcesRequest(this);
         m_request->setApiKey(YouTube::apiKey());
@@ -297,39 +289,14 @@ void YouTubeUser::initRequest() {
 }
 
 void YouTubeUser::onUserRequestFinished() {
-    if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantList list = m_request->result().toMap().value("items").toList();
+    if (m_reply->status() == QYouTube::ResourcesRequest::Ready) {
+        const QVariantList list = m_reply->result().toMap().value("items").toList();
         
         if (!list.isEmpty()) {
             loadUser(list.first().toMap());
         }
     }
     
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-    emit statusChanged(status());
-}
-
-void YouTubeUser::onSubscribeCheckRequestFinished() {
-    if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantMap result = m_request->result().toMap();
-        const QVariantList items = result.value("items").toList();
-        YouTube::subscriptionCache.nextPageToken = result.value("nextPageToken").toString();
-        YouTube::subscriptionCache.loaded = true;
-        
-        foreach (const QVariant &item, items) {
-            const QVariantMap map = item.toMap();
-            YouTube::subscriptionCache.ids.insert(map.value("snippet").toMap().value("resourceId").toMap()
-                                          .value("channelId").toString(), map.value("id").toString());
-        }
-        
-        disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
-        emit statusChanged(status());
-        checkIfSubscribed();
-        return;
-    }
-    
-    Logger::log("YouTubeUser::onSubscribeCheckRequestFinished(). Error: " + errorString());
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onUserRequestFinished()));
     emit statusChanged(status());
 }
 
@@ -338,7 +305,7 @@ void YouTubeUser::onSubscribeRequestFinished() {
         setSubscribed(true);
         setSubscriberCount(subscriberCount() + 1);
         setSubscriptionId(m_request->result().toMap().value("id").toString());
-        YouTube::subscriptionCache.ids.insert(id(), subscriptionId());
+        YouTubeSubscriptionIndex::instance()->insert(id(), subscriptionId());
         Logger::log("YouTubeUser::onSubscribeRequestFinished(). Subscription added. ID: " + id(),
                     Logger::MediumVerbosity);
         emit YouTube::instance()->userSubscribed(this);
@@ -356,7 +323,7 @@ void YouTubeUser::onUnsubscribeRequestFinished() {
         setSubscribed(false);
         setSubscriberCount(subscriberCount() - 1);
         setSubscriptionId(QString());
-        YouTube::subscriptionCache.ids.remove(id());
+        YouTubeSubscriptionIndex::instance()->remove(id());
         Logger::log("YouTubeUser::onUnsubscribeRequestFinished(). Subscription removed. ID: " + id(),
                     Logger::MediumVerbosity);
         emit YouTube::instance()->userUnsubscribed(this);
@@ -369,8 +336,13 @@ void YouTubeUser::onUnsubscribeRequestFinished() {
     emit statusChanged(status());
 }
 
-void YouTubeUser::onUserUpdated(YouTubeUser *user) {
-    if ((user->id() == id()) && (user != this)) {
-        loadUser(user);
+void YouTubeUser::onSubscriptionsSynced() {
+    YouTubeSubscriptionIndex *index = YouTubeSubscriptionIndex::instance();
+    disconnect(index, SIGNAL(synced()), this, SLOT(onSubscriptionsSynced()));
+    
+    // A failed sync leaves the subscription state as it is
+    if (index->isLoaded()) {
+        setSubscribed(index->contains(id()));
+        setSubscriptionId(index->subscriptionId(id()));
     }
 }
@@ -20,6 +20,8 @@
 #include "user.h"
 #include <qyoutube/resourcesrequest.h>
 
+class YouTubeReply;
+
 class YouTubeUser : public CTUser
 {
     Q_OBJECT
@@ -86,10 +88,9 @@ private:
         
 private Q_SLOTS:
     void onUserRequestFinished();
-    void onSubscribeCheckRequestFinished();
     void onSubscribeRequestFinished();
     void onUnsubscribeRequestFinished();
-    void onUserUpdated(YouTubeUser *user);
+    void onSubscriptionsSynced();
     
 Q_SIGNALS:
     void bannerUrlChanged();
@@ -103,6 +104,7 @@ Q_SIGNALS:
     
 private:
     QYouTube::ResourcesRequest *m_request;
+    YouTubeReply *m_reply;
     
     QUrl m_bannerUrl;
     QUrl m_largeBannerUrl;
@@ -17,11 +17,13 @@
 #include "youtubeusermodel.h"
 #include "logger.h"
 #include "youtube.h"
+#include "youtubeenrichment.h"
 
 YouTubeUserModel::YouTubeUserModel(QObject *parent) :
     QAbstractListModel(parent),
     m_request(new QYouTube::ResourcesRequest(this)),
-    m_contentRequest(0)
+    m_enrichment(new YouTubeEnrichment("/channels", QStringList() << "contentDetails" << "brandingSettings"
+                                       << "statistics", YouTube::getUserId, this))
 {
     m_roles[BannerUrlRole] = "bannerUrl";
     m_roles[DescriptionRole] = "description";
@@ -46,6 +48,7 @@ YouTubeUserModel::YouTubeUserModel(QObject *parent) :
     connect(m_request, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
     connect(m_request, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    connect(m_enrichment, SIGNAL(finished(QVariantList, QVariant)), this, SLOT(onEnrichmentFinished(QVariantList)));
 }
 
 QString YouTubeUserModel::errorString() const {
@@ -53,7 +56,7 @@ QString YouTubeUserModel::errorString() const {
 }
 
 QYouTube::ResourcesRequest::Status YouTubeUserModel::status() const {
-    if ((m_contentRequest) && (m_contentRequest->status() == QYouTube::ResourcesRequest::Loading)) {
+    if (m_enrichment->isLoading()) {
         return QYouTube::ResourcesRequest::Loading;
     }
     
@@ -71,7 +74,8 @@ int YouTubeUserModel::rowCount(const QModelIndex &) const {
 }
 
 bool YouTubeUserModel::canFetchMore(const QModelIndex &) const {
-    return (status() != QYouTube::ResourcesRequest::Loading) && (!m_nextPageToken.isEmpty());
+    // The next page can be listed while the details of the previous page are still loading
+    return (m_request->status() != QYouTube::ResourcesRequest::Loading) && (!m_nextPageToken.isEmpty());
 }
 
 void YouTubeUserModel::fetchMore(const QModelIndex &) {
@@ -164,6 +168,8 @@ void YouTubeUserModel::list(const QString &resourcePath, const QStringList &part
 }
 
 void YouTubeUserModel::clear() {
+    m_enrichment->clear();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
         qDeleteAll(m_items);
@@ -189,32 +195,17 @@ void YouTubeUserModel::reload() {
     emit statusChanged(status());
 }
 
-void YouTubeUserModel::getAdditionalContent() {
-    if (!m_contentRequest) {
-        m_contentRequest = new QYouTube::ResourcesRequest(this);
-        m_contentRequest->setApiKey(YouTube::apiKey());
-        m_contentRequest->setClientId(YouTube::clientId());
-        m_contentRequest->setClientSecret(YouTube::clientSecret());
-        m_contentRequest->setAccessToken(YouTube::accessToken());
-        m_contentRequest->setRefreshToken(YouTube::refreshToken());
-
-        connect(m_contentRequest, SIGNAL(accessTokenChanged(QString)),
-                YouTube::instance(), SLOT(setAccessToken(QString)));
-        connect(m_contentRequest, SIGNAL(refreshTokenChanged(QString)),
-                YouTube::instance(), SLOT(setRefreshToken(QString)));
-        connect(m_contentRequest, SIGNAL(finished()), this, SLOT(onContentRequestFinished()));
-    }
-    
-    QStringList ids;
-    
-    for (int i = 0; i < m_results.size(); i++) {
-        ids << m_results.at(i).first;
+void YouTubeUserModel::addUsers(const QVariantList &users) {
+    if (!users.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + users.size() - 1);
+        
+        foreach (const QVariant &user, users) {
+            m_items << new YouTubeUser(user.toMap(), this);
+        }
+        
+        endInsertRows();
+        emit countChanged(rowCount());
     }
-    
-    QVariantMap filters;
-    filters["id"] = ids.join(",");
-    
-    m_contentRequest->list("/channels", QStringList() << "contentDetails" << "brandingSettings" << "statistics", filters);
 }
 
 void YouTubeUserModel::append(YouTubeUser *user) {
@@ -254,25 +245,13 @@ void YouTubeUserModel::onRequestFinished() {
                 if ((result.value("kind") == "youtube#searchListResponse")
                     || (result.value("kind") == "youtube#subscriptionListResponse")) {
                     
-                    foreach (const QVariant &v, list) {
-                        const QVariantMap item = v.toMap();
-                        m_results << QPair<QString, QVariantMap>(YouTube::getUserId(item), item);
-                    }
-                    
-                    getAdditionalContent();
+                    m_enrichment->enrich(list);
                 }
                 else {
-                    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                    
-                    foreach (const QVariant &item, list) {
-                        m_items << new YouTubeUser(item.toMap(), this);
-                    }
-                    
-                    endInsertRows();
-                    emit countChanged(rowCount());
-                    emit statusChanged(status());
+                    m_enrichment->append(list);
                 }
-
+                
+                emit statusChanged(status());
                 return;
             }
         }
@@ -284,40 +263,8 @@ void YouTubeUserModel::onRequestFinished() {
     emit statusChanged(status());
 }
 
-void YouTubeUserModel::onContentRequestFinished() {
-    if (m_contentRequest->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantMap result = m_contentRequest->result().toMap();
-        
-        if (!result.isEmpty()) {
-            const QVariantList list = result.value("items").toList();
-
-            if (!list.isEmpty()) {
-                beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                
-                foreach (const QVariant &v, list) {
-                    const QVariantMap item = v.toMap();
-                    
-                    for (int i = 0; i < m_results.size(); i++) {
-                        if (m_results.at(i).first == YouTube::getUserId(item)) {
-                            QVariantMap user = m_results.takeAt(i).second;
-                            user["brandingSettings"] = item.value("brandingSettings");
-                            user["contentDetails"] = item.value("contentDetails");
-                            user["statistics"] = item.value("statistics");
-                            m_items << new YouTubeUser(user, this);
-                            break;
-                        }
-                    }
-                }
-
-                endInsertRows();
-                emit countChanged(rowCount());
-            }
-        }
-    }
-    else {
-        Logger::log("YouTubeUserModel::onContentRequestFinished(). Error: " + errorString());
-    }
-
+void YouTubeUserModel::onEnrichmentFinished(const QVariantList &users) {
+    addUsers(users);
     emit statusChanged(status());
 }
 
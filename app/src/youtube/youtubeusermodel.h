@@ -21,6 +21,8 @@
 #include <QAbstractListModel>
 #include <QStringList>
 
+class YouTubeEnrichment;
+
 class YouTubeUserModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -77,7 +79,7 @@ public Q_SLOTS:
     void reload();
     
 private:
-    void getAdditionalContent();
+    void addUsers(const QVariantList &users);
     
     void append(YouTubeUser *user);
     void insert(int row, YouTubeUser *user);
@@ -85,7 +87,7 @@ private:
     
 private Q_SLOTS:
     void onRequestFinished();
-    void onContentRequestFinished();
+    void onEnrichmentFinished(const QVariantList &users);
     
     void onUserSubscribed(YouTubeUser *user);
     void onUserUnsubscribed(YouTubeUser *user);
@@ -96,7 +98,7 @@ Q_SIGNALS:
     
 private:
     QYouTube::ResourcesRequest *m_request;
-    QYouTube::ResourcesRequest *m_contentRequest;
+    YouTubeEnrichment *m_enrichment;
     
     QString m_resourcePath;
     QStringList m_part;
@@ -104,8 +106,6 @@ private:
     QVariantMap m_params;
     QString m_nextPageToken;
     
-    QList< QPair<QString, QVariantMap> > m_results;
-    
     QList<YouTubeUser*> m_items;
     
     QHash<int, QByteArray> m_roles;
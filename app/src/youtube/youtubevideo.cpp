@@ -18,11 +18,94 @@
 #include "logger.h"
 #include "resources.h"
 #include "youtube.h"
+#include "youtuberequestbroker.h"
 #include <QDateTime>
 
+YouTubeVideoData::YouTubeVideoData() :
+    CTVideoData(),
+    disliked(false),
+    dislikeCount(0),
+    favourite(false),
+    favouriteCount(0),
+    liked(false),
+    likeCount(0),
+    playlistItem(false)
+{
+    service = Resources::YOUTUBE;
+    subtitles = true;
+}
+
+YouTubeVideoData::YouTubeVideoData(const QVariantMap &video) :
+    CTVideoData(),
+    disliked(false),
+    dislikeCount(0),
+    favourite(false),
+    favouriteCount(0),
+    liked(false),
+    likeCount(0),
+    playlistItem(false)
+{
+    const QVariantMap snippet = video.value("snippet").toMap();
+    const QVariantMap contentDetails = video.value("contentDetails").toMap();
+    const QVariantMap statistics = video.value("statistics").toMap();
+    const QVariantMap thumbnails = snippet.value("thumbnails").toMap();
+    
+    service = Resources::YOUTUBE;
+    subtitles = true;
+    date = QDateTime::fromString(snippet.value("publishedAt").toString(), Qt::ISODate).toString("dd MMM yyyy");
+    description = snippet.value("description").toString();
+    dislikeCount = statistics.value("dislikeCount").toLongLong();
+    duration = YouTube::formatDuration(contentDetails.value("duration").toString());
+    favouriteCount = statistics.value("favoriteCount").toLongLong();
+    largeThumbnailUrl = thumbnails.value("high").toMap().value("url").toString();
+    likeCount = statistics.value("likeCount").toLongLong();
+    userId = snippet.value("channelId").toString();
+    username = snippet.value("channelTitle").toString();
+    thumbnailUrl = thumbnails.value("default").toMap().value("url").toString();
+    title = snippet.value("title").toString();
+    viewCount = statistics.value("viewCount").toLongLong();
+    
+    if (video.value("kind") == "youtube#searchResult") {
+        id = video.value("id").toMap().value("videoId").toString();
+    }
+    else if (video.value("kind") == "youtube#playlistItem") {
+        id = snippet.value("resourceId").toMap().value("videoId").toString();
+        playlistItem = true;
+        
+        if (snippet.value("playlistId") == YouTube::relatedPlaylist("favorites")) {
+            favourite = true;
+            favouriteId = video.value("id").toString();
+        }
+        else {
+            playlistItemId = video.value("id").toString();
+            liked = (snippet.value("playlistId") == YouTube::relatedPlaylist("likes"));
+        }
+    }
+    else {
+        id = video.value("id").toString();
+    }
+    
+    url = "https://www.youtube.com/watch?v=" + id;
+}
+
+YouTubeVideoData::YouTubeVideoData(const YouTubeVideo *video) :
+    CTVideoData(video),
+    disliked(video->isDisliked()),
+    dislikeCount(video->dislikeCount()),
+    favourite(video->isFavourite()),
+    favouriteCount(video->favouriteCount()),
+    favouriteId(video->favouriteId()),
+    liked(video->isLiked()),
+    likeCount(video->likeCount()),
+    playlistItemId(video->playlistItemId()),
+    playlistItem(false)
+{
+}
+
 YouTubeVideo::YouTubeVideo(QObject *parent) :
     CTVideo(parent),
     m_request(0),
+    m_reply(0),
     m_disliked(false),
     m_dislikeCount(0),
     m_favourite(false),
@@ -32,19 +115,12 @@ YouTubeVideo::YouTubeVideo(QObject *parent) :
 {
     setHasSubtitles(true);
     setService(Resources::YOUTUBE);
-    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
 }
 
 YouTubeVideo::YouTubeVideo(const QString &id, QObject *parent) :
     CTVideo(parent),
     m_request(0),
+    m_reply(0),
     m_disliked(false),
     m_dislikeCount(0),
     m_favourite(false),
@@ -55,19 +131,12 @@ YouTubeVideo::YouTubeVideo(const QString &id, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::YOUTUBE);
     loadVideo(id);
-    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
 }
 
 YouTubeVideo::YouTubeVideo(const QVariantMap &video, QObject *parent) :
     CTVideo(parent),
     m_request(0),
+    m_reply(0),
     m_disliked(false),
     m_dislikeCount(0),
     m_favourite(false),
@@ -78,19 +147,12 @@ YouTubeVideo::YouTubeVideo(const QVariantMap &video, QObject *parent) :
     setHasSubtitles(true);
     setService(Resources::YOUTUBE);
     loadVideo(video);
-    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
 }
 
 YouTubeVideo::YouTubeVideo(const YouTubeVideo *video, QObject *parent) :
     CTVideo(video, parent),
     m_request(0),
+    m_reply(0),
     m_disliked(video->isDisliked()),
     m_dislikeCount(video->dislikeCount()),
     m_favourite(video->isFavourite()),
@@ -100,14 +162,21 @@ YouTubeVideo::YouTubeVideo(const YouTubeVideo *video, QObject *parent) :
     m_likeCount(video->likeCount()),
     m_playlistItemId(video->playlistItemId())
 {
-    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
-    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)),
-            this, SLOT(onVideoUpdated(YouTubeVideo*)));
+}
+
+YouTubeVideo::YouTubeVideo(const YouTubeVideoData &video, QObject *parent) :
+    CTVideo(video, parent),
+    m_request(0),
+    m_reply(0),
+    m_disliked(video.disliked),
+    m_dislikeCount(video.dislikeCount),
+    m_favourite(video.favourite),
+    m_favouriteCount(video.favouriteCount),
+    m_favouriteId(video.favouriteId),
+    m_liked(video.liked),
+    m_likeCount(video.likeCount),
+    m_playlistItemId(video.playlistItemId)
+{
 }
 
 bool YouTubeVideo::isDisliked() const {
@@ -133,6 +202,10 @@ void YouTubeVideo::setDislikeCount(qint64 c) {
 }
 
 QString YouTubeVideo::errorString() const {
+    if (m_reply) {
+        return m_reply->errorString();
+    }
+    
     return m_request ? YouTube::getErrorString(m_request->result().toMap()) : QString();
 }
 
@@ -203,6 +276,10 @@ void YouTubeVideo::setPlaylistItemId(const QString &i) {
 }
 
 QYouTube::ResourcesRequest::Status YouTubeVideo::status() const {
+    if (m_reply) {
+        return m_reply->status();
+    }
+    
     return m_request ? m_request->status() : QYouTube::ResourcesRequest::Null;
 }
 
@@ -211,58 +288,42 @@ void YouTubeVideo::loadVideo(const QString &id) {
         return;
     }
     
-    initRequest();
-    
     QVariantMap filters;
     filters["id"] = id;
     
-    m_request->list("/videos", QStringList() << "snippet" << "contentDetails" << "statistics", filters);
-    connect(m_request, SIGNAL(finished()), this, SLOT(onVideoRequestFinished()));
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->cancel();
+        m_reply->deleteLater();
+    }
+    
+    m_reply = YouTubeRequestBroker::instance()->list("/videos", QStringList() << "snippet" << "contentDetails"
+                                                     << "statistics", filters, QVariantMap(), this);
+    connect(m_reply, SIGNAL(finished()), this, SLOT(onVideoRequestFinished()));
     emit statusChanged(status());
 }
 
 void YouTubeVideo::loadVideo(const QVariantMap &video) {
-    const QVariantMap snippet = video.value("snippet").toMap();
-    const QVariantMap contentDetails = video.value("contentDetails").toMap();
-    const QVariantMap statistics = video.value("statistics").toMap();
-    const QVariantMap thumbnails = snippet.value("thumbnails").toMap();
-    
-    setDate(QDateTime::fromString(snippet.value("publishedAt").toString(), Qt::ISODate).toString("dd MMM yyyy"));
-    setDescription(snippet.value("description").toString());
-    setDislikeCount(statistics.value("dislikeCount").toLongLong());
-    setDuration(YouTube::formatDuration(contentDetails.value("duration").toString()));
-    setFavouriteCount(statistics.value("favoriteCount").toLongLong());
-    setLargeThumbnailUrl(thumbnails.value("high").toMap().value("url").toString());
-    setLikeCount(statistics.value("likeCount").toLongLong());
-    setUserId(snippet.value("channelId").toString());
-    setUsername(snippet.value("channelTitle").toString());
-    setThumbnailUrl(thumbnails.value("default").toMap().value("url").toString());
-    setTitle(snippet.value("title").toString());
-    setViewCount(statistics.value("viewCount").toLongLong());
+    const YouTubeVideoData data(video);
+    CTVideo::loadData(data);
+    setDislikeCount(data.dislikeCount);
+    setFavouriteCount(data.favouriteCount);
+    setLikeCount(data.likeCount);
     
-    if (video.value("kind") == "youtube#searchResult") {
-        setId(video.value("id").toMap().value("videoId").toString());
-    }
-    else if (video.value("kind") == "youtube#playlistItem") {
-        setId(snippet.value("resourceId").toMap().value("videoId").toString());
-        
-        if (snippet.value("playlistId") == YouTube::relatedPlaylist("favorites")) {
+    // Only a playlistItem carries the user's favourite/like state, so keep the current state otherwise
+    if (data.playlistItem) {
+        if (data.favourite) {
             setFavourite(true);
-            setFavouriteId(video.value("id").toString());
+            setFavouriteId(data.favouriteId);
         }
         else {
-            setPlaylistItemId(video.value("id").toString());
+            setPlaylistItemId(data.playlistItemId);
             
-            if (snippet.value("playlistId") == YouTube::relatedPlaylist("likes")) {
+            if (data.liked) {
                 setLiked(true);
             }
         }
     }
-    else {
-        setId(video.value("id").toString());
-    }
-    
-    setUrl("https://www.youtube.com/watch?v=" + id());
 }
 
 void YouTubeVideo::loadVideo(YouTubeVideo *video) {
@@ -343,6 +404,14 @@ void YouTubeVideo::like() {
 }
 
 void YouTubeVideo::initRequest() {
+    // The request is used for the next operation, so the status of the last load is no longer relevant
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->cancel();
+        m_reply->deleteLater();
+        m_reply = 0;
+    }
+    
     if (!m_request) {
         m_request = new QYouTube::ResourcesRequest(this);
         m_request->setApiKey(YouTube::apiKey());
@@ -357,15 +426,14 @@ void YouTubeVideo::initRequest() {
 }
 
 void YouTubeVideo::onVideoRequestFinished() {
-    if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantList list = m_request->result().toMap().value("items").toList();
+    if (m_reply->status() == QYouTube::ResourcesRequest::Ready) {
+        const QVariantList list = m_reply->result().toMap().value("items").toList();
         
         if (!list.isEmpty()) {
             loadVideo(list.first().toMap());
         }
     }
     
-    disconnect(m_request, SIGNAL(finished()), this, SLOT(onVideoRequestFinished()));
     emit statusChanged(status());
 }
 
@@ -434,9 +502,3 @@ void YouTubeVideo::onDislikeRequestFinished() {
     disconnect(m_request, SIGNAL(finished()), this, SLOT(onDislikeRequestFinished()));
     emit statusChanged(status());
 }
-
-void YouTubeVideo::onVideoUpdated(YouTubeVideo *video) {
-    if ((video->id() == id()) && (video != this)) {
-        loadVideo(video);
-    }
-}
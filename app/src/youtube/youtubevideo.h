@@ -20,6 +20,27 @@
 #include "video.h"
 #include <qyoutube/resourcesrequest.h>
 
+class YouTubeReply;
+class YouTubeVideo;
+
+class YouTubeVideoData : public CTVideoData
+{
+public:
+    YouTubeVideoData();
+    explicit YouTubeVideoData(const QVariantMap &video);
+    explicit YouTubeVideoData(const YouTubeVideo *video);
+    
+    bool disliked;
+    qint64 dislikeCount;
+    bool favourite;
+    qint64 favouriteCount;
+    QString favouriteId;
+    bool liked;
+    qint64 likeCount;
+    QString playlistItemId;
+    bool playlistItem;
+};
+
 class YouTubeVideo : public CTVideo
 {
     Q_OBJECT
@@ -40,6 +61,7 @@ public:
     explicit YouTubeVideo(const QString &id, QObject *parent = 0);
     explicit YouTubeVideo(const QVariantMap &video, QObject *parent = 0);
     explicit YouTubeVideo(const YouTubeVideo *video, QObject *parent = 0);
+    explicit YouTubeVideo(const YouTubeVideoData &video, QObject *parent = 0);
     
     bool isDisliked() const;
     qint64 dislikeCount() const;
@@ -89,7 +111,6 @@ private Q_SLOTS:
     void onUnfavouriteRequestFinished();
     void onLikeRequestFinished();
     void onDislikeRequestFinished();
-    void onVideoUpdated(YouTubeVideo *video);
     
 Q_SIGNALS:
     void dislikedChanged();
@@ -104,6 +125,7 @@ Q_SIGNALS:
 
 private:
     QYouTube::ResourcesRequest *m_request;
+    YouTubeReply *m_reply;
     
     bool m_disliked;
     qint64 m_dislikeCount;
@@ -16,13 +16,22 @@
 
 #include "youtubevideomodel.h"
 #include "logger.h"
+#include "resources.h"
+#include "responsecache.h"
 #include "youtube.h"
+#include "youtubeenrichment.h"
 #include "youtubeplaylist.h"
 
 YouTubeVideoModel::YouTubeVideoModel(QObject *parent) :
     QAbstractListModel(parent),
     m_request(new QYouTube::ResourcesRequest(this)),
-    m_contentRequest(0)
+    m_enrichment(new YouTubeEnrichment("/videos", QStringList() << "contentDetails" << "statistics",
+                                       YouTube::getVideoId, this)),
+    m_cached(false),
+    m_revalidating(false),
+    m_prefetchRequest(new QYouTube::ResourcesRequest(this)),
+    m_prefetchEnrichment(new YouTubeEnrichment("/videos", QStringList() << "contentDetails" << "statistics",
+                                               YouTube::getVideoId, this))
 {
     m_roles[DateRole] = "date";
     m_roles[DescriptionRole] = "description";
@@ -58,18 +67,42 @@ YouTubeVideoModel::YouTubeVideoModel(QObject *parent) :
     connect(m_request, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
     connect(m_request, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
     connect(m_request, SIGNAL(finished()), this, SLOT(onRequestFinished()));
+    connect(m_enrichment, SIGNAL(finished(QVariantList, QVariant)),
+            this, SLOT(onEnrichmentFinished(QVariantList, QVariant)));
+    
+    m_prefetchRequest->setApiKey(YouTube::apiKey());
+    m_prefetchRequest->setClientId(YouTube::clientId());
+    m_prefetchRequest->setClientSecret(YouTube::clientSecret());
+    m_prefetchRequest->setAccessToken(YouTube::accessToken());
+    m_prefetchRequest->setRefreshToken(YouTube::refreshToken());
+    
+    connect(m_prefetchRequest, SIGNAL(accessTokenChanged(QString)), YouTube::instance(), SLOT(setAccessToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(refreshTokenChanged(QString)), YouTube::instance(), SLOT(setRefreshToken(QString)));
+    connect(m_prefetchRequest, SIGNAL(finished()), this, SLOT(onPrefetchRequestFinished()));
+    connect(m_prefetchEnrichment, SIGNAL(finished(QVariantList, QVariant)),
+            this, SLOT(onPrefetchEnrichmentFinished(QVariantList, QVariant)));
 }
 
 QString YouTubeVideoModel::errorString() const {
     return YouTube::getErrorString(m_request->result().toMap());
 }
 
+int YouTubeVideoModel::prefetchThreshold() const {
+    return m_prefetcher.threshold();
+}
+
+void YouTubeVideoModel::setPrefetchThreshold(int threshold) {
+    if (m_prefetcher.setThreshold(threshold)) {
+        emit prefetchThresholdChanged();
+    }
+}
+
 QYouTube::ResourcesRequest::Status YouTubeVideoModel::status() const {
-    if ((m_contentRequest) && (m_contentRequest->status() == QYouTube::ResourcesRequest::Loading)) {
+    if ((m_enrichment->isLoading()) || (m_prefetcher.isWanted())) {
         return QYouTube::ResourcesRequest::Loading;
     }
     
-    return m_request->status();
+    return m_cached ? QYouTube::ResourcesRequest::Ready : m_request->status();
 }
 
 #if QT_VERSION >=0x050000
@@ -83,7 +116,9 @@ int YouTubeVideoModel::rowCount(const QModelIndex &) const {
 }
 
 bool YouTubeVideoModel::canFetchMore(const QModelIndex &) const {
-    return (status() != QYouTube::ResourcesRequest::Loading) && (!m_nextPageToken.isEmpty());
+    // The next page can be listed while the details of the previous page are still loading
+    return (m_request->status() != QYouTube::ResourcesRequest::Loading) && (!m_prefetcher.isWanted())
+        && (!m_nextPageToken.isEmpty());
 }
 
 void YouTubeVideoModel::fetchMore(const QModelIndex &) {
@@ -91,16 +126,90 @@ void YouTubeVideoModel::fetchMore(const QModelIndex &) {
         return;
     }
     
+    if (m_prefetcher.hasResult()) {
+        addPrefetchResult();
+        return;
+    }
+    
+    if ((m_prefetchRequest->status() == QYouTube::ResourcesRequest::Loading) || (m_prefetchEnrichment->isLoading())) {
+        // The next page is already being prefetched, so add it as soon as it is ready
+        m_prefetcher.setWanted(true);
+        emit statusChanged(status());
+        return;
+    }
+    
     QVariantMap params = m_params;
     params["pageToken"] = m_nextPageToken;
+    m_cacheKey = ResponseCache::key(Resources::YOUTUBE, m_resourcePath,
+                                    QVariantList() << m_part << m_filters << params);
+    const QVariantMap result = ResponseCache::result(m_cacheKey).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos(params);
+    }
+    else {
+        m_cached = true;
+        m_nextPageToken = result.value("nextPageToken").toString();
+        m_enrichment->append(result.value("items").toList());
+    }
     
-    m_request->list(m_resourcePath, m_part, m_filters, params);
     emit statusChanged(status());
 }
 
+QVariant YouTubeVideoModel::roleData(const YouTubeVideoData *video, int role) {
+    switch (role) {
+    case DateRole:
+        return video->date;
+    case DescriptionRole:
+        return video->description;
+    case DislikedRole:
+        return video->disliked;
+    case DislikeCountRole:
+        return video->dislikeCount;
+    case DownloadableRole:
+        return video->downloadable;
+    case DurationRole:
+        return video->duration;
+    case FavouriteRole:
+        return video->favourite;
+    case FavouriteCountRole:
+        return video->favouriteCount;
+    case FavouriteIdRole:
+        return video->favouriteId;
+    case IdRole:
+        return video->id;
+    case LargeThumbnailUrlRole:
+        return video->largeThumbnailUrl;
+    case LikedRole:
+        return video->liked;
+    case LikeCountRole:
+        return video->likeCount;
+    case PlaylistItemIdRole:
+        return video->playlistItemId;
+    case StreamUrlRole:
+        return video->streamUrl;
+    case SubtitlesRole:
+        return video->subtitles;
+    case ThumbnailUrlRole:
+        return video->thumbnailUrl;
+    case TitleRole:
+        return video->title;
+    case UrlRole:
+        return video->url;
+    case UserIdRole:
+        return video->userId;
+    case UsernameRole:
+        return video->username;
+    case ViewCountRole:
+        return video->viewCount;
+    default:
+        return QVariant();
+    }
+}
+
 QVariant YouTubeVideoModel::data(const QModelIndex &index, int role) const {
-    if (const YouTubeVideo *video = get(index.row())) {
-        return video->property(m_roles[role]);
+    if (const YouTubeVideoData *video = videoData(index.row())) {
+        return roleData(video, role);
     }
     
     return QVariant();
@@ -109,12 +218,12 @@ QVariant YouTubeVideoModel::data(const QModelIndex &index, int role) const {
 QMap<int, QVariant> YouTubeVideoModel::itemData(const QModelIndex &index) const {
     QMap<int, QVariant> map;
     
-    if (const YouTubeVideo *video = get(index.row())) {
+    if (const YouTubeVideoData *video = videoData(index.row())) {
         QHashIterator<int, QByteArray> iterator(m_roles);
         
         while (iterator.hasNext()) {
             iterator.next();
-            map[iterator.key()] = video->property(iterator.value());
+            map[iterator.key()] = roleData(video, iterator.key());
         }
     }
     
@@ -122,8 +231,8 @@ QMap<int, QVariant> YouTubeVideoModel::itemData(const QModelIndex &index) const
 }
 
 QVariant YouTubeVideoModel::data(int row, const QByteArray &role) const {
-    if (const YouTubeVideo *video = get(row)) {
-        return video->property(role);
+    if (const YouTubeVideoData *video = videoData(row)) {
+        return roleData(video, m_roles.key(role));
     }
     
     return QVariant();
@@ -132,9 +241,12 @@ QVariant YouTubeVideoModel::data(int row, const QByteArray &role) const {
 QVariantMap YouTubeVideoModel::itemData(int row) const {
     QVariantMap map;
     
-    if (const YouTubeVideo *video = get(row)) {
-        foreach (const QByteArray &role, m_roles.values()) {
-            map[role] = video->property(role);
+    if (const YouTubeVideoData *video = videoData(row)) {
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            map[iterator.value()] = roleData(video, iterator.key());
         }
     }
     
@@ -143,7 +255,22 @@ QVariantMap YouTubeVideoModel::itemData(int row) const {
 
 YouTubeVideo* YouTubeVideoModel::get(int row) const {
     if ((row >= 0) && (row < m_items.size())) {
-        return m_items.at(row);
+        // Rows are stored as values, so the QObject is only created when a page or QML asks for it
+        if (!m_videos.at(row)) {
+            m_videos[row] = new YouTubeVideo(*m_items.at(row), const_cast<YouTubeVideoModel*>(this));
+            // Keep the row in step with any change to the object, such as a reload of its details
+            m_videos.at(row)->connectChangeSignals(const_cast<YouTubeVideoModel*>(this), SLOT(onVideoChanged()));
+        }
+        
+        return m_videos.at(row);
+    }
+    
+    return 0;
+}
+
+const YouTubeVideoData* YouTubeVideoModel::videoData(int row) const {
+    if ((row >= 0) && (row < m_items.size())) {
+        return m_items.at(row).constData();
     }
     
     return 0;
@@ -161,10 +288,34 @@ void YouTubeVideoModel::list(const QString &resourcePath, const QStringList &par
     m_part = part;
     m_filters = filters;
     m_params = params;
-    m_request->list(resourcePath, part, filters, params);
+    m_cacheKey = ResponseCache::key(Resources::YOUTUBE, resourcePath, QVariantList() << part << filters << params);
+    bool stale = false;
+    const QVariantMap result = ResponseCache::result(m_cacheKey, &stale).toMap();
+    
+    if (result.isEmpty()) {
+        getVideos(params);
+    }
+    else {
+        // Show the cached videos immediately, and replace them if they need to be revalidated
+        m_nextPageToken = result.value("nextPageToken").toString();
+        addVideos(result.value("items").toList());
+        
+        if (stale) {
+            m_revalidating = true;
+            getVideos(params);
+        }
+        else {
+            m_cached = true;
+        }
+    }
+    
     emit statusChanged(status());
     
     disconnect(YouTube::instance(), 0, this, 0);
+    connect(YouTube::instance(), SIGNAL(videoDisliked(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoLiked(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoFavourited(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
+    connect(YouTube::instance(), SIGNAL(videoUnfavourited(YouTubeVideo*)), this, SLOT(onVideoUpdated(YouTubeVideo*)));
         
     if (resourcePath.endsWith("playlistItems")) {
         if (filters.value("playlistId") == YouTube::relatedPlaylist("favorites")) {
@@ -183,10 +334,16 @@ void YouTubeVideoModel::list(const QString &resourcePath, const QStringList &par
 }
 
 void YouTubeVideoModel::clear() {
+    m_enrichment->clear();
+    m_prefetcher.clear();
+    m_prefetchRequest->cancel();
+    m_prefetchEnrichment->clear();
+    
     if (!m_items.isEmpty()) {
         beginResetModel();
-        qDeleteAll(m_items);
+        qDeleteAll(m_videos);
         m_items.clear();
+        m_videos.clear();
         m_nextPageToken = QString();
         endResetModel();
         emit countChanged(rowCount());
@@ -195,6 +352,13 @@ void YouTubeVideoModel::clear() {
 
 void YouTubeVideoModel::cancel() {
     m_request->cancel();
+    
+    if (m_prefetcher.isWanted()) {
+        m_prefetcher.clear();
+        m_prefetchRequest->cancel();
+        m_prefetchEnrichment->clear();
+        emit statusChanged(status());
+    }
 }
 
 void YouTubeVideoModel::reload() {
@@ -204,48 +368,43 @@ void YouTubeVideoModel::reload() {
     
     Logger::log("YouTubeVideoModel::reload(). Resource path: " + m_resourcePath, Logger::HighVerbosity);
     clear();
-    m_request->list(m_resourcePath, m_part, m_filters, m_params);
+    m_cacheKey = ResponseCache::key(Resources::YOUTUBE, m_resourcePath,
+                                    QVariantList() << m_part << m_filters << m_params);
+    getVideos(m_params);
     emit statusChanged(status());
 }
 
-void YouTubeVideoModel::getAdditionalContent() {
-    if (!m_contentRequest) {
-        m_contentRequest = new QYouTube::ResourcesRequest(this);
-        m_contentRequest->setApiKey(YouTube::apiKey());
-        m_contentRequest->setClientId(YouTube::clientId());
-        m_contentRequest->setClientSecret(YouTube::clientSecret());
-        m_contentRequest->setAccessToken(YouTube::accessToken());
-        m_contentRequest->setRefreshToken(YouTube::refreshToken());
+void YouTubeVideoModel::getVideos(const QVariantMap &params) {
+    m_cached = false;
+    m_request->list(m_resourcePath, m_part, m_filters, params);
+}
 
-        connect(m_contentRequest, SIGNAL(accessTokenChanged(QString)),
-                YouTube::instance(), SLOT(setAccessToken(QString)));
-        connect(m_contentRequest, SIGNAL(refreshTokenChanged(QString)),
-                YouTube::instance(), SLOT(setRefreshToken(QString)));
-        connect(m_contentRequest, SIGNAL(finished()), this, SLOT(onContentRequestFinished()));
-    }
-    
-    QStringList ids;
-    
-    for (int i = 0; i < m_results.size(); i++) {
-        ids << m_results.at(i).first;
+void YouTubeVideoModel::addVideos(const QVariantList &videos) {
+    if (!videos.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + videos.size() - 1);
+        
+        foreach (const QVariant &video, videos) {
+            m_items << QSharedDataPointer<YouTubeVideoData>(new YouTubeVideoData(video.toMap()));
+            m_videos << 0;
+        }
+        
+        endInsertRows();
+        emit countChanged(rowCount());
     }
-    
-    QVariantMap filters;
-    filters["id"] = ids.join(",");
-    
-    m_contentRequest->list("/videos", QStringList() << "contentDetails" << "statistics", filters);
 }
 
-void YouTubeVideoModel::append(YouTubeVideo *video) {
+void YouTubeVideoModel::append(YouTubeVideoData *video) {
     beginInsertRows(QModelIndex(), m_items.size(), m_items.size());
-    m_items << video;
+    m_items << QSharedDataPointer<YouTubeVideoData>(video);
+    m_videos << 0;
     endInsertRows();
 }
 
-void YouTubeVideoModel::insert(int row, YouTubeVideo *video) {
+void YouTubeVideoModel::insert(int row, YouTubeVideoData *video) {
     if ((row >= 0) && (row < m_items.size())) {
         beginInsertRows(QModelIndex(), row, row);
-        m_items.insert(row, video);
+        m_items.insert(row, QSharedDataPointer<YouTubeVideoData>(video));
+        m_videos.insert(row, 0);
         endInsertRows();
     }
     else {
@@ -256,40 +415,79 @@ void YouTubeVideoModel::insert(int row, YouTubeVideo *video) {
 void YouTubeVideoModel::remove(int row) {
     if ((row >= 0) && (row < m_items.size())) {
         beginRemoveRows(QModelIndex(), row, row);
-        m_items.takeAt(row)->deleteLater();
+        m_items.removeAt(row);
+        
+        if (YouTubeVideo *video = m_videos.takeAt(row)) {
+            video->deleteLater();
+        }
+        
         endRemoveRows();
     }
 }
 
+void YouTubeVideoModel::setVisibleRange(int, int last) {
+    // Load the next page in the background when the view approaches the last row
+    if ((m_nextPageToken.isEmpty()) || (m_request->status() == QYouTube::ResourcesRequest::Loading)
+        || (!m_prefetcher.start(last, rowCount(), m_nextPageToken))) {
+        return;
+    }
+    
+    QVariantMap params = m_params;
+    params["pageToken"] = m_nextPageToken;
+    m_prefetchCacheKey = ResponseCache::key(Resources::YOUTUBE, m_resourcePath,
+                                            QVariantList() << m_part << m_filters << params);
+    
+    // A cached page does not need to be prefetched, since fetchMore() will use the cached response
+    if (ResponseCache::result(m_prefetchCacheKey).toMap().isEmpty()) {
+        Logger::log("YouTubeVideoModel::setVisibleRange(). Prefetching page token: " + m_nextPageToken,
+                    Logger::HighVerbosity);
+        m_prefetchRequest->list(m_resourcePath, m_part, m_filters, params);
+    }
+}
+
+void YouTubeVideoModel::setPrefetchResult(const QVariantMap &result) {
+    if (m_prefetcher.setResult(result)) {
+        addPrefetchResult();
+    }
+}
+
+void YouTubeVideoModel::addPrefetchResult() {
+    // The prefetched page is held until it is needed, and is then added in the same way as a cached page
+    const QVariantMap result = m_prefetcher.takeResult();
+    m_cached = true;
+    m_cacheKey = m_prefetchCacheKey;
+    m_nextPageToken = result.value("nextPageToken").toString();
+    m_enrichment->append(result.value("items").toList());
+    emit statusChanged(status());
+}
+
 void YouTubeVideoModel::onRequestFinished() {
     if (m_request->status() == QYouTube::ResourcesRequest::Ready) {
         const QVariantMap result = m_request->result().toMap();
         
         if (!result.isEmpty()) {
+            if (m_revalidating) {
+                m_revalidating = false;
+                clear();
+            }
+            
             m_nextPageToken = result.value("nextPageToken").toString();
             const QVariantList list = result.value("items").toList();
 
             if (!list.isEmpty()) {
                 if (result.value("kind") != "youtube#videoListResponse") {
-                    foreach (const QVariant &v, list) {
-                        const QVariantMap item = v.toMap();
-                        m_results << QPair<QString, QVariantMap>(YouTube::getVideoId(item), item);
-                    }
-                    
-                    getAdditionalContent();
+                    QVariantMap page;
+                    page["cacheKey"] = m_cacheKey;
+                    page["nextPageToken"] = m_nextPageToken;
+                    m_enrichment->enrich(list, page);
                 }
                 else {
-                    beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                    
-                    foreach (const QVariant &item, list) {
-                        m_items << new YouTubeVideo(item.toMap(), this);
-                    }
-                    
-                    endInsertRows();
-                    emit countChanged(rowCount());
-                    emit statusChanged(status());
+                    ResponseCache::insert(m_cacheKey, Resources::YOUTUBE, ResponseCache::resourceType(m_resourcePath),
+                                          result);
+                    m_enrichment->append(list);
                 }
-
+                
+                emit statusChanged(status());
                 return;
             }
         }
@@ -297,49 +495,31 @@ void YouTubeVideoModel::onRequestFinished() {
     else {
         Logger::log("YouTubeVideoModel::onRequestFinished(). Error: " + errorString());
     }
-
+    
+    m_revalidating = false;
     emit statusChanged(status());
 }
 
-void YouTubeVideoModel::onContentRequestFinished() {
-    if (m_contentRequest->status() == QYouTube::ResourcesRequest::Ready) {
-        const QVariantMap result = m_contentRequest->result().toMap();
-        
-        if (!result.isEmpty()) {
-            const QVariantList list = result.value("items").toList();
-
-            if (!list.isEmpty()) {
-                beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + list.size() - 1);
-                
-                foreach (const QVariant &v, list) {
-                    const QVariantMap item = v.toMap();
-                    
-                    for (int i = 0; i < m_results.size(); i++) {
-                        if (m_results.at(i).first == YouTube::getUserId(item)) {
-                            QVariantMap video = m_results.takeAt(i).second;
-                            video["contentDetails"] = item.value("contentDetails");
-                            video["statistics"] = item.value("statistics");
-                            m_items << new YouTubeVideo(video, this);
-                            break;
-                        }
-                    }
-                }
-
-                endInsertRows();
-                emit countChanged(rowCount());
-            }
-        }
-    }
-    else {
-        Logger::log("YouTubeVideoModel::onContentRequestFinished(). Error: " + errorString());
+void YouTubeVideoModel::onEnrichmentFinished(const QVariantList &videos, const QVariant &tag) {
+    const QVariantMap page = tag.toMap();
+    
+    if (!page.isEmpty()) {
+        // Cache the merged videos, so that a cached page does not need the additional content request
+        QVariantMap videoList;
+        videoList["kind"] = "youtube#videoListResponse";
+        videoList["nextPageToken"] = page.value("nextPageToken");
+        videoList["items"] = videos;
+        ResponseCache::insert(page.value("cacheKey").toString(), Resources::YOUTUBE,
+                              ResponseCache::resourceType(m_resourcePath), videoList);
     }
-
+    
+    addVideos(videos);
     emit statusChanged(status());
 }
 
 void YouTubeVideoModel::onVideoAddedToPlaylist(YouTubeVideo *video, YouTubePlaylist *playlist) {
     if (m_filters.value("playlistId") == playlist->id()) {
-        insert(0, new YouTubeVideo(video, this));
+        insert(0, new YouTubeVideoData(video));
     }
 }
 
@@ -354,7 +534,7 @@ void YouTubeVideoModel::onVideoRemovedFromPlaylist(YouTubeVideo *video, YouTubeP
 }
 
 void YouTubeVideoModel::onVideoFavourited(YouTubeVideo *video) {
-    insert(0, new YouTubeVideo(video, this));
+    insert(0, new YouTubeVideoData(video));
 }
 
 void YouTubeVideoModel::onVideoUnfavourited(YouTubeVideo *video) {
@@ -364,3 +544,66 @@ void YouTubeVideoModel::onVideoUnfavourited(YouTubeVideo *video) {
         remove(list.first().row());
     }
 }
+
+void YouTubeVideoModel::onVideoUpdated(YouTubeVideo *video) {
+    for (int i = 0; i < m_items.size(); i++) {
+        if (m_items.at(i)->id == video->id()) {
+            m_items[i] = QSharedDataPointer<YouTubeVideoData>(new YouTubeVideoData(video));
+            const QModelIndex idx = index(i);
+            emit dataChanged(idx, idx);
+        }
+    }
+}
+
+void YouTubeVideoModel::onVideoChanged() {
+    const int i = m_videos.indexOf(qobject_cast<YouTubeVideo*>(sender()));
+    
+    if (i >= 0) {
+        m_items[i] = QSharedDataPointer<YouTubeVideoData>(new YouTubeVideoData(m_videos.at(i)));
+        const QModelIndex idx = index(i);
+        emit dataChanged(idx, idx);
+    }
+}
+
+void YouTubeVideoModel::onPrefetchRequestFinished() {
+    if (m_prefetchRequest->status() == QYouTube::ResourcesRequest::Ready) {
+        const QVariantMap result = m_prefetchRequest->result().toMap();
+        const QVariantList list = result.value("items").toList();
+        
+        if ((!list.isEmpty()) && (result.value("kind") != "youtube#videoListResponse")) {
+            QVariantMap page;
+            page["cacheKey"] = m_prefetchCacheKey;
+            page["nextPageToken"] = result.value("nextPageToken");
+            m_prefetchEnrichment->enrich(list, page);
+            return;
+        }
+        
+        if (!result.isEmpty()) {
+            ResponseCache::insert(m_prefetchCacheKey, Resources::YOUTUBE, ResponseCache::resourceType(m_resourcePath),
+                                  result);
+            setPrefetchResult(result);
+            return;
+        }
+    }
+    else {
+        Logger::log("YouTubeVideoModel::onPrefetchRequestFinished(). Error: "
+                    + YouTube::getErrorString(m_prefetchRequest->result().toMap()));
+    }
+    
+    if (m_prefetcher.isWanted()) {
+        // Fall back to requesting the page directly, so that any error is reported
+        m_prefetcher.setWanted(false);
+        fetchMore();
+    }
+}
+
+void YouTubeVideoModel::onPrefetchEnrichmentFinished(const QVariantList &videos, const QVariant &tag) {
+    const QVariantMap page = tag.toMap();
+    QVariantMap videoList;
+    videoList["kind"] = "youtube#videoListResponse";
+    videoList["nextPageToken"] = page.value("nextPageToken");
+    videoList["items"] = videos;
+    ResponseCache::insert(page.value("cacheKey").toString(), Resources::YOUTUBE,
+                          ResponseCache::resourceType(m_resourcePath), videoList);
+    setPrefetchResult(videoList);
+}
@@ -17,10 +17,12 @@
 #ifndef YOUTUBEVIDEOMODEL_H
 #define YOUTUBEVIDEOMODEL_H
 
+#include "pageprefetcher.h"
 #include "youtubevideo.h"
 #include <QAbstractListModel>
 #include <QStringList>
 
+class YouTubeEnrichment;
 class YouTubePlaylist;
 
 class YouTubeVideoModel : public QAbstractListModel
@@ -30,6 +32,8 @@ class YouTubeVideoModel : public QAbstractListModel
     Q_PROPERTY(bool canFetchMore READ canFetchMore NOTIFY statusChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged)
+    Q_PROPERTY(int prefetchThreshold READ prefetchThreshold WRITE setPrefetchThreshold
+               NOTIFY prefetchThresholdChanged)
     Q_PROPERTY(QYouTube::ResourcesRequest::Status status READ status NOTIFY statusChanged)
     
 public:
@@ -60,9 +64,12 @@ public:
     
     explicit YouTubeVideoModel(QObject *parent = 0);
     
-    QString errorString() const;
+    virtual QString errorString() const;
     
-    QYouTube::ResourcesRequest::Status status() const;
+    int prefetchThreshold() const;
+    void setPrefetchThreshold(int threshold);
+    
+    virtual QYouTube::ResourcesRequest::Status status() const;
     
 #if QT_VERSION >= 0x050000
     QHash<int, QByteArray> roleNames() const;
@@ -84,32 +91,51 @@ public:
                           const QVariantMap &filters = QVariantMap(), const QVariantMap &params = QVariantMap());
 
 public Q_SLOTS:
-    void clear();
-    void cancel();
-    void reload();
+    virtual void clear();
+    virtual void cancel();
+    virtual void reload();
+    
+    void setVisibleRange(int first, int last);
+
+protected:
+    void insert(int row, YouTubeVideoData *video);
+    void remove(int row);
+
+protected Q_SLOTS:
+    void onVideoUpdated(YouTubeVideo *video);
     
 private:
-    void getAdditionalContent();
+    static QVariant roleData(const YouTubeVideoData *video, int role);
     
-    void append(YouTubeVideo *video);
-    void insert(int row, YouTubeVideo *video);
-    void remove(int row);
+    const YouTubeVideoData* videoData(int row) const;
+    
+    void getVideos(const QVariantMap &params);
+    void addVideos(const QVariantList &videos);
+    
+    void append(YouTubeVideoData *video);
+    
+    void setPrefetchResult(const QVariantMap &result);
+    void addPrefetchResult();
     
 private Q_SLOTS:
     void onRequestFinished();
-    void onContentRequestFinished();
+    void onEnrichmentFinished(const QVariantList &videos, const QVariant &tag);
+    void onPrefetchRequestFinished();
+    void onPrefetchEnrichmentFinished(const QVariantList &videos, const QVariant &tag);
     void onVideoAddedToPlaylist(YouTubeVideo *video, YouTubePlaylist *playlist);
     void onVideoRemovedFromPlaylist(YouTubeVideo *video, YouTubePlaylist *playlist);
     void onVideoFavourited(YouTubeVideo *video);
     void onVideoUnfavourited(YouTubeVideo *video);
+    void onVideoChanged();
     
 Q_SIGNALS:
     void countChanged(int count);
+    void prefetchThresholdChanged();
     void statusChanged(QYouTube::ResourcesRequest::Status s);
     
 private:
     QYouTube::ResourcesRequest *m_request;
-    QYouTube::ResourcesRequest *m_contentRequest;
+    YouTubeEnrichment *m_enrichment;
     
     QString m_resourcePath;
     QStringList m_part;
@@ -117,9 +143,17 @@ private:
     QVariantMap m_params;
     QString m_nextPageToken;
     
-    QList< QPair<QString, QVariantMap> > m_results;
+    QString m_cacheKey;
+    bool m_cached;
+    bool m_revalidating;
+    
+    QYouTube::ResourcesRequest *m_prefetchRequest;
+    YouTubeEnrichment *m_prefetchEnrichment;
+    QString m_prefetchCacheKey;
+    PagePrefetcher m_prefetcher;
     
-    QList<YouTubeVideo*> m_items;
+    QList< QSharedDataPointer<YouTubeVideoData> > m_items;
+    mutable QList<YouTubeVideo*> m_videos;
     
     QHash<int, QByteArray> m_roles;
 };
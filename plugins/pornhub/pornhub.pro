@@ -20,6 +20,7 @@ symbian {
 
     INCLUDEPATH += ../src
     HEADERS += \
+        ../src/htmlextractor.h \
         ../src/resourcesrequest.h \
         ../src/serviceplugin.h
     
@@ -45,6 +46,7 @@ symbian {
 } else:contains(MEEGO_EDITION,harmattan) {
     INCLUDEPATH += ../src
     HEADERS += \
+        ../src/htmlextractor.h \
         ../src/resourcesrequest.h \
         ../src/serviceplugin.h
     
@@ -64,6 +66,7 @@ symbian {
 } else:unix {
     INCLUDEPATH += /usr/include/cutetube2
     HEADERS += \
+        /usr/include/cutetube2/htmlextractor.h \
         /usr/include/cutetube2/resourcesrequest.h \
         /usr/include/cutetube2/serviceplugin.h
     
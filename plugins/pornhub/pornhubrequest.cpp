@@ -32,6 +32,22 @@ const QList<QNetworkCookie> PornhubRequest::MOBILE_COOKIES = QList<QNetworkCooki
 const QList<QNetworkCookie> PornhubRequest::TABLET_COOKIES = QList<QNetworkCookie>()
                                                              << QNetworkCookie("platform", "tablet");
 
+const HtmlExtractor PornhubRequest::VIDEO_EXTRACTOR = HtmlExtractor()
+    .addField("duration", "div class=\"duration thumbOverlay removeWhenPlaying details\">", "<")
+    .addField("largeThumbnailUrl", "img class=\"mainImage\" src=\"", "\"")
+    .addField("thumbnailUrl", "og:image\" content=\"", "\"")
+    .addField("title", "div class=\"headerWrap sectionPadding clearfix", "<h1>")
+    .addField("userId", QList<QByteArray>() << "div class=\"categoryRow parent clearfix" << "href=\"", "\"")
+    .addField("username", QList<QByteArray>() << "div class=\"categoryRow parent clearfix" << "href=\"" << ">", "<");
+
+const HtmlExtractor PornhubRequest::VIDEOS_EXTRACTOR = HtmlExtractor("<li class=\"videoblock")
+    .addField("duration", "class=\"length\">", "<", HtmlExtractor::Record)
+    .addField("id", "href=\"", "\"", HtmlExtractor::Record)
+    .addField("largeThumbnailUrl", "data-mediumthumb=\"", "\"", HtmlExtractor::Record)
+    .addField("thumbnailUrl", "data-smallthumb=\"", "\"", HtmlExtractor::Record)
+    .addField("title", "title=\"", "\"", HtmlExtractor::Record)
+    .addField("viewCount", "class=\"views\">", " ", HtmlExtractor::Record);
+
 const int PornhubRequest::MAX_REDIRECTS = 8;
 
 PornhubRequest::PornhubRequest(QObject *parent) :
@@ -146,8 +162,7 @@ bool PornhubRequest::search(const QString &resourceType, const QString &query, c
 void PornhubRequest::getVideo(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkVideo()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -184,29 +199,22 @@ void PornhubRequest::checkVideo() {
         return;
     }
     
-    const QString result = QString::fromUtf8(reply->readAll());
-    const QString duration = result.section("div class=\"duration thumbOverlay removeWhenPlaying details\">", 1, 1)
-                                   .section("<", 0, 0);
+    const HtmlExtractor::Fields result = VIDEO_EXTRACTOR.extract(reply->readAll());
     const QString id = reply->url().toString();
-    const QString largeThumbnailUrl = result.section("img class=\"mainImage\" src=\"", 1, 1).section("\"", 0, 0);
-    const QString thumbnailUrl = result.section("og:image\" content=\"", 1, 1).section("\"", 0, 0);
-    const QString title = result.section("div class=\"headerWrap sectionPadding clearfix", 1, 1).section("<h1>", 0, 0);
-    const QString user = result.section("div class=\"categoryRow parent clearfix", 1, 1);
+    const QString user = result.value("userId");
     
     QVariantMap video;
-    video["duration"] = duration;
+    video["duration"] = result.value("duration");
     video["id"] = id;
-    video["largeThumbnailUrl"] = largeThumbnailUrl;
+    video["largeThumbnailUrl"] = result.value("largeThumbnailUrl");
     video["relatedVideosId"] = id;
-    video["thumbnailUrl"] = thumbnailUrl;
-    video["title"] = title;
+    video["thumbnailUrl"] = result.value("thumbnailUrl");
+    video["title"] = result.value("title");
     video["url"] = id;
     
     if (!user.isEmpty()) {
-        const QString userId = BASE_URL + user.section("href=\"", 1, 1).section("\"", 0, 0);
-        const QString username = result.section(">", 1, 1).section("<", 0, 0);
-        video["userId"] = userId;
-        video["username"] = username;
+        video["userId"] = BASE_URL + user;
+        video["username"] = result.value("username");
     }
     
     setResult(video);
@@ -217,8 +225,7 @@ void PornhubRequest::checkVideo() {
 void PornhubRequest::listVideos(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(TABLET_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, TABLET_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkVideos()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -265,29 +272,23 @@ void PornhubRequest::checkVideos() {
         return;
     }
     
-    const QString result = QString::fromUtf8(reply->readAll());
-    const QStringList videos = result.split("<li class=\"videoblock");
+    QList<HtmlExtractor::Fields> videos;
+    VIDEOS_EXTRACTOR.extract(reply->readAll(), &videos);
     QVariantMap response;
     QVariantList items;
     
-    for (int i = 1; i < videos.size(); i++) {
-        const QString &video = videos.at(i);
-        const QString duration = video.section("class=\"length\">", 1, 1).section("<", 0, 0);
-        const QString id = BASE_URL + video.section("href=\"", 1, 1).section("\"", 0, 0);
-        const QString largeThumbnailUrl = video.section("data-mediumthumb=\"", 1, 1).section("\"", 0, 0);
-        const QString thumbnailUrl = video.section("data-smallthumb=\"", 1, 1).section("\"", 0, 0);
-        const QString title = video.section("title=\"", 1, 1).section("\"", 0, 0);
-        const int viewCount = qMax(0, video.section("class=\"views\">", 1, 1).section(" ", 0, 0).remove(",").toInt());
+    foreach (const HtmlExtractor::Fields &video, videos) {
+        const QString id = BASE_URL + video.value("id");
         
         QVariantMap item;
-        item["duration"] = duration;
+        item["duration"] = video.value("duration");
         item["id"] = id;
-        item["largeThumbnailUrl"] = largeThumbnailUrl;
+        item["largeThumbnailUrl"] = video.value("largeThumbnailUrl");
         item["relatedVideosId"] = id;
-        item["thumbnailUrl"] = thumbnailUrl;
-        item["title"] = title;
+        item["thumbnailUrl"] = video.value("thumbnailUrl");
+        item["title"] = video.value("title");
         item["url"] = id;
-        item["viewCount"] = viewCount;
+        item["viewCount"] = qMax(0, video.value("viewCount").remove(",").toInt());
         items << item;
     }
     
@@ -317,8 +318,7 @@ void PornhubRequest::getUser(const QString &url) {
 void PornhubRequest::getChannel(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkChannel()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -378,8 +378,7 @@ void PornhubRequest::checkChannel() {
 void PornhubRequest::getMember(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkMember()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -439,8 +438,7 @@ void PornhubRequest::checkMember() {
 void PornhubRequest::getPornstar(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkPornstar()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -535,8 +533,7 @@ void PornhubRequest::searchUsers(const QString &query, const QString &order) {
 void PornhubRequest::listChannels(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(TABLET_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, TABLET_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkChannels()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -607,8 +604,7 @@ void PornhubRequest::checkChannels() {
 void PornhubRequest::listMembers(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(TABLET_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, TABLET_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkMembers()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -679,8 +675,7 @@ void PornhubRequest::checkMembers() {
 void PornhubRequest::listPornstars(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(TABLET_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, TABLET_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkPornstars()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -751,8 +746,7 @@ void PornhubRequest::checkPornstars() {
 void PornhubRequest::listCategories(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkCategories()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -814,8 +808,7 @@ void PornhubRequest::checkCategories() {
 void PornhubRequest::listStreams(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(MOBILE_COOKIES, BASE_URL);
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, MOBILE_COOKIES);
     connect(reply, SIGNAL(finished()), this, SLOT(checkStreams()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
@@ -908,11 +901,34 @@ QUrl PornhubRequest::incrementPageNumber(QUrl url) {
 
 void PornhubRequest::followRedirect(const QString &url, const char *slot) {
     m_redirects++;
-    QNetworkReply *reply = networkAccessManager()->get(QNetworkRequest(url));
+    QNetworkReply *reply = getPage(url, m_cookies);
     connect(reply, SIGNAL(finished()), this, slot);
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
 
+QNetworkReply* PornhubRequest::getPage(const QUrl &url, const QList<QNetworkCookie> &platformCookies) {
+    // The platform cookies are sent with this request only, since the cookie jar is shared with other plugins.
+    // Setting the header means that the jar is not used, so its other cookies for the URL are added here
+    m_cookies = platformCookies;
+    QList<QNetworkCookie> cookies = platformCookies;
+    
+    if (QNetworkCookieJar *jar = networkAccessManager()->cookieJar()) {
+        foreach (const QNetworkCookie &cookie, jar->cookiesForUrl(url)) {
+            if (cookie.name() != "platform") {
+                cookies << cookie;
+            }
+        }
+    }
+    
+    QNetworkRequest request(url);
+    request.setHeader(QNetworkRequest::CookieHeader, QVariant::fromValue(cookies));
+    return networkAccessManager()->get(request);
+}
+
 QNetworkAccessManager* PornhubRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void PornhubRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
@@ -17,6 +17,7 @@
 #ifndef PORNHUBREQUEST_H
 #define PORNHUBREQUEST_H
 
+#include "htmlextractor.h"
 #include "resourcesrequest.h"
 #include <QNetworkCookie>
 
@@ -36,6 +37,8 @@ public:
 
     virtual ResourcesRequest::Status status() const;
     
+    void setNetworkAccessManager(QNetworkAccessManager *manager);
+    
 public Q_SLOTS:
     virtual bool cancel();
     virtual bool get(const QString &resourceType, const QString &resourceId);
@@ -90,6 +93,8 @@ private:
     
     void followRedirect(const QString &url, const char *slot);
     
+    QNetworkReply* getPage(const QUrl &url, const QList<QNetworkCookie> &platformCookies);
+    
     QNetworkAccessManager* networkAccessManager();
 
     static const QString BASE_URL;
@@ -97,9 +102,14 @@ private:
     static const QList<QNetworkCookie> MOBILE_COOKIES;
     static const QList<QNetworkCookie> TABLET_COOKIES;
     
+    static const HtmlExtractor VIDEO_EXTRACTOR;
+    static const HtmlExtractor VIDEOS_EXTRACTOR;
+    
     static const int MAX_REDIRECTS;    
     
     QNetworkAccessManager *m_nam;
+    
+    QList<QNetworkCookie> m_cookies;
 
     QString m_errorString;
 
@@ -448,3 +448,7 @@ void PornTrexRequest::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* PornTrexRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void PornTrexRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
@@ -356,3 +356,7 @@ void TVRequest::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* TVRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void TVRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
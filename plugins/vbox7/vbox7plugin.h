@@ -19,6 +19,8 @@
 
 #include "serviceplugin.h"
 #include "vbox7request.h"
+#include <QNetworkAccessManager>
+#include <QPointer>
 #if QT_VERSION < 0x050000
 #include <QtPlugin>
 #endif
@@ -32,7 +34,16 @@ class Vbox7Plugin : public QObject, public ServicePlugin
 #endif
 
 public:
-    virtual ResourcesRequest* createRequest(QObject *parent = 0) { return new Vbox7Request(parent); }
+    virtual ResourcesRequest* createRequest(QObject *parent = 0) {
+        Vbox7Request *request = new Vbox7Request(parent);
+        request->setNetworkAccessManager(m_nam);
+        return request;
+    }
+    
+    virtual void setNetworkAccessManager(QNetworkAccessManager *manager) { m_nam = manager; }
+
+private:
+    QPointer<QNetworkAccessManager> m_nam;
 };
 
 #if QT_VERSION < 0x050000
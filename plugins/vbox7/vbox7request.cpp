@@ -612,3 +612,7 @@ void Vbox7Request::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* Vbox7Request::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void Vbox7Request::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
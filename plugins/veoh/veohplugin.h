@@ -19,6 +19,8 @@
 
 #include "serviceplugin.h"
 #include "veohrequest.h"
+#include <QNetworkAccessManager>
+#include <QPointer>
 #if QT_VERSION < 0x050000
 #include <QtPlugin>
 #endif
@@ -32,7 +34,16 @@ class VeohPlugin : public QObject, public ServicePlugin
 #endif
 
 public:
-    virtual ResourcesRequest* createRequest(QObject *parent = 0) { return new VeohRequest(parent); }
+    virtual ResourcesRequest* createRequest(QObject *parent = 0) {
+        VeohRequest *request = new VeohRequest(parent);
+        request->setNetworkAccessManager(m_nam);
+        return request;
+    }
+    
+    virtual void setNetworkAccessManager(QNetworkAccessManager *manager) { m_nam = manager; }
+
+private:
+    QPointer<QNetworkAccessManager> m_nam;
 };
 
 #if QT_VERSION < 0x050000
@@ -430,3 +430,7 @@ void VeohRequest::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* VeohRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void VeohRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
@@ -938,3 +938,7 @@ void VideoclipRequest::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* VideoclipRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void VideoclipRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
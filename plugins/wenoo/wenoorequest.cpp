@@ -689,3 +689,7 @@ void WenooRequest::followRedirect(const QString &url, const char *slot) {
 QNetworkAccessManager* WenooRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void WenooRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
@@ -35,6 +35,8 @@ public:
 
     virtual ResourcesRequest::Status status() const;
     
+    void setNetworkAccessManager(QNetworkAccessManager *manager);
+    
 public Q_SLOTS:
     virtual bool cancel();
     virtual bool get(const QString &resourceType, const QString &resourceId);
@@ -199,19 +199,16 @@ void XHamsterRequest::checkVideo() {
 void XHamsterRequest::listVideos(const QString &url) {
     setStatus(Loading);
     m_redirects = 0;
-    QNetworkRequest request(url);
-    request.setRawHeader("User-Agent", USER_AGENT);
-    QNetworkReply *reply = networkAccessManager()->get(request);
+    QNetworkReply *reply = getPage(url);
     connect(reply, SIGNAL(finished()), this, SLOT(checkVideos()));
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
 
 void XHamsterRequest::searchVideos(const QString &query, const QString &order) {
-    const QNetworkCookie cookie("search_video",
-    QString("{\"sort\":\"%1\",\"duration\":\"\",\"channels\":false,\"quality\":0,\"date\":\"\"}")
-           .arg(order).toUtf8());
-    networkAccessManager()->cookieJar()->setCookiesFromUrl(QList<QNetworkCookie>() << cookie, BASE_URL);
-    listVideos(QString("%1/search.php?qcat=video&q=%2").arg(BASE_URL).arg(query));
+    // The order is kept in the fragment, which is not sent to the server, so that later pages use it too
+    QUrl url(QString("%1/search.php?qcat=video&q=%2").arg(BASE_URL).arg(query));
+    url.setFragment(order);
+    listVideos(url.toString());
 }
 
 void XHamsterRequest::checkVideos() {
@@ -228,7 +225,13 @@ void XHamsterRequest::checkVideos() {
     
     if (!redirect.isEmpty()) {
         if (m_redirects < MAX_REDIRECTS) {
-            followRedirect(redirect, SLOT(checkVideos()));
+            QUrl url(redirect);
+            
+            if (url.fragment().isEmpty()) {
+                url.setFragment(reply->url().fragment());
+            }
+            
+            followRedirect(url.toString(), SLOT(checkVideos()));
         }
         else {
             setErrorString(tr("Maximum redirects reached"));
@@ -464,13 +467,40 @@ QUrl XHamsterRequest::incrementPageNumber(QUrl url) {
 
 void XHamsterRequest::followRedirect(const QString &url, const char *slot) {
     m_redirects++;
-    QNetworkRequest request(url);
-    request.setRawHeader("User-Agent", USER_AGENT);
-    QNetworkReply *reply = networkAccessManager()->get(request);
+    QNetworkReply *reply = getPage(url);
     connect(reply, SIGNAL(finished()), this, slot);
     connect(this, SIGNAL(finished()), reply, SLOT(deleteLater()));
 }
 
+QNetworkReply* XHamsterRequest::getPage(const QUrl &url) {
+    QNetworkRequest request(url);
+    request.setRawHeader("User-Agent", USER_AGENT);
+    
+    // The search order is sent with this request only, instead of being stored in the shared cookie jar
+    if (!url.fragment().isEmpty()) {
+        QList<QNetworkCookie> cookies;
+        
+        if (QNetworkCookieJar *jar = networkAccessManager()->cookieJar()) {
+            foreach (const QNetworkCookie &cookie, jar->cookiesForUrl(url)) {
+                if (cookie.name() != "search_video") {
+                    cookies << cookie;
+                }
+            }
+        }
+        
+        cookies << QNetworkCookie("search_video",
+        QString("{\"sort\":\"%1\",\"duration\":\"\",\"channels\":false,\"quality\":0,\"date\":\"\"}")
+               .arg(url.fragment()).toUtf8());
+        request.setHeader(QNetworkRequest::CookieHeader, QVariant::fromValue(cookies));
+    }
+    
+    return networkAccessManager()->get(request);
+}
+
 QNetworkAccessManager* XHamsterRequest::networkAccessManager() {
     return m_nam ? m_nam : m_nam = new QNetworkAccessManager(this);
 }
+
+void XHamsterRequest::setNetworkAccessManager(QNetworkAccessManager *manager) {
+    m_nam = manager;
+}
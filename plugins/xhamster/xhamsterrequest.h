@@ -36,6 +36,8 @@ public:
 
     virtual ResourcesRequest::Status status() const;
     
+    void setNetworkAccessManager(QNetworkAccessManager *manager);
+    
 public Q_SLOTS:
     virtual bool cancel();
     virtual bool get(const QString &resourceType, const QString &resourceId);
@@ -71,6 +73,8 @@ private:
     
     void followRedirect(const QString &url, const char *slot);
     
+    QNetworkReply* getPage(const QUrl &url);
+    
     QNetworkAccessManager* networkAccessManager();
 
     static const QString BASE_URL;
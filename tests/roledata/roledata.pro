@@ -0,0 +1,15 @@
+QT += core testlib
+QT -= gui
+CONFIG += testcase
+TARGET = tst_roledata
+TEMPLATE = app
+
+INCLUDEPATH += ../../app/src/base
+
+HEADERS += \
+    ../../app/src/base/objectregistry.h \
+    ../../app/src/base/video.h
+
+SOURCES += \
+    ../../app/src/base/video.cpp \
+    tst_roledata.cpp
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016 Stuart Howarth <showarth@marxoft.co.uk>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "video.h"
+#include <QHash>
+#include <QtTest/QtTest>
+
+// Compares the two ways the list models resolve a role: the old QObject::property() lookup by role name, and
+// the switch over the shared item data used by the models' roleData() helpers.
+
+enum Roles {
+    DateRole = Qt::UserRole + 1,
+    DescriptionRole,
+    DownloadableRole,
+    DurationRole,
+    IdRole,
+    LargeThumbnailUrlRole,
+    ServiceRole,
+    StreamUrlRole,
+    SubtitlesRole,
+    ThumbnailUrlRole,
+    TitleRole,
+    UrlRole,
+    UserIdRole,
+    UsernameRole,
+    ViewCountRole
+};
+
+static QVariant roleData(const CTVideoData *video, int role) {
+    switch (role) {
+    case DateRole:
+        return video->date;
+    case DescriptionRole:
+        return video->description;
+    case DownloadableRole:
+        return video->downloadable;
+    case DurationRole:
+        return video->duration;
+    case IdRole:
+        return video->id;
+    case LargeThumbnailUrlRole:
+        return video->largeThumbnailUrl;
+    case ServiceRole:
+        return video->service;
+    case StreamUrlRole:
+        return video->streamUrl;
+    case SubtitlesRole:
+        return video->subtitles;
+    case ThumbnailUrlRole:
+        return video->thumbnailUrl;
+    case TitleRole:
+        return video->title;
+    case UrlRole:
+        return video->url;
+    case UserIdRole:
+        return video->userId;
+    case UsernameRole:
+        return video->username;
+    case ViewCountRole:
+        return video->viewCount;
+    default:
+        return QVariant();
+    }
+}
+
+class TestVideo : public CTVideo
+{
+public:
+    explicit TestVideo(QObject *parent = 0) :
+        CTVideo(parent)
+    {
+        setDate("1 January 2016");
+        setDescription("Description");
+        setDownloadable(true);
+        setDuration("04:20");
+        setId("abcdef");
+        setLargeThumbnailUrl(QUrl("http://example.com/large.jpg"));
+        setService("youtube");
+        setStreamUrl(QUrl("http://example.com/stream.mp4"));
+        setHasSubtitles(false);
+        setThumbnailUrl(QUrl("http://example.com/thumb.jpg"));
+        setTitle("Title");
+        setUrl(QUrl("http://example.com/watch?v=abcdef"));
+        setUserId("user");
+        setUsername("Username");
+        setViewCount(1000);
+    }
+};
+
+class TestRoleData : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase() {
+        m_roles[DateRole] = "date";
+        m_roles[DescriptionRole] = "description";
+        m_roles[DownloadableRole] = "downloadable";
+        m_roles[DurationRole] = "duration";
+        m_roles[IdRole] = "id";
+        m_roles[LargeThumbnailUrlRole] = "largeThumbnailUrl";
+        m_roles[ServiceRole] = "service";
+        m_roles[StreamUrlRole] = "streamUrl";
+        m_roles[SubtitlesRole] = "subtitles";
+        m_roles[ThumbnailUrlRole] = "thumbnailUrl";
+        m_roles[TitleRole] = "title";
+        m_roles[UrlRole] = "url";
+        m_roles[UserIdRole] = "userId";
+        m_roles[UsernameRole] = "username";
+        m_roles[ViewCountRole] = "viewCount";
+    }
+    
+    void sameValues() {
+        TestVideo video;
+        const CTVideoData data(&video);
+        QHashIterator<int, QByteArray> iterator(m_roles);
+        
+        while (iterator.hasNext()) {
+            iterator.next();
+            QCOMPARE(roleData(&data, iterator.key()), video.property(iterator.value()));
+        }
+    }
+    
+    void propertyLookup() {
+        TestVideo video;
+        QVariant value;
+        
+        QBENCHMARK {
+            for (int role = DateRole; role <= ViewCountRole; role++) {
+                value = video.property(m_roles.value(role));
+            }
+        }
+    }
+    
+    void switchLookup() {
+        TestVideo video;
+        const CTVideoData data(&video);
+        QVariant value;
+        
+        QBENCHMARK {
+            for (int role = DateRole; role <= ViewCountRole; role++) {
+                value = roleData(&data, role);
+            }
+        }
+    }
+
+private:
+    QHash<int, QByteArray> m_roles;
+};
+
+QTEST_MAIN(TestRoleData)
+#include "tst_roledata.moc"